@@ -11,45 +11,100 @@
 // every divergent branch the set of phi nodes that the branch will make
 // divergent.
 //
+// The algorithm only needs the CFG, the post-dominator tree and the loop info,
+// so it is written once for any kind of block (BranchDependenceAnalysisBase)
+// and used by the IR and the machine IR divergence analyses.
+//
+// Cycles with more than one entry block are not loops for LoopInfo. They are
+// found by a recursive decomposition of the CFG into strongly connected
+// components, and treated as loops with multiple headers: a divergent branch
+// in such a cycle, or that enters it from different paths, makes all of its
+// blocks and exits join blocks, and the threads may leave it in different
+// iterations.
+//
 //===----------------------------------------------------------------------===//
 
 #ifndef LLVM_ANALYSIS_BRANCHDEPENDENCEANALYSIS_H
 #define LLVM_ANALYSIS_BRANCHDEPENDENCEANALYSIS_H
 
-#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Analysis/LoopInfo.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/Support/GenericDomTree.h"
+#include <map>
+#include <memory>
+#include <vector>
 
 namespace llvm {
 
-class BasicBlock;
-class TerminatorInst;
 class DominatorTree;
 class PostDominatorTree;
-class TerminatorInst;
 
-using ConstBlockSet = SmallPtrSet<const BasicBlock *, 4>;
+template <typename BlockT, typename LoopT> class BranchDependenceAnalysisBase {
+public:
+  using ConstBlockSet = SmallPtrSet<const BlockT *, 4>;
+  using PostDomTreeT = DominatorTreeBase<BlockT, true>;
 
-class BranchDependenceAnalysis {
-  static ConstBlockSet emptyBlockSet;
+  /// A cycle of the CFG entered through more than one block. Irreducible
+  /// cycles nested in it are separate IrreducibleCycles.
+  struct IrreducibleCycle {
+    SmallPtrSet<const BlockT *, 8> blocks;
+    SmallVector<const BlockT *, 2> entries;
+  };
+  using CycleVector = SmallVector<const IrreducibleCycle *, 2>;
 
-  const DominatorTree &domTree;
-  const PostDominatorTree &postDomTree;
-  const LoopInfo &loopInfo;
+  BranchDependenceAnalysisBase(const PostDomTreeT &postDomTree,
+                               const LoopInfoBase<BlockT, LoopT> &loopInfo)
+      : postDomTree(postDomTree), loopInfo(loopInfo) {}
 
-  std::map<const TerminatorInst *, ConstBlockSet *> cachedJoinBlocks;
+  /// \brief returns the set of blocks whose PHI nodes become divergent if the
+  /// branch at the end of @branchBlock is divergent
+  const ConstBlockSet &join_blocks(const BlockT &branchBlock);
 
-public:
-  bool inRegion(const BasicBlock &BB) const;
+  /// \brief returns the irreducible cycles that the threads may leave in
+  /// different iterations if the branch at the end of @branchBlock is
+  /// divergent
+  const CycleVector &divergent_cycles(const BlockT &branchBlock);
+
+private:
+  void computeIrreducibleCycles(const BlockT &anyBlock);
+  void findIrreducibleCycles(ArrayRef<const BlockT *> region,
+                             const BlockT *entryBlock);
+
+  const PostDomTreeT &postDomTree;
+  const LoopInfoBase<BlockT, LoopT> &loopInfo;
+
+  ConstBlockSet emptyBlockSet;
+  CycleVector emptyCycleVector;
+  std::map<const BlockT *, std::unique_ptr<ConstBlockSet>> cachedJoinBlocks;
+  std::map<const BlockT *, CycleVector> cachedDivergentCycles;
 
-  ~BranchDependenceAnalysis();
+  bool computedIrreducibleCycles = false;
+  std::vector<std::unique_ptr<IrreducibleCycle>> irreducibleCycles;
+};
+
+extern template class BranchDependenceAnalysisBase<BasicBlock, Loop>;
+
+using ConstBlockSet = BranchDependenceAnalysisBase<BasicBlock,
+                                                   Loop>::ConstBlockSet;
+
+class BranchDependenceAnalysis
+    : public BranchDependenceAnalysisBase<BasicBlock, Loop> {
+public:
   BranchDependenceAnalysis(const DominatorTree &domTree,
                            const PostDominatorTree &postDomTree,
                            const LoopInfo &loopInfo);
 
+  using BranchDependenceAnalysisBase::join_blocks;
+
   /// \brief returns the set of blocks whose PHI nodes become divergent if
-  /// @branch is divergent
-  const ConstBlockSet &join_blocks(const TerminatorInst &term);
+  /// @term is divergent
+  const ConstBlockSet &join_blocks(const TerminatorInst &term) {
+    return join_blocks(*term.getParent());
+  }
 };
 
 } // namespace llvm
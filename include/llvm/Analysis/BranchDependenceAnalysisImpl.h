@@ -0,0 +1,392 @@
+//===- BranchDependenceAnalysisImpl.h - Branch Dependence Impl --*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements an algorithm that returns for a divergent branch
+// the set of basic blocks whose phi nodes become divergent due to divergent
+// control. These are the blocks that are reachable by two disjoint paths from
+// the branch or loop exits that have a reaching path that is disjoint from a
+// path to the loop latch.
+//
+// Irreducible cycles are found by decomposing the CFG into strongly connected
+// components: a component entered through a single block is a loop, the
+// cycles nested in it are found in the component without that block. A
+// component entered through several blocks is an irreducible cycle, the cycles
+// nested in it are found in the component without its entries.
+//
+// It is only included by the files that instantiate
+// BranchDependenceAnalysisBase for a kind of block.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ANALYSIS_BRANCHDEPENDENCEANALYSISIMPL_H
+#define LLVM_ANALYSIS_BRANCHDEPENDENCEANALYSISIMPL_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/GraphTraits.h"
+#include "llvm/Analysis/BranchDependenceAnalysis.h"
+#include "llvm/Support/GenericDomTree.h"
+#include <algorithm>
+#include <vector>
+
+namespace llvm {
+
+template <typename BlockT, typename LoopT>
+const typename BranchDependenceAnalysisBase<BlockT, LoopT>::ConstBlockSet &
+BranchDependenceAnalysisBase<BlockT, LoopT>::join_blocks(
+    const BlockT &branchBlock) {
+  auto successors = [](const BlockT *block) {
+    return children<const BlockT *>(block);
+  };
+
+  if (successors(&branchBlock).begin() == successors(&branchBlock).end()) {
+    return emptyBlockSet;
+  }
+
+  auto it = cachedJoinBlocks.find(&branchBlock);
+  if (it != cachedJoinBlocks.end())
+    return *it->second;
+
+  auto joinBlocks = llvm::make_unique<ConstBlockSet>();
+
+  // immediate post dominator (no join block beyond that block)
+  const auto *pdNode = postDomTree.getNode(const_cast<BlockT *>(&branchBlock));
+  const auto *ipdNode = pdNode->getIDom();
+  const auto *pdBoundBlock = ipdNode ? ipdNode->getBlock() : nullptr;
+
+  // loop of branch (loop exits may exhibit temporal diverence)
+  const auto *termLoop = loopInfo.getLoopFor(&branchBlock);
+
+  // innermost irreducible cycle of the branch inside of termLoop, if any. It
+  // is handled like termLoop, with several headers: the defs are not
+  // propagated beyond its entries, and its exits are join blocks.
+  computeIrreducibleCycles(branchBlock);
+  const IrreducibleCycle *termCycle = nullptr;
+  for (const auto &cycle : irreducibleCycles) {
+    if (!cycle->blocks.count(&branchBlock))
+      continue;
+    if (termLoop && !termLoop->contains(cycle->entries.front()))
+      continue; // termLoop is nested in the cycle
+    if (!termCycle || cycle->blocks.size() < termCycle->blocks.size())
+      termCycle = cycle.get();
+  }
+
+  // maps blocks to last valid def
+  using DefMap = std::map<const BlockT *, const BlockT *>;
+  DefMap defMap;
+
+  std::vector<typename DefMap::iterator> worklist;
+
+  // loop exits
+  SmallPtrSet<const BlockT *, 4> exitBlocks;
+
+  // bootstrap with branch targets
+  for (const auto *succBlock : successors(&branchBlock)) {
+    auto itPair = defMap.emplace(succBlock, succBlock);
+
+    // immediate loop exit from @branchBlock
+    if (termLoop && !termLoop->contains(succBlock)) {
+      exitBlocks.insert(succBlock);
+      continue;
+    }
+
+    // immediate cycle exit from @branchBlock
+    if (termCycle && !termCycle->blocks.count(succBlock))
+      joinBlocks->insert(succBlock);
+
+    // otw, propagate
+    worklist.push_back(itPair.first);
+  }
+
+  const BlockT *termLoopHeader = termLoop ? termLoop->getHeader() : nullptr;
+
+  // propagate def (collecting join blocks on the way)
+  while (!worklist.empty()) {
+    auto itDef = worklist.back();
+    worklist.pop_back();
+
+    const auto *block = itDef->first;
+    const auto *defBlock = itDef->second;
+    assert(defBlock);
+
+    if (exitBlocks.count(block))
+      continue;
+
+    // don't step over postdom (if any)
+    if (block == pdBoundBlock)
+      continue;
+
+    if (block == termLoopHeader)
+      continue; // don't propagate beyond termLoopHeader or def will be
+                // overwritten
+
+    if (termCycle && is_contained(termCycle->entries, block))
+      continue; // same for the headers of termCycle
+
+    for (const auto *succBlock : successors(block)) {
+
+      // loop exit (temporal divergence)
+      const auto *succLoop = loopInfo.getLoopFor(succBlock);
+      if (termLoop && (!succLoop || !termLoop->contains(succBlock))) {
+        defMap.emplace(succBlock, defBlock);
+        exitBlocks.insert(succBlock);
+        continue;
+      }
+
+      // cycle exit (temporal divergence), which establishes a new def
+      if (termCycle && termCycle->blocks.count(block) &&
+          !termCycle->blocks.count(succBlock)) {
+        if (joinBlocks->insert(succBlock).second) {
+          auto itExit = defMap.find(succBlock);
+          if (itExit == defMap.end())
+            itExit = defMap.emplace(succBlock, succBlock).first;
+          else
+            itExit->second = succBlock;
+          worklist.push_back(itExit);
+        }
+        continue;
+      }
+
+      // regular successor on same loop level
+      auto itLastDef = defMap.find(succBlock);
+
+      // first reaching def
+      if (itLastDef == defMap.end()) {
+        auto itNext = defMap.emplace(succBlock, defBlock).first;
+        worklist.push_back(itNext);
+        continue;
+      }
+
+      const auto *lastSuccDef = itLastDef->second;
+
+      // control flow join (establish new def). A branch target reached again
+      // with its own def is the header of a loop that all the threads enter
+      // through the same edge, not a join.
+      if (lastSuccDef != defBlock) {
+        if (joinBlocks->insert(succBlock).second) {
+          auto itNewDef = defMap.emplace(succBlock, succBlock).first;
+          worklist.push_back(itNewDef);
+        }
+      }
+    }
+  }
+
+  // if the ipd is inside the loop, the definition at the loop header will be
+  // the same as at the ipd (no other defs can reach)
+  //
+  // A // loop header
+  // |
+  // B // nested loop header
+  // |
+  // C -> X (exit from B loop) -..-> (A latch)
+  // |
+  // D -> back to B (B latch)
+  // |
+  // proper exit from both loops
+  //
+  // D post-dominates B as it is the only proper exit from the "A loop".
+  // If C has a divergent branch, propagation will therefore stop at D.
+  // That implies that B will never receive a definition.
+  // But that definition can only be the same as at D (D itself in thise case)
+  // because all paths to anywhere have to pass through D.
+  //
+  if (termLoop && termLoop->contains(pdBoundBlock)) {
+    defMap[termLoopHeader] = defMap[pdBoundBlock];
+  }
+
+  // analyze reached loop exits
+  if (!exitBlocks.empty()) {
+    assert(termLoop);
+    // the propagation may not reach the header from inside termCycle, in
+    // which case all exits are joins
+    const auto *headerDefBlock = defMap[termLoopHeader];
+    assert((headerDefBlock || termCycle) &&
+           "no definition in header of carrying loop");
+
+    for (const auto *exitBlock : exitBlocks) {
+      assert((defMap[exitBlock] != nullptr) && "no reaching def at loop exit");
+      if (!headerDefBlock || defMap[exitBlock] != headerDefBlock) {
+        joinBlocks->insert(exitBlock);
+      }
+    }
+  }
+
+  // irreducible cycles (loops with multiple headers)
+  //
+  // The threads run a cycle out of sync if the branch stays in it on two
+  // successors, or if they enter it on disjoint paths: through different
+  // entries, or through an entry that is a join. The phis of all of its blocks
+  // may then see different incoming values.
+  // If the branch is in the cycle, or the cycle runs out of sync, the threads
+  // may also leave it in different iterations (temporal divergence), which
+  // makes its exits join blocks.
+  auto &divergentCycles = cachedDivergentCycles[&branchBlock];
+  for (const auto &cycle : irreducibleCycles) {
+    bool containsBranch = cycle->blocks.count(&branchBlock);
+    unsigned succsInCycle = 0;
+    if (containsBranch)
+      for (const auto *succBlock : successors(&branchBlock))
+        succsInCycle += cycle->blocks.count(succBlock);
+
+    bool outOfSync = succsInCycle > 1;
+    unsigned reachedEntries = 0;
+    for (const auto *entry : cycle->entries) {
+      if (!defMap.count(entry))
+        continue;
+      ++reachedEntries;
+      outOfSync |= !containsBranch && joinBlocks->count(entry);
+    }
+    outOfSync |= !containsBranch && reachedEntries > 1;
+    if (!outOfSync && !containsBranch)
+      continue;
+
+    divergentCycles.push_back(cycle.get());
+    for (const auto *block : cycle->blocks) {
+      if (outOfSync)
+        joinBlocks->insert(block);
+      for (const auto *succBlock : successors(block))
+        if (!cycle->blocks.count(succBlock))
+          joinBlocks->insert(succBlock);
+    }
+  }
+
+  auto &result = cachedJoinBlocks[&branchBlock];
+  result = std::move(joinBlocks);
+  return *result;
+}
+
+template <typename BlockT, typename LoopT>
+const typename BranchDependenceAnalysisBase<BlockT, LoopT>::CycleVector &
+BranchDependenceAnalysisBase<BlockT, LoopT>::divergent_cycles(
+    const BlockT &branchBlock) {
+  join_blocks(branchBlock);
+  auto it = cachedDivergentCycles.find(&branchBlock);
+  if (it == cachedDivergentCycles.end())
+    return emptyCycleVector;
+  return it->second;
+}
+
+template <typename BlockT, typename LoopT>
+void BranchDependenceAnalysisBase<BlockT, LoopT>::computeIrreducibleCycles(
+    const BlockT &anyBlock) {
+  if (computedIrreducibleCycles)
+    return;
+  computedIrreducibleCycles = true;
+
+  const auto &function = *anyBlock.getParent();
+  std::vector<const BlockT *> blocks;
+  for (const auto &block : function)
+    blocks.push_back(&block);
+  findIrreducibleCycles(blocks, &function.front());
+}
+
+template <typename BlockT, typename LoopT>
+void BranchDependenceAnalysisBase<BlockT, LoopT>::findIrreducibleCycles(
+    ArrayRef<const BlockT *> region, const BlockT *entryBlock) {
+  using ChildIteratorT = typename GraphTraits<const BlockT *>::ChildIteratorType;
+  struct DFSFrame {
+    const BlockT *block;
+    ChildIteratorT nextSucc;
+    ChildIteratorT endSucc;
+  };
+
+  SmallPtrSet<const BlockT *, 16> inRegion(region.begin(), region.end());
+
+  // Tarjan's algorithm on the subgraph of the region, without recursion
+  DenseMap<const BlockT *, unsigned> index;
+  DenseMap<const BlockT *, unsigned> lowLink;
+  SmallVector<const BlockT *, 16> sccStack;
+  SmallPtrSet<const BlockT *, 16> onSCCStack;
+  SmallVector<DFSFrame, 16> dfsStack;
+  std::vector<SmallVector<const BlockT *, 8>> sccs;
+
+  auto visit = [&](const BlockT *block) {
+    unsigned blockIndex = index.size();
+    index[block] = blockIndex;
+    lowLink[block] = blockIndex;
+    sccStack.push_back(block);
+    onSCCStack.insert(block);
+    dfsStack.push_back({block, GraphTraits<const BlockT *>::child_begin(block),
+                        GraphTraits<const BlockT *>::child_end(block)});
+  };
+
+  for (const auto *root : region) {
+    if (index.count(root))
+      continue;
+    visit(root);
+
+    while (!dfsStack.empty()) {
+      auto &frame = dfsStack.back();
+      if (frame.nextSucc != frame.endSucc) {
+        const BlockT *succBlock = *frame.nextSucc++;
+        if (!inRegion.count(succBlock))
+          continue;
+        auto itIndex = index.find(succBlock);
+        if (itIndex == index.end())
+          visit(succBlock);
+        else if (onSCCStack.count(succBlock))
+          lowLink[frame.block] = std::min(lowLink[frame.block], itIndex->second);
+        continue;
+      }
+
+      const BlockT *block = frame.block;
+      dfsStack.pop_back();
+      if (!dfsStack.empty()) {
+        unsigned &parentLowLink = lowLink[dfsStack.back().block];
+        parentLowLink = std::min(parentLowLink, lowLink[block]);
+      }
+      if (lowLink[block] != index[block])
+        continue;
+
+      SmallVector<const BlockT *, 8> scc;
+      const BlockT *member;
+      do {
+        member = sccStack.pop_back_val();
+        onSCCStack.erase(member);
+        scc.push_back(member);
+      } while (member != block);
+      // a single block is at most a self loop, which has a single entry
+      if (scc.size() > 1)
+        sccs.push_back(std::move(scc));
+    }
+  }
+
+  for (const auto &scc : sccs) {
+    SmallPtrSet<const BlockT *, 8> sccBlocks(scc.begin(), scc.end());
+    SmallVector<const BlockT *, 2> entries;
+    for (const auto *block : scc) {
+      bool isEntry = block == entryBlock;
+      for (const auto *predBlock : children<Inverse<const BlockT *>>(block))
+        isEntry |= !sccBlocks.count(predBlock);
+      if (isEntry)
+        entries.push_back(block);
+    }
+
+    // unreachable from the entry of the function
+    if (entries.empty())
+      continue;
+
+    if (entries.size() > 1) {
+      auto cycle = llvm::make_unique<IrreducibleCycle>();
+      cycle->blocks = std::move(sccBlocks);
+      cycle->entries = entries;
+      irreducibleCycles.push_back(std::move(cycle));
+    }
+
+    // the nested cycles don't go through the entries of this one
+    SmallVector<const BlockT *, 8> innerRegion;
+    for (const auto *block : scc)
+      if (!is_contained(entries, block))
+        innerRegion.push_back(block);
+    findIrreducibleCycles(innerRegion, entryBlock);
+  }
+}
+
+} // namespace llvm
+
+#endif // LLVM_ANALYSIS_BRANCHDEPENDENCEANALYSISIMPL_H
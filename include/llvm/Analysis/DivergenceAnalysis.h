@@ -55,6 +55,9 @@ public:
   // whether @val is a divergent value
   bool isDivergent(const Value &val) const;
 
+  // forget about @val, which is about to be erased
+  void removeValue(const Value &val);
+
   void print(raw_ostream &OS, const Module *) const;
 
 private:
@@ -67,6 +70,10 @@ private:
   // taints all loop live out users
   void taintLoopLiveOuts(const BasicBlock &loopHeader);
 
+  // taints all users outside of an irreducible cycle of values defined in it
+  void taintCycleLiveOuts(
+      const BranchDependenceAnalysis::IrreducibleCycle &cycle);
+
   // mark all phis in @joinBlock as divergent
   void markPHIsDivergent(const BasicBlock &joinBlock);
 
@@ -133,6 +140,9 @@ public:
   // Returns true if V is uniform/non-divergent.
   bool isUniform(const Value &val) const { return !isDivergent(val); }
 
+  // Keep the analysis results uptodate by removing an erased value.
+  void removeValue(const Value &val) { DA.removeValue(val); }
+
   // Print all divergent values in the loop.
   void print(raw_ostream &OS, const Module *) const;
 };
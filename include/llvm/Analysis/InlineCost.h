@@ -14,11 +14,15 @@
 #ifndef LLVM_ANALYSIS_INLINECOST_H
 #define LLVM_ANALYSIS_INLINECOST_H
 
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/CallGraphSCCPass.h"
 #include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/IR/ValueMap.h"
 #include <cassert>
 #include <climits>
+#include <memory>
 
 namespace llvm {
 class AssumptionCacheTracker;
@@ -182,6 +186,71 @@ struct InlineParams {
   Optional<bool> ComputeFullInlineCost;
 };
 
+/// The cost of a callee's body when nothing is known about its arguments.
+///
+/// This doesn't depend on the call site, so it is computed once per callee and
+/// reused for all the call sites whose arguments don't enable any
+/// simplification in the callee: no constant arguments, no arguments pointing
+/// into the caller's allocas, and no two pointer arguments with a common base.
+struct CalleeInlineSummary {
+  /// False if the body contains a construct that stops the analysis, such as
+  /// a recursive call. Such callees are analyzed at every call site.
+  bool IsValid = false;
+
+  /// The cost of all the instructions of the body.
+  int Cost = 0;
+
+  /// Whether the body has a single basic block.
+  bool SingleBB = true;
+
+  /// Whether the body contains a call that can't be duplicated.
+  bool ContainsNoDuplicateCall = false;
+
+  /// Number of bytes allocated statically by the body.
+  uint64_t AllocatedSize = 0;
+
+  unsigned NumInstructions = 0;
+  unsigned NumVectorInstructions = 0;
+  unsigned NumInstructionsSimplified = 0;
+  unsigned NumConstantPtrCmps = 0;
+  unsigned NumConstantPtrDiffs = 0;
+
+  /// The values only used by assumptions, which are not counted.
+  SmallPtrSet<const Value *, 32> EphValues;
+};
+
+/// A cache of callee summaries, for the inline cost queries of an inliner.
+///
+/// Summaries of deleted functions are dropped automatically. Any other change
+/// to a function must be reported with invalidate().
+class InlineCostSummaryCache {
+  struct Config : ValueMapConfig<const Function *> {
+    enum { FollowRAUW = false };
+  };
+  ValueMap<const Function *, std::unique_ptr<CalleeInlineSummary>, Config>
+      Summaries;
+
+public:
+  /// Return the summary of \p F, or null if there is none yet.
+  CalleeInlineSummary *lookup(const Function &F) {
+    auto It = Summaries.find(&F);
+    return It == Summaries.end() ? nullptr : It->second.get();
+  }
+
+  /// Return the summary of \p F, creating an empty one if there is none yet.
+  CalleeInlineSummary &getOrCreate(const Function &F) {
+    auto &Summary = Summaries[&F];
+    if (!Summary)
+      Summary = llvm::make_unique<CalleeInlineSummary>();
+    return *Summary;
+  }
+
+  /// Drop the summary of \p F, whose body has changed.
+  void invalidate(const Function &F) { Summaries.erase(&F); }
+
+  void clear() { Summaries.clear(); }
+};
+
 /// Generate the parameters to tune the inline cost analysis based only on the
 /// commandline options.
 InlineParams getInlineParams();
@@ -213,12 +282,15 @@ int getCallsiteCost(CallSite CS, const DataLayout &DL);
 /// sufficiently low to warrant inlining.
 ///
 /// Also note that calling this function *dynamically* computes the cost of
-/// inlining the callsite. It is an expensive, heavyweight call.
+/// inlining the callsite. It is an expensive, heavyweight call. If \p
+/// Summaries is given, the summary of the callee is reused when the arguments
+/// of the call site don't matter.
 InlineCost getInlineCost(
     CallSite CS, const InlineParams &Params, TargetTransformInfo &CalleeTTI,
     std::function<AssumptionCache &(Function &)> &GetAssumptionCache,
     Optional<function_ref<BlockFrequencyInfo &(Function &)>> GetBFI,
-    ProfileSummaryInfo *PSI, OptimizationRemarkEmitter *ORE = nullptr);
+    ProfileSummaryInfo *PSI, OptimizationRemarkEmitter *ORE = nullptr,
+    InlineCostSummaryCache *Summaries = nullptr);
 
 /// Get an InlineCost with the callee explicitly specified.
 /// This allows you to calculate the cost of inlining a function via a
@@ -230,7 +302,8 @@ getInlineCost(CallSite CS, Function *Callee, const InlineParams &Params,
               TargetTransformInfo &CalleeTTI,
               std::function<AssumptionCache &(Function &)> &GetAssumptionCache,
               Optional<function_ref<BlockFrequencyInfo &(Function &)>> GetBFI,
-              ProfileSummaryInfo *PSI, OptimizationRemarkEmitter *ORE);
+              ProfileSummaryInfo *PSI, OptimizationRemarkEmitter *ORE,
+              InlineCostSummaryCache *Summaries = nullptr);
 
 /// Minimal filter to detect invalid constructs for inlining.
 bool isInlineViable(Function &Callee);
@@ -52,14 +52,27 @@ public:
   bool isUniform(const Value *V) const { return !isDivergent(V); }
 
   // Keep the analysis results uptodate by removing an erased value.
-  void removeValue(const Value *V) { DivergentValues.erase(V); }
+  void removeValue(const Value *V);
 
 private:
+  // Records the values on which DivergencePropagator and the new
+  // DivergenceAnalysis disagree (-divergence-compare).
+  void compareEngines(const Function &F);
+
   // (optional) handle to new DivergenceAnalysis
   std::unique_ptr<GPUDivergenceAnalysis> gpuDA;
 
+  // Whether isDivergent() answers from gpuDA. gpuDA may also be computed
+  // without being used, to compare both analyses.
+  bool UseGPUDA = false;
+
   // Stores all divergent values.
   DenseSet<const Value *> DivergentValues;
+
+  // Values that only one of the two analyses considers divergent, in
+  // -divergence-compare mode.
+  std::vector<const Value *> PropagatorOnlyDivergent;
+  std::vector<const Value *> GPUDAOnlyDivergent;
 };
 } // End llvm namespace
 
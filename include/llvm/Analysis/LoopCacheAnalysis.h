@@ -0,0 +1,113 @@
+//===- llvm/Analysis/LoopCacheAnalysis.h - Loop cache cost ------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the CacheCost class, which estimates the number of cache
+// lines touched by a loop nest for each choice of its innermost loop, from the
+// SCEV access functions of its memory references and the target cache line
+// size. It is used by loop transformations that reorder or tile loops.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ANALYSIS_LOOPCACHEANALYSIS_H
+#define LLVM_ANALYSIS_LOOPCACHEANALYSIS_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace llvm {
+
+class Loop;
+class raw_ostream;
+class ScalarEvolution;
+class SCEV;
+class TargetTransformInfo;
+
+/// Cache cost of a perfect loop nest.
+///
+/// The memory references of the nest are grouped: two references whose
+/// addresses are a constant distance apart, smaller than a cache line, share
+/// their lines and are counted once. When loop L is the innermost loop, a group
+/// touches:
+///  - 1 line, if its address is invariant in L,
+///  - TripCount(L) * Stride / LineSize lines, if its address advances by a
+///    constant Stride smaller than a line per iteration of L,
+///  - TripCount(L) lines otherwise.
+/// The cost of L is the sum of this over all groups, times the trip counts of
+/// the other loops of the nest. Loops whose trip count is not a known constant
+/// are assumed to run -loop-cache-default-trip-count iterations.
+class CacheCost {
+public:
+  using LoopCost = std::pair<const Loop *, uint64_t>;
+
+  /// Compute the cost of the loop nest rooted at \p Root. Returns null if the
+  /// nest isn't perfect, i.e. some loop of it other than the innermost one
+  /// doesn't have exactly one subloop.
+  static std::unique_ptr<CacheCost> get(const Loop &Root, ScalarEvolution &SE,
+                                        const TargetTransformInfo &TTI);
+
+  /// Returns the number of lines touched by the nest if \p L is its innermost
+  /// loop.
+  uint64_t getLoopCost(const Loop &L) const;
+
+  /// Returns the loops of the nest with their cost, from the most expensive to
+  /// the cheapest one. This is the preferred order of the loops, from the
+  /// outermost to the innermost one.
+  ArrayRef<LoopCost> getLoopCosts() const { return LoopCosts; }
+
+  /// Returns the number of lines touched by a single run of \p L, as the
+  /// innermost loop of the nest.
+  uint64_t getFootprint(const Loop &L) const;
+
+  /// Returns true if a reference of the nest varies in \p Inner but not in
+  /// \p L, so that consecutive iterations of \p L touch the same lines if
+  /// these stay in the cache.
+  bool hasReuseAcross(const Loop &L, const Loop &Inner) const;
+
+  /// Returns the trip count assumed for \p L.
+  uint64_t getTripCount(const Loop &L) const;
+
+  unsigned getCacheLineSize() const { return LineSize; }
+
+  void print(raw_ostream &OS) const;
+
+private:
+  CacheCost(ScalarEvolution &SE, unsigned LineSize)
+      : SE(SE), LineSize(LineSize) {}
+
+  unsigned getLoopIndex(const Loop &L) const;
+
+  /// Lines touched by the references of \p Group during a run of the loop
+  /// \p LoopIdx.
+  uint64_t computeRefCost(const SCEV *Group, unsigned LoopIdx) const;
+
+  ScalarEvolution &SE;
+  unsigned LineSize;
+
+  /// The loops of the nest, from the outermost to the innermost one, and their
+  /// trip counts.
+  SmallVector<const Loop *, 4> Loops;
+  SmallVector<uint64_t, 4> TripCounts;
+
+  /// The address of the first reference of each group.
+  SmallVector<const SCEV *, 16> Groups;
+
+  SmallVector<LoopCost, 4> LoopCosts;
+};
+
+inline raw_ostream &operator<<(raw_ostream &OS, const CacheCost &CC) {
+  CC.print(OS);
+  return OS;
+}
+
+} // end namespace llvm
+
+#endif // LLVM_ANALYSIS_LOOPCACHEANALYSIS_H
@@ -734,6 +734,11 @@ public:
   /// performed.
   unsigned getMaxPrefetchIterationsAhead() const;
 
+  /// \return True if loads whose address depends on another load in the loop,
+  /// such as a[b[i]], should be prefetched.  The index is loaded ahead of time
+  /// to compute the prefetched address.
+  bool enableIndirectPrefetch() const;
+
   /// \return The maximum interleave factor that any transform should try to
   /// perform for this target. This number depends on the level of parallelism
   /// and the number of execution units in the CPU.
@@ -1098,6 +1103,7 @@ public:
   virtual unsigned getPrefetchDistance() = 0;
   virtual unsigned getMinPrefetchStride() = 0;
   virtual unsigned getMaxPrefetchIterationsAhead() = 0;
+  virtual bool enableIndirectPrefetch() = 0;
   virtual unsigned getMaxInterleaveFactor(unsigned VF) = 0;
   virtual unsigned
   getArithmeticInstrCost(unsigned Opcode, Type *Ty, OperandValueKind Opd1Info,
@@ -1413,6 +1419,9 @@ public:
   unsigned getMaxPrefetchIterationsAhead() override {
     return Impl.getMaxPrefetchIterationsAhead();
   }
+  bool enableIndirectPrefetch() override {
+    return Impl.enableIndirectPrefetch();
+  }
   unsigned getMaxInterleaveFactor(unsigned VF) override {
     return Impl.getMaxInterleaveFactor(VF);
   }
@@ -394,6 +394,8 @@ public:
 
   unsigned getMaxPrefetchIterationsAhead() { return UINT_MAX; }
 
+  bool enableIndirectPrefetch() { return false; }
+
   unsigned getMaxInterleaveFactor(unsigned VF) { return 1; }
 
   unsigned getArithmeticInstrCost(unsigned Opcode, Type *Ty,
@@ -37,6 +37,8 @@ public:
 
   FunctionPass *createMachinePostDominatorTreePass();
 
+  PostDomTreeBase<MachineBasicBlock> &getBase() { return *DT; }
+
   const SmallVectorImpl<MachineBasicBlock *> &getRoots() const {
     return DT->getRoots();
   }
@@ -0,0 +1,90 @@
+//===- MachineUniformityAnalysis.h - Machine divergence analysis -*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines MachineUniformityInfo, which finds the virtual registers
+// of a machine function in SSA form that may hold different values in the
+// threads of a SIMT target, and the blocks that end with a divergent branch.
+//
+// The sources of divergence are given by the target through
+// TargetInstrInfo::getInstructionUniformity. Divergence is then propagated
+// along the uses of the registers and, for divergent branches, to the phis of
+// the join blocks found by BranchDependenceAnalysisBase, as in the IR
+// DivergenceAnalysis.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CODEGEN_MACHINEUNIFORMITYANALYSIS_H
+#define LLVM_CODEGEN_MACHINEUNIFORMITYANALYSIS_H
+
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/CodeGen/MachineFunctionPass.h"
+#include <vector>
+
+namespace llvm {
+
+class MachineBasicBlock;
+class MachineInstr;
+class MachineLoop;
+class MachineLoopInfo;
+class MachineRegisterInfo;
+template <typename BlockT, typename LoopT> class BranchDependenceAnalysisBase;
+
+class MachineUniformityInfo : public MachineFunctionPass {
+public:
+  static char ID;
+
+  MachineUniformityInfo();
+
+  /// Returns true if the virtual register \p Reg may hold different values in
+  /// the threads. Physical registers are not tracked.
+  bool isDivergent(unsigned Reg) const;
+  bool isUniform(unsigned Reg) const { return !isDivergent(Reg); }
+
+  /// Returns true if \p MI defines a divergent register or is a divergent
+  /// branch.
+  bool isDivergent(const MachineInstr &MI) const;
+
+  /// Returns true if the threads may take different successors of \p MBB.
+  bool hasDivergentBranch(const MachineBasicBlock &MBB) const;
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+  bool runOnMachineFunction(MachineFunction &MF) override;
+  void releaseMemory() override;
+  void print(raw_ostream &OS, const Module *M = nullptr) const override;
+
+private:
+  void markDivergent(const MachineInstr &MI);
+  void propagateBranchDivergence(const MachineBasicBlock &MBB);
+  void taintLoopLiveOuts(const MachineLoop &L);
+  void
+  taintCycleLiveOuts(const SmallPtrSetImpl<const MachineBasicBlock *> &Cycle);
+  bool updateInstruction(const MachineInstr &MI) const;
+
+  const MachineFunction *MF = nullptr;
+  const MachineRegisterInfo *MRI = nullptr;
+  const MachineLoopInfo *MLI = nullptr;
+  BranchDependenceAnalysisBase<MachineBasicBlock, MachineLoop> *BDA = nullptr;
+
+  /// Set if the function is not in SSA form, in which case every register is
+  /// assumed to be divergent.
+  bool AllDivergent = false;
+
+  DenseSet<unsigned> DivergentRegs;
+  SmallPtrSet<const MachineInstr *, 32> DivergentInstrs;
+  SmallPtrSet<const MachineInstr *, 8> UniformOverrides;
+  SmallPtrSet<const MachineBasicBlock *, 8> DivergentBranchBlocks;
+  SmallPtrSet<const MachineBasicBlock *, 8> JoinDivergentBlocks;
+  SmallPtrSet<const MachineLoop *, 4> TaintedLoops;
+  std::vector<const MachineInstr *> Worklist;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_CODEGEN_MACHINEUNIFORMITYANALYSIS_H
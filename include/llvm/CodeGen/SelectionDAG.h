@@ -471,7 +471,9 @@ public:
     return Root;
   }
 
+#ifndef NDEBUG
   void VerifyDAGDiverence();
+#endif
 
   /// This iterates over the nodes in the SelectionDAG, folding
   /// certain types of nodes together, or eliminating superfluous nodes.  The
@@ -1159,6 +1161,9 @@ public:
   // Propagates the change in divergence to users
   void updateDivergence(SDNode * N);
 
+  // Computes the divergence of N from its operands.
+  bool calculateDivergence(SDNode *N);
+
   /// These are used for target selectors to *mutate* the
   /// specified node to have the specified return type, Target opcode, and
   /// operands.  Note that target opcodes are stored as
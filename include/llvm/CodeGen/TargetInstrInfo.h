@@ -60,6 +60,18 @@ class TargetSubtargetInfo;
 
 template <class T> class SmallVectorImpl;
 
+/// How the value computed by an instruction relates to the values of its
+/// operands in the threads of a SIMT target, see
+/// TargetInstrInfo::getInstructionUniformity.
+enum class InstructionUniformity {
+  /// The result is uniform if all the operands are uniform.
+  Default,
+  /// The result is uniform, whatever the operands are.
+  AlwaysUniform,
+  /// The result may be divergent, whatever the operands are.
+  NeverUniform
+};
+
 //---------------------------------------------------------------------------
 ///
 /// TargetInstrInfo - Interface to description of machine instruction set
@@ -1233,6 +1245,14 @@ public:
                                     const MachineBasicBlock *MBB,
                                     const MachineFunction &MF) const;
 
+  /// Return how the values defined by \p MI, or the branch it performs,
+  /// depend on the threads of a SIMT target. This gives the sources of
+  /// divergence to MachineUniformityInfo.
+  virtual InstructionUniformity
+  getInstructionUniformity(const MachineInstr &MI) const {
+    return InstructionUniformity::Default;
+  }
+
   /// Measure the specified inline asm to determine an approximation of its
   /// length.
   virtual unsigned getInlineAsmLength(const char *Str,
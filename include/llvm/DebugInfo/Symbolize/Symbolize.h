@@ -19,9 +19,11 @@
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Support/Error.h"
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -33,6 +35,11 @@ using namespace object;
 
 using FunctionNameKind = DILineInfoSpecifier::FunctionNameKind;
 
+/// Symbolizes addresses in a set of modules, caching the modules it loads.
+///
+/// The symbolize* methods may be called concurrently from several threads.
+/// Queries to different modules run in parallel; queries to the same module
+/// are serialized, since debug info contexts are parsed lazily.
 class LLVMSymbolizer {
 public:
   struct Options {
@@ -42,6 +49,10 @@ public:
     bool RelativeAddresses : 1;
     std::string DefaultArch;
     std::vector<std::string> DsymHints;
+    /// Upper bound, in bytes, on the size of the debug info of the modules
+    /// kept loaded. When it is exceeded, the least recently used modules are
+    /// unloaded, and will be loaded again if queried. Zero means no limit.
+    uint64_t MaxCacheSize = 0;
 
     Options(FunctionNameKind PrintFunctions = FunctionNameKind::LinkageName,
             bool UseSymbolTable = true, bool Demangle = true,
@@ -65,6 +76,8 @@ public:
                                                 StringRef DWPName = "");
   Expected<DIGlobal> symbolizeData(const std::string &ModuleName,
                                    uint64_t ModuleOffset);
+  /// Unload all the modules. This must not be called concurrently with any
+  /// other method.
   void flush();
 
   static std::string
@@ -76,12 +89,46 @@ private:
   // corresponding debug info. These objects can be the same.
   using ObjectPair = std::pair<ObjectFile *, ObjectFile *>;
 
+  /// A cached module, and the lock that serializes the queries to it.
+  struct ModuleEntry {
+    std::mutex Lock;
+    /// Whether loading the module has been attempted. A module that has been
+    /// evicted from the cache is not loaded.
+    bool Loaded = false;
+    /// The module, or null if loading it failed.
+    std::unique_ptr<SymbolizableModule> Module;
+    /// Size of the debug info of the module.
+    uint64_t Size = 0;
+    /// Last time the module was used, for LRU eviction.
+    uint64_t LastUse = 0;
+  };
+
+  /// The module cache is split into shards with their own lock, so that
+  /// threads querying different modules rarely contend.
+  struct ModuleShard {
+    std::mutex Lock;
+    std::map<std::string, std::unique_ptr<ModuleEntry>> Modules;
+  };
+  static constexpr unsigned NumModuleShards = 16;
+
   /// Returns a SymbolizableModule or an error if loading debug info failed.
   /// Only one attempt is made to load a module, and errors during loading are
   /// only reported once. Subsequent calls to get module info for a module that
-  /// failed to load will return nullptr.
+  /// failed to load will return nullptr. The module can only be used while
+  /// \p ModuleLock is held.
   Expected<SymbolizableModule *>
-  getOrCreateModuleInfo(const std::string &ModuleName, StringRef DWPName = "");
+  getOrCreateModuleInfo(const std::string &ModuleName,
+                        std::unique_lock<std::mutex> &ModuleLock,
+                        StringRef DWPName = "");
+
+  /// Load the module of \p Entry, whose lock is held.
+  Expected<SymbolizableModule *> loadModule(const std::string &ModuleName,
+                                            ModuleEntry &Entry,
+                                            StringRef DWPName);
+
+  /// Unload least recently used modules until the cache size is below the
+  /// limit. \p InUse, whose lock is held by the caller, is never unloaded.
+  void evictModules(const ModuleEntry *InUse);
 
   ObjectFile *lookUpDsymFile(const std::string &Path,
                              const MachOObjectFile *ExeObj,
@@ -100,7 +147,19 @@ private:
   Expected<ObjectFile *> getOrCreateObject(const std::string &Path,
                                           const std::string &ArchName);
 
-  std::map<std::string, std::unique_ptr<SymbolizableModule>> Modules;
+  ModuleShard ModuleShards[NumModuleShards];
+
+  /// Total size of the debug info of the loaded modules.
+  std::atomic<uint64_t> CacheSize{0};
+
+  /// Clock used to order module uses.
+  std::atomic<uint64_t> UseClock{0};
+
+  /// Serializes evictions.
+  std::mutex EvictionLock;
+
+  /// Guards the object file caches below.
+  std::mutex ObjectCacheLock;
 
   /// Contains cached results of getOrCreateObjectPair().
   std::map<std::pair<std::string, std::string>, ObjectPair>
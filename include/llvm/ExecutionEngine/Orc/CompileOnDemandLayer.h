@@ -68,17 +68,20 @@ public:
   using IndirectStubsManagerBuilder =
       std::function<std::unique_ptr<IndirectStubsManager>()>;
 
-  using GetAvailableContextFunction = std::function<LLVMContext &()>;
+  /// Returns the context that extracted (globals and function) modules
+  /// should be cloned into. Returning a fresh context for each call allows
+  /// extracted modules to be compiled concurrently.
+  using GetAvailableContextFunction = std::function<ThreadSafeContext()>;
 
   CompileOnDemandLayer2(ExecutionSession &ES, IRLayer &BaseLayer,
                         JITCompileCallbackManager &CCMgr,
                         IndirectStubsManagerBuilder BuildIndirectStubsManager,
                         GetAvailableContextFunction GetAvailableContext);
 
-  Error add(VSO &V, VModuleKey K, std::unique_ptr<Module> M) override;
+  Error add(VSO &V, VModuleKey K, ThreadSafeModule TSM) override;
 
   void emit(MaterializationResponsibility R, VModuleKey K,
-            std::unique_ptr<Module> M) override;
+            ThreadSafeModule TSM) override;
 
 private:
   using StubManagersMap =
@@ -87,7 +90,7 @@ private:
   IndirectStubsManager &getStubsManager(const VSO &V);
 
   void emitExtractedFunctionsModule(MaterializationResponsibility R,
-                                    std::unique_ptr<Module> M);
+                                    ThreadSafeModule TSM);
 
   mutable std::mutex CODLayerMutex;
 
@@ -27,7 +27,10 @@
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetMachine.h"
 #include <algorithm>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 namespace llvm {
 
@@ -103,25 +106,41 @@ private:
 
 /// A thread-safe version of SimpleCompiler.
 ///
-/// This class creates a new TargetMachine and SimpleCompiler instance for each
-/// compile.
+/// TargetMachines are not thread safe, so this class lazily creates one
+/// TargetMachine per compiling thread (using the given builder) and reuses it
+/// for all subsequent compiles on that thread. Copies of a
+/// MultiThreadedSimpleCompiler share the same set of TargetMachines.
 class MultiThreadedSimpleCompiler {
 public:
   MultiThreadedSimpleCompiler(JITTargetMachineBuilder JTMB,
                               ObjectCache *ObjCache = nullptr)
-      : JTMB(std::move(JTMB)), ObjCache(ObjCache) {}
+      : JTMB(std::move(JTMB)), ObjCache(ObjCache),
+        TMs(std::make_shared<PerThreadTargetMachines>()) {}
 
   void setObjectCache(ObjectCache *ObjCache) { this->ObjCache = ObjCache; }
 
   std::unique_ptr<MemoryBuffer> operator()(Module &M) {
-    auto TM = cantFail(JTMB.createTargetMachine());
-    SimpleCompiler C(*TM, ObjCache);
+    SimpleCompiler C(getTargetMachineForCurrentThread(), ObjCache);
     return C(M);
   }
 
 private:
+  struct PerThreadTargetMachines {
+    std::mutex Mutex;
+    std::map<std::thread::id, std::unique_ptr<TargetMachine>> TMs;
+  };
+
+  TargetMachine &getTargetMachineForCurrentThread() {
+    std::lock_guard<std::mutex> Lock(TMs->Mutex);
+    auto &TM = TMs->TMs[std::this_thread::get_id()];
+    if (!TM)
+      TM = cantFail(JTMB.createTargetMachine());
+    return *TM;
+  }
+
   JITTargetMachineBuilder JTMB;
   ObjectCache *ObjCache = nullptr;
+  std::shared_ptr<PerThreadTargetMachines> TMs;
 };
 
 } // end namespace orc
@@ -62,10 +62,15 @@ public:
     this->CM = std::move(CM);
     return *this;
   }
+  JITTargetMachineBuilder &setCodeGenOptLevel(CodeGenOpt::Level OptLevel) {
+    this->OptLevel = OptLevel;
+    return *this;
+  }
   JITTargetMachineBuilder &
   addFeatures(const std::vector<std::string> &FeatureVec);
   SubtargetFeatures &getFeatures() { return Features; }
   TargetOptions &getOptions() { return Options; }
+  const Triple &getTargetTriple() const { return TT; }
 
 private:
   Triple TT;
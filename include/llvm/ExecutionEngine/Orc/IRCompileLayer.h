@@ -16,6 +16,7 @@
 
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ExecutionEngine/JITSymbol.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/Orc/Layer.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -34,21 +35,27 @@ public:
       std::function<Expected<std::unique_ptr<MemoryBuffer>>(Module &)>;
 
   using NotifyCompiledFunction =
-      std::function<void(VModuleKey K, std::unique_ptr<Module>)>;
+      std::function<void(VModuleKey K, ThreadSafeModule TSM)>;
 
   IRCompileLayer2(ExecutionSession &ES, ObjectLayer &BaseLayer,
                   CompileFunction Compile);
 
   void setNotifyCompiled(NotifyCompiledFunction NotifyCompiled);
 
+  /// Set an ObjectCache to query before compiling each module, and to notify
+  /// of each newly compiled object. The cache must outlive this layer. If the
+  /// compile function also consults a cache, the two should not be the same.
+  void setObjectCache(ObjectCache *ObjCache);
+
   void emit(MaterializationResponsibility R, VModuleKey K,
-            std::unique_ptr<Module> M) override;
+            ThreadSafeModule TSM) override;
 
 private:
   mutable std::mutex IRLayerMutex;
   ObjectLayer &BaseLayer;
   CompileFunction Compile;
   NotifyCompiledFunction NotifyCompiled = NotifyCompiledFunction();
+  ObjectCache *ObjCache = nullptr;
 };
 
 /// Eager IR compiling layer.
@@ -21,6 +21,9 @@
 #include "llvm/ExecutionEngine/Orc/IRTransformLayer.h"
 #include "llvm/ExecutionEngine/Orc/ObjectTransformLayer.h"
 #include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
+#include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include "llvm/ExecutionEngine/Orc/TieredCompileLayer.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Target/TargetMachine.h"
 
 namespace llvm {
@@ -29,11 +32,23 @@ namespace orc {
 /// A pre-fabricated ORC JIT stack that can serve as an alternative to MCJIT.
 class LLJIT {
 public:
-  /// Create an LLJIT instance.
+  /// Create an LLJIT instance that compiles on the thread that triggers
+  /// materialization.
   static Expected<std::unique_ptr<LLJIT>>
   Create(std::unique_ptr<ExecutionSession> ES,
          std::unique_ptr<TargetMachine> TM, DataLayout DL);
 
+  /// Create an LLJIT instance. If NumCompileThreads is non-zero then
+  /// materializations will be dispatched to a pool of that many compile
+  /// threads, each of which builds its own TargetMachine using JTMB. Lookups
+  /// only block on the symbols that they need.
+  static Expected<std::unique_ptr<LLJIT>>
+  Create(std::unique_ptr<ExecutionSession> ES, JITTargetMachineBuilder JTMB,
+         DataLayout DL, unsigned NumCompileThreads);
+
+  /// Destruct this instance. Waits for any outstanding compiles to finish.
+  ~LLJIT();
+
   /// Returns a reference to the ExecutionSession for this JIT instance.
   ExecutionSession &getExecutionSession() { return *ES; }
 
@@ -44,11 +59,11 @@ public:
   Error defineAbsolute(StringRef Name, JITEvaluatedSymbol Address);
 
   /// Adds an IR module to the given VSO.
-  Error addIRModule(VSO &V, std::unique_ptr<Module> M);
+  Error addIRModule(VSO &V, ThreadSafeModule TSM);
 
   /// Adds an IR module to the Main VSO.
-  Error addIRModule(std::unique_ptr<Module> M) {
-    return addIRModule(Main, std::move(M));
+  Error addIRModule(ThreadSafeModule TSM) {
+    return addIRModule(Main, std::move(TSM));
   }
 
   /// Look up a symbol in VSO V by the symbol's linker-mangled name (to look up
@@ -71,6 +86,13 @@ public:
     return lookup(Main, UnmangledName);
   }
 
+  /// Set an ObjectCache to query before compiling each module (see
+  /// OnDiskObjectCache for a persistent implementation). The cache must
+  /// outlive this instance.
+  void setObjectCache(ObjectCache *ObjCache) {
+    CompileLayer.setObjectCache(ObjCache);
+  }
+
   /// Runs all not-yet-run static constructors.
   Error runConstructors() { return CtorRunner.run(); }
 
@@ -81,6 +103,13 @@ protected:
   LLJIT(std::unique_ptr<ExecutionSession> ES, std::unique_ptr<TargetMachine> TM,
         DataLayout DL);
 
+  LLJIT(std::unique_ptr<ExecutionSession> ES, JITTargetMachineBuilder JTMB,
+        DataLayout DL, unsigned NumCompileThreads);
+
+  /// Block until all materializations dispatched to the compile threads have
+  /// completed. No-op if this instance compiles on the calling thread.
+  void waitForCompileThreads();
+
   std::shared_ptr<RuntimeDyld::MemoryManager> getMemoryManager(VModuleKey K);
 
   std::string mangle(StringRef UnmangledName);
@@ -94,6 +123,7 @@ protected:
 
   std::unique_ptr<TargetMachine> TM;
   DataLayout DL;
+  std::unique_ptr<ThreadPool> CompileThreads;
 
   RTDyldObjectLinkingLayer2 ObjLinkingLayer;
   IRCompileLayer2 CompileLayer;
@@ -105,35 +135,80 @@ protected:
 /// compilation of LLVM IR.
 class LLLazyJIT : public LLJIT {
 public:
-  /// Create an LLLazyJIT instance.
+  /// Create an LLLazyJIT instance that compiles on the thread that triggers
+  /// materialization.
   static Expected<std::unique_ptr<LLLazyJIT>>
   Create(std::unique_ptr<ExecutionSession> ES,
-         std::unique_ptr<TargetMachine> TM, DataLayout DL, LLVMContext &Ctx);
+         std::unique_ptr<TargetMachine> TM, DataLayout DL);
+
+  /// Create an LLLazyJIT instance. If NumCompileThreads is non-zero then
+  /// partition extraction and compilation will be dispatched to a pool of that
+  /// many compile threads.
+  static Expected<std::unique_ptr<LLLazyJIT>>
+  Create(std::unique_ptr<ExecutionSession> ES, JITTargetMachineBuilder JTMB,
+         DataLayout DL, unsigned NumCompileThreads);
+
+  /// Destruct this instance. Waits for any outstanding compiles to finish.
+  ~LLLazyJIT();
 
   /// Set an IR transform (e.g. pass manager pipeline) to run on each function
   /// when it is compiled.
   void setLazyCompileTransform(IRTransformLayer2::TransformFunction Transform) {
+    BaselineTransformLayer.setTransform(Transform);
     TransformLayer.setTransform(std::move(Transform));
   }
 
+  /// Enable tiered compilation: functions are first compiled without
+  /// Transform and without codegen optimizations, and recompiled in the
+  /// background with Transform applied once Policy reports them hot. Only
+  /// applies to modules compiled after the call.
+  void setTierUpTransform(IRTransformLayer2::TransformFunction Transform,
+                          TieredCompileLayer::TierUpPolicy Policy =
+                              TieredCompileLayer::callCountThreshold(1000)) {
+    TieredLayer.setTierUpPolicy(std::move(Policy));
+    TieredLayer.setOptimizeTransform(std::move(Transform));
+  }
+
+  /// Returns a reference to the tiered compile layer, e.g. to query the tier
+  /// state of functions.
+  TieredCompileLayer &getTieredCompileLayer() { return TieredLayer; }
+
   /// Add a module to be lazily compiled to VSO V.
-  Error addLazyIRModule(VSO &V, std::unique_ptr<Module> M);
+  Error addLazyIRModule(VSO &V, ThreadSafeModule TSM);
 
   /// Add a module to be lazily compiled to the main VSO.
-  Error addLazyIRModule(std::unique_ptr<Module> M) {
-    return addLazyIRModule(Main, std::move(M));
+  Error addLazyIRModule(ThreadSafeModule TSM) {
+    return addLazyIRModule(Main, std::move(TSM));
   }
 
 private:
   LLLazyJIT(std::unique_ptr<ExecutionSession> ES,
-            std::unique_ptr<TargetMachine> TM, DataLayout DL, LLVMContext &Ctx,
+            std::unique_ptr<TargetMachine> TM,
+            std::unique_ptr<TargetMachine> BaselineTM, DataLayout DL,
             std::unique_ptr<JITCompileCallbackManager> CCMgr,
             std::function<std::unique_ptr<IndirectStubsManager>()> ISMBuilder);
 
+  LLLazyJIT(std::unique_ptr<ExecutionSession> ES, JITTargetMachineBuilder JTMB,
+            JITTargetMachineBuilder BaselineJTMB, DataLayout DL,
+            unsigned NumCompileThreads,
+            std::unique_ptr<JITCompileCallbackManager> CCMgr,
+            std::function<std::unique_ptr<IndirectStubsManager>()> ISMBuilder);
+
+  /// Each extracted partition gets a fresh context so that partitions of the
+  /// same source module can be compiled concurrently.
+  static ThreadSafeContext createPartitionContext();
+
   std::unique_ptr<JITCompileCallbackManager> CCMgr;
   std::function<std::unique_ptr<IndirectStubsManager>()> ISMBuilder;
 
+  // Baseline tier code is compiled at CodeGenOpt::None. It embeds the
+  // addresses of the tier-up counters, so it bypasses the object cache.
+  std::unique_ptr<TargetMachine> BaselineTM;
+  IRCompileLayer2 BaselineCompileLayer;
+  IRTransformLayer2 BaselineTransformLayer;
+
   IRTransformLayer2 TransformLayer;
+  TieredCompileLayer TieredLayer;
   CompileOnDemandLayer2 CODLayer;
 };
 
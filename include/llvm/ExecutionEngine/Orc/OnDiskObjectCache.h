@@ -0,0 +1,82 @@
+//===- OnDiskObjectCache.h - Persistent JIT object cache --------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectCache that persists compiled objects in a directory on disk, keyed
+// by a hash of the module bitcode and the target configuration.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/Error.h"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace llvm {
+
+class TargetMachine;
+
+namespace orc {
+
+/// Persistent object cache.
+///
+///   Objects are stored as <CacheDir>/llvmcache-<key>, where the key is a SHA1
+/// of the LLVM version, the target configuration of the TargetMachine used to
+/// create the cache, and the bitcode of the module being compiled. Entries
+/// are written atomically, so several JIT processes can share a directory.
+/// The file naming matches pruneCache, which is run with the given policy
+/// when the cache is destroyed (or by calling prune).
+///
+///   The key for a module is computed before it is compiled, since codegen may
+/// modify the module. Queries and notifications may come from any thread.
+class OnDiskObjectCache : public ObjectCache {
+public:
+  /// Create an OnDiskObjectCache for objects compiled by TM (or by
+  /// TargetMachines configured identically to it), creating CacheDir if
+  /// necessary.
+  static Expected<std::unique_ptr<OnDiskObjectCache>>
+  Create(StringRef CacheDir, const TargetMachine &TM,
+         CachePruningPolicy Policy = CachePruningPolicy());
+
+  /// Destruct this cache, pruning the cache directory.
+  ~OnDiskObjectCache() override;
+
+  /// Returns the cached object for M, or null on a cache miss.
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+  /// Writes Obj to the cache entry for M. Must follow a getObject call for M
+  /// that missed. Failures to write are ignored: the cache is best-effort.
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+
+  /// Prune the cache directory according to the pruning policy.
+  void prune();
+
+private:
+  OnDiskObjectCache(std::string CacheDir, std::string TargetKey,
+                    CachePruningPolicy Policy);
+
+  std::string getEntryPath(const Module &M);
+
+  std::string CacheDir;
+  std::string TargetKey;
+  CachePruningPolicy Policy;
+
+  std::mutex PendingEntriesMutex;
+  DenseMap<const Module *, std::string> PendingEntries;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
@@ -0,0 +1,183 @@
+//===- TieredCompileLayer.h - Tiered IR compilation -------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// A layer that compiles functions twice: first as a cheap baseline
+// instrumented with an entry counter, then (once the function is hot) with an
+// optimizing transform applied, repointing an indirect stub at the result.
+// The two tiers may be emitted through different layers, e.g. to generate the
+// baseline code at -O0.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_TIEREDCOMPILELAYER_H
+#define LLVM_EXECUTIONENGINE_ORC_TIEREDCOMPILELAYER_H
+
+#include "llvm/ADT/Optional.h"
+#include "llvm/ExecutionEngine/Orc/IRTransformLayer.h"
+#include "llvm/ExecutionEngine/Orc/IndirectionUtils.h"
+#include "llvm/ExecutionEngine/Orc/Layer.h"
+#include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include "llvm/Support/ThreadPool.h"
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace llvm {
+
+class Function;
+
+namespace orc {
+
+/// Tiered compilation layer.
+///
+///   Each externally visible function definition emitted through this layer is
+/// renamed to <name>$tier0, instrumented with an entry counter and passed to
+/// the baseline layer. The original symbol is resolved to an indirect stub
+/// that points at the baseline code. When a function's counter reaches the
+/// threshold chosen by the tier-up policy, a pristine copy of the function is
+/// optimized with the optimize transform in the background, emitted through
+/// the optimized layer as <name>$tier1, and the stub is repointed at it.
+/// Modules that are not tiered are passed to the optimized layer.
+///
+///   The counters and the tier-up hook are addressed directly from JIT'd code,
+/// so this layer only supports in-process JITs. Modules with non-constant
+/// internal globals are passed through untiered, since the optimized copy
+/// could not share that state with the baseline code.
+class TieredCompileLayer : public IRLayer {
+public:
+  /// Builder for IndirectStubsManagers.
+  using IndirectStubsManagerBuilder =
+      std::function<std::unique_ptr<IndirectStubsManager>()>;
+
+  /// Returns the call count at which the given function should be recompiled
+  /// by the optimizing tier, or zero if the function should never tier up.
+  using TierUpPolicy = std::function<uint64_t(const Function &F)>;
+
+  /// The compilation tier a function is currently running in.
+  enum class Tier {
+    Baseline,   ///< Running instrumented baseline code.
+    Optimizing, ///< Hot; optimized code is being compiled in the background.
+    Optimized   ///< Stub has been repointed at the optimized code.
+  };
+
+  /// A snapshot of a tiered function's state.
+  struct FunctionTierState {
+    Tier CurrentTier;
+    uint64_t CallCount;
+  };
+
+  /// Construct a TieredCompileLayer. Optimized code is compiled on a pool of
+  /// NumOptimizeThreads background threads, created on the first tier-up (or
+  /// on the thread that requests the tier-up if LLVM was built without thread
+  /// support).
+  TieredCompileLayer(ExecutionSession &ES, IRLayer &BaselineLayer,
+                     IRLayer &OptimizedLayer,
+                     IndirectStubsManagerBuilder BuildIndirectStubsManager,
+                     unsigned NumOptimizeThreads = 1);
+
+  /// Construct a TieredCompileLayer that emits both tiers through BaseLayer.
+  TieredCompileLayer(ExecutionSession &ES, IRLayer &BaseLayer,
+                     IndirectStubsManagerBuilder BuildIndirectStubsManager,
+                     unsigned NumOptimizeThreads = 1)
+      : TieredCompileLayer(ES, BaseLayer, BaseLayer,
+                           std::move(BuildIndirectStubsManager),
+                           NumOptimizeThreads) {}
+
+  /// Destruct this layer. Waits for any pending tier-ups to complete.
+  ~TieredCompileLayer();
+
+  /// Set the transform to apply to hot functions before they are recompiled.
+  /// Until an optimize transform is set this layer passes modules through to
+  /// the optimized layer unchanged.
+  void setOptimizeTransform(IRTransformLayer2::TransformFunction Optimize);
+
+  /// Set the tier-up policy. Only applies to modules emitted after the call.
+  void setTierUpPolicy(TierUpPolicy Policy);
+
+  /// Returns a policy that tiers up every function after Threshold calls.
+  static TierUpPolicy callCountThreshold(uint64_t Threshold);
+
+  /// Returns the tier state of the function whose (mangled) symbol name is
+  /// Name in V, or None if no such function has been tiered by this layer.
+  Optional<FunctionTierState> getTierState(const VSO &V,
+                                           const SymbolStringPtr &Name);
+
+  /// Returns the tier state of every function tiered by this layer in V.
+  std::vector<std::pair<SymbolStringPtr, FunctionTierState>>
+  getTierStates(const VSO &V);
+
+  /// Recompile the function whose (mangled) symbol name is Name in V with the
+  /// optimizing tier now, regardless of its call count. Blocks until the stub
+  /// has been repointed (or an error occurs). This is a no-op for functions
+  /// that have already tiered up or are tiering up in the background.
+  Error tierUp(VSO &V, const SymbolStringPtr &Name);
+
+  /// Block until all background tier-ups requested so far have completed.
+  void waitForPendingTierUps();
+
+  void emit(MaterializationResponsibility R, VModuleKey K,
+            ThreadSafeModule TSM) override;
+
+private:
+  struct TieredFunction {
+    TieredFunction(TieredCompileLayer &Parent, VSO &V, SymbolStringPtr Name,
+                   std::string IRName, JITSymbolFlags Flags,
+                   std::shared_ptr<ThreadSafeModule> Pristine)
+        : Parent(Parent), V(V), Name(std::move(Name)),
+          IRName(std::move(IRName)), Flags(Flags),
+          Pristine(std::move(Pristine)) {}
+
+    TieredCompileLayer &Parent;
+    VSO &V;
+    SymbolStringPtr Name;
+    std::string IRName;
+    JITSymbolFlags Flags;
+    std::shared_ptr<ThreadSafeModule> Pristine;
+    std::atomic<uint64_t> CallCount{0};
+    std::atomic<Tier> CurrentTier{Tier::Baseline};
+  };
+
+  using TieredFunctionKey = std::pair<const VSO *, SymbolStringPtr>;
+  using TieredFunctionsMap =
+      std::map<TieredFunctionKey, std::unique_ptr<TieredFunction>>;
+  using StubManagersMap =
+      std::map<const VSO *, std::unique_ptr<IndirectStubsManager>>;
+
+  /// Entry point called from instrumented baseline code.
+  static void requestTierUpFromJITCode(void *TF);
+
+  static void instrumentEntry(Function &F, TieredFunction &TF,
+                              uint64_t Threshold);
+
+  IndirectStubsManager &getStubsManager(const VSO &V);
+
+  void requestTierUp(TieredFunction &TF);
+
+  Error reoptimize(TieredFunction &TF);
+
+  mutable std::mutex TieredLayerMutex;
+
+  IRLayer &BaselineLayer;
+  IRLayer &OptimizedLayer;
+  IndirectStubsManagerBuilder BuildIndirectStubsManager;
+  IRTransformLayer2::TransformFunction Optimize;
+  TierUpPolicy Policy = callCountThreshold(1000);
+  StubManagersMap StubsMgrs;
+  TieredFunctionsMap TieredFunctions;
+  unsigned NumOptimizeThreads;
+  std::unique_ptr<ThreadPool> OptimizeThreads;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_TIEREDCOMPILELAYER_H
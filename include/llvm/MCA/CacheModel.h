@@ -0,0 +1,150 @@
+//===------------------------- CacheModel.h ---------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// An optional model of the data cache hierarchy.
+///
+/// By default, every load is assumed to hit the L1 cache, and its latency is
+/// the one from the scheduling model. When a CacheModel is attached to the
+/// pipeline, the address of each memory operation is looked up in a set of
+/// set-associative LRU caches, and loads that miss the L1 cache take longer
+/// to execute.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MCA_CACHEMODEL_H
+#define LLVM_MCA_CACHEMODEL_H
+
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/MCA/HardwareUnit.h"
+#include "llvm/MCA/Instruction.h"
+#include <vector>
+
+namespace mca {
+
+/// Parameters of one level of the data cache hierarchy.
+struct CacheLevelDesc {
+  // Capacity in bytes.
+  unsigned Size;
+  // Number of ways per set. Zero means fully associative.
+  unsigned Associativity;
+  // Load-to-use latency of a hit in this level.
+  unsigned Latency;
+};
+
+/// Parameters of the data cache hierarchy.
+struct MemoryHierarchyDesc {
+  // Cache levels, starting from the L1.
+  llvm::SmallVector<CacheLevelDesc, 3> Levels;
+  // Size of a cache line in bytes, shared by all the levels. This must be a
+  // power of two.
+  unsigned LineSize = 64;
+  // Load-to-use latency of an access that misses every cache level.
+  unsigned MemoryLatency = 200;
+  // Number of consecutive lines fetched by the next-line prefetcher on an L1
+  // miss. Zero disables the prefetcher.
+  unsigned PrefetchDegree = 0;
+};
+
+/// The addresses accessed by the memory operations of a code sequence.
+///
+/// Addresses are given per instruction of the sequence, either as a linear
+/// stream (a base address, advanced by a stride on every iteration), or as an
+/// explicit list of addresses that is cycled through across iterations. An
+/// explicit list takes precedence over a linear stream.
+class AddressStreams {
+  struct Stream {
+    llvm::Optional<uint64_t> Base;
+    int64_t Stride = 0;
+    std::vector<uint64_t> Trace;
+  };
+  std::vector<Stream> Streams;
+
+  Stream &getOrCreateStream(unsigned Index) {
+    if (Index >= Streams.size())
+      Streams.resize(Index + 1);
+    return Streams[Index];
+  }
+
+public:
+  void setLinearStream(unsigned Index, uint64_t Base, int64_t Stride) {
+    Stream &S = getOrCreateStream(Index);
+    S.Base = Base;
+    S.Stride = Stride;
+  }
+
+  void appendTraceAddress(unsigned Index, uint64_t Address) {
+    getOrCreateStream(Index).Trace.push_back(Address);
+  }
+
+  /// Returns the address accessed by the dynamic instruction at SourceIndex,
+  /// in a sequence of NumInstructions instructions. Returns None if no
+  /// address is known for that instruction.
+  llvm::Optional<uint64_t> getAddress(unsigned SourceIndex,
+                                      unsigned NumInstructions) const;
+};
+
+/// The outcome of a memory access.
+struct CacheAccess {
+  uint64_t Address;
+  bool IsStore;
+  // Index of the cache level that serviced the access. Main memory is
+  // represented by the number of cache levels.
+  unsigned Level;
+  // Number of cycles in addition to the latency of an L1 hit. This is always
+  // zero for stores, since stores retire into the store buffer.
+  unsigned StallCycles;
+};
+
+class CacheModel : public HardwareUnit {
+  /// A set-associative cache with LRU replacement. Lines are identified by
+  /// their address divided by the line size.
+  class CacheLevel {
+    unsigned NumSets;
+    unsigned NumWays;
+    // Tag and last use time of each way. A zero time marks an empty way.
+    std::vector<std::pair<uint64_t, uint64_t>> Ways;
+
+  public:
+    CacheLevel(const CacheLevelDesc &Desc, unsigned LineSize);
+
+    // Returns true on a hit, and marks the line as most recently used.
+    bool lookup(uint64_t Line, uint64_t Now);
+    // Inserts a line that missed, evicting the least recently used line of
+    // its set if necessary.
+    void insert(uint64_t Line, uint64_t Now);
+  };
+
+  const MemoryHierarchyDesc &Desc;
+  const AddressStreams &Addresses;
+  const unsigned NumInstructions;
+  std::vector<CacheLevel> Levels;
+  unsigned LineShift;
+  // Logical clock used to order line accesses for the LRU policy.
+  uint64_t Now;
+
+  // Returns the index of the level that holds Line, or the number of levels
+  // if Line is only in memory. Line is filled into all the levels above it.
+  unsigned accessLine(uint64_t Line);
+
+public:
+  CacheModel(const MemoryHierarchyDesc &Desc, const AddressStreams &Addresses,
+             unsigned NumInstructions);
+
+  unsigned getNumLevels() const { return Levels.size(); }
+
+  /// Simulate the memory access performed by IR. Returns None if IR doesn't
+  /// access memory, or if its address is not known.
+  llvm::Optional<CacheAccess> access(const InstRef &IR);
+};
+
+} // namespace mca
+
+#endif // LLVM_MCA_CACHEMODEL_H
@@ -15,15 +15,16 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#ifndef LLVM_TOOLS_LLVM_MCA_CONTEXT_H
-#define LLVM_TOOLS_LLVM_MCA_CONTEXT_H
-#include "HardwareUnit.h"
-#include "InstrBuilder.h"
-#include "Pipeline.h"
-#include "SourceMgr.h"
+#ifndef LLVM_MCA_CONTEXT_H
+#define LLVM_MCA_CONTEXT_H
 #include "llvm/MC/MCRegisterInfo.h"
 #include "llvm/MC/MCSchedule.h"
 #include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/MCA/CacheModel.h"
+#include "llvm/MCA/HardwareUnit.h"
+#include "llvm/MCA/InstrBuilder.h"
+#include "llvm/MCA/Pipeline.h"
+#include "llvm/MCA/SourceMgr.h"
 #include <memory>
 
 namespace mca {
@@ -40,6 +41,10 @@ struct PipelineOptions {
   unsigned LoadQueueSize;
   unsigned StoreQueueSize;
   bool AssumeNoAlias;
+  // If set, memory operations are simulated against this cache hierarchy,
+  // using the addresses from MemoryAddresses. Both must outlive the pipeline.
+  const MemoryHierarchyDesc *MemoryHierarchy = nullptr;
+  const AddressStreams *MemoryAddresses = nullptr;
 };
 
 class Context {
@@ -65,4 +70,4 @@ public:
 };
 
 } // namespace mca
-#endif // LLVM_TOOLS_LLVM_MCA_CONTEXT_H
+#endif // LLVM_MCA_CONTEXT_H
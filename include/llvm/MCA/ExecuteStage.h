@@ -15,14 +15,15 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#ifndef LLVM_TOOLS_LLVM_MCA_EXECUTE_STAGE_H
-#define LLVM_TOOLS_LLVM_MCA_EXECUTE_STAGE_H
+#ifndef LLVM_MCA_EXECUTE_STAGE_H
+#define LLVM_MCA_EXECUTE_STAGE_H
 
-#include "Instruction.h"
-#include "RetireControlUnit.h"
-#include "Scheduler.h"
-#include "Stage.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/MCA/CacheModel.h"
+#include "llvm/MCA/Instruction.h"
+#include "llvm/MCA/RetireControlUnit.h"
+#include "llvm/MCA/Scheduler.h"
+#include "llvm/MCA/Stage.h"
 
 namespace mca {
 
@@ -30,14 +31,21 @@ class ExecuteStage : public Stage {
   // Owner will go away when we move listeners/eventing to the stages.
   RetireControlUnit &RCU;
   Scheduler &HWS;
+  // Optional model of the data caches.
+  CacheModel *Caches;
 
   // The following routines are used to maintain the HWS.
   void reclaimSchedulerResources();
   void updateSchedulerQueues();
   void issueReadyInstructions();
 
+  // Look up the address accessed by IR in the cache model, and update the
+  // latency of IR accordingly. This must be done before IR is issued.
+  void simulateMemoryAccess(InstRef &IR);
+
 public:
-  ExecuteStage(RetireControlUnit &R, Scheduler &S) : Stage(), RCU(R), HWS(S) {}
+  ExecuteStage(RetireControlUnit &R, Scheduler &S, CacheModel *C = nullptr)
+      : Stage(), RCU(R), HWS(S), Caches(C) {}
   ExecuteStage(const ExecuteStage &Other) = delete;
   ExecuteStage &operator=(const ExecuteStage &Other) = delete;
 
@@ -64,4 +72,4 @@ public:
 
 } // namespace mca
 
-#endif // LLVM_TOOLS_LLVM_MCA_EXECUTE_STAGE_H
+#endif // LLVM_MCA_EXECUTE_STAGE_H
@@ -13,12 +13,12 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#ifndef LLVM_TOOLS_LLVM_MCA_FETCH_STAGE_H
-#define LLVM_TOOLS_LLVM_MCA_FETCH_STAGE_H
+#ifndef LLVM_MCA_FETCH_STAGE_H
+#define LLVM_MCA_FETCH_STAGE_H
 
-#include "InstrBuilder.h"
-#include "SourceMgr.h"
-#include "Stage.h"
+#include "llvm/MCA/InstrBuilder.h"
+#include "llvm/MCA/SourceMgr.h"
+#include "llvm/MCA/Stage.h"
 #include <map>
 
 namespace mca {
@@ -42,4 +42,4 @@ public:
 
 } // namespace mca
 
-#endif // LLVM_TOOLS_LLVM_MCA_FETCH_STAGE_H
+#endif // LLVM_MCA_FETCH_STAGE_H
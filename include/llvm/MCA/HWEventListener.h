@@ -12,11 +12,12 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#ifndef LLVM_TOOLS_LLVM_MCA_HWEVENTLISTENER_H
-#define LLVM_TOOLS_LLVM_MCA_HWEVENTLISTENER_H
+#ifndef LLVM_MCA_HWEVENTLISTENER_H
+#define LLVM_MCA_HWEVENTLISTENER_H
 
-#include "Instruction.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/MCA/CacheModel.h"
+#include "llvm/MCA/Instruction.h"
 #include <utility>
 
 namespace mca {
@@ -44,6 +45,8 @@ public:
     Executed,
     // Events generated by the Dispatch logic.
     Dispatched,
+    // Events generated by the cache model, before an instruction is issued.
+    MemoryAccess,
 
     LastGenericEventType,
   };
@@ -88,6 +91,14 @@ public:
   llvm::ArrayRef<unsigned> FreedPhysRegs;
 };
 
+class HWMemoryAccessEvent : public HWInstructionEvent {
+public:
+  HWMemoryAccessEvent(const InstRef &IR, const CacheAccess &A)
+      : HWInstructionEvent(HWInstructionEvent::MemoryAccess, IR), Access(A) {}
+  // The address accessed, and the cache level that serviced the access.
+  const CacheAccess &Access;
+};
+
 // A HWStallEvent represents a pipeline stall caused by the lack of hardware
 // resources.
 class HWStallEvent {
@@ -13,8 +13,8 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#ifndef LLVM_TOOLS_LLVM_MCA_INSTRUCTION_H
-#define LLVM_TOOLS_LLVM_MCA_INSTRUCTION_H
+#ifndef LLVM_MCA_INSTRUCTION_H
+#define LLVM_MCA_INSTRUCTION_H
 
 #include "llvm/Support/MathExtras.h"
 
@@ -137,7 +137,9 @@ public:
 
   // On every cycle, update CyclesLeft and notify dependent users.
   void cycleEvent();
-  void onInstructionIssued();
+  // ExtraLatency is added to the latency from the write descriptor. It is
+  // used to model loads that miss the L1 cache.
+  void onInstructionIssued(unsigned ExtraLatency);
 
 #ifndef NDEBUG
   void dump() const;
@@ -300,6 +302,11 @@ class Instruction {
   // Retire Unit token ID for this instruction.
   unsigned RCUTokenID;
 
+  // Number of cycles spent waiting for the memory hierarchy, in addition to
+  // the latency from the scheduling model. This is only set by the cache
+  // model, for loads that miss the L1 cache.
+  unsigned MemoryStallCycles;
+
   bool IsDepBreaking;
 
   using UniqueDef = std::unique_ptr<WriteState>;
@@ -318,7 +325,7 @@ class Instruction {
 public:
   Instruction(const InstrDesc &D)
       : Desc(D), Stage(IS_INVALID), CyclesLeft(UNKNOWN_CYCLES), RCUTokenID(0),
-        IsDepBreaking(false) {}
+        MemoryStallCycles(0), IsDepBreaking(false) {}
   Instruction(const Instruction &Other) = delete;
   Instruction &operator=(const Instruction &Other) = delete;
 
@@ -329,6 +336,8 @@ public:
   const InstrDesc &getDesc() const { return Desc; }
   unsigned getRCUTokenID() const { return RCUTokenID; }
   int getCyclesLeft() const { return CyclesLeft; }
+  unsigned getMemoryStallCycles() const { return MemoryStallCycles; }
+  void setMemoryStallCycles(unsigned Cycles) { MemoryStallCycles = Cycles; }
 
   bool isDependencyBreaking() const { return IsDepBreaking; }
   void setDependencyBreaking() { IsDepBreaking = true; }
@@ -13,12 +13,12 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#ifndef LLVM_TOOLS_LLVM_MCA_PIPELINE_H
-#define LLVM_TOOLS_LLVM_MCA_PIPELINE_H
+#ifndef LLVM_MCA_PIPELINE_H
+#define LLVM_MCA_PIPELINE_H
 
-#include "Scheduler.h"
-#include "Stage.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/MCA/Scheduler.h"
+#include "llvm/MCA/Stage.h"
 
 namespace mca {
 
@@ -76,4 +76,4 @@ public:
 };
 } // namespace mca
 
-#endif // LLVM_TOOLS_LLVM_MCA_PIPELINE_H
+#endif // LLVM_MCA_PIPELINE_H
@@ -0,0 +1,83 @@
+//===---------------------------- Simulator.h -------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// A programmatic interface to the default out-of-order pipeline: feed in a
+/// sequence of MCInsts, get back the number of cycles taken and the pressure
+/// on each processor resource.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MCA_SIMULATOR_H
+#define LLVM_MCA_SIMULATOR_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/MC/MCInst.h"
+#include "llvm/MCA/Context.h"
+#include "llvm/MCA/InstrBuilder.h"
+#include <vector>
+
+namespace mca {
+
+/// Statistics collected by a Simulator run.
+struct SimulationResult {
+  /// Number of times the instruction sequence was executed.
+  unsigned Iterations = 0;
+
+  /// Number of instructions and micro opcodes dispatched, over all iterations.
+  unsigned TotalInstructions = 0;
+  unsigned TotalUOps = 0;
+
+  /// Number of cycles taken to retire every instruction.
+  unsigned TotalCycles = 0;
+
+  /// Average number of cycles per iteration that each processor resource unit
+  /// was busy. There is one entry per unit of every processor resource that
+  /// is not a group, in scheduling model order (i.e. the columns of the
+  /// resource pressure view).
+  std::vector<double> ResourcePressure;
+
+  double getIPC() const {
+    return TotalCycles ? (double)TotalInstructions / TotalCycles : 0.0;
+  }
+
+  double getCyclesPerIteration() const {
+    return Iterations ? (double)TotalCycles / Iterations : 0.0;
+  }
+};
+
+/// Simulates instruction sequences on the default out-of-order pipeline of a
+/// subtarget.
+///
+/// A Simulator caches instruction descriptors across runs, so it is cheaper to
+/// reuse one than to create one per sequence. A Simulator must only be used by
+/// one thread at a time, but Simulators sharing the same MC layer objects may
+/// run concurrently on different threads.
+class Simulator {
+  const llvm::MCSubtargetInfo &STI;
+  const llvm::MCRegisterInfo &MRI;
+  InstrBuilder IB;
+  PipelineOptions Opts;
+
+public:
+  /// A dispatch width of zero in Opts selects the issue width of the
+  /// scheduling model. MCIP is only used to print diagnostics.
+  Simulator(const llvm::MCSubtargetInfo &STI, const llvm::MCInstrInfo &MCII,
+            const llvm::MCRegisterInfo &MRI,
+            const llvm::MCInstrAnalysis &MCIA, llvm::MCInstPrinter &MCIP,
+            const PipelineOptions &Opts);
+
+  /// Simulate Iterations executions of Insts (100 if Iterations is zero).
+  SimulationResult run(llvm::ArrayRef<llvm::MCInst> Insts,
+                       unsigned Iterations);
+};
+
+} // namespace mca
+
+#endif // LLVM_MCA_SIMULATOR_H
@@ -76,6 +76,9 @@ protected:
   AssumptionCacheTracker *ACT;
   ProfileSummaryInfo *PSI;
   ImportedFunctionsInliningStatistics ImportedFunctionsStats;
+
+  /// The summaries of the callees analyzed so far, to pass to getInlineCost().
+  InlineCostSummaryCache CalleeSummaries;
 };
 
 /// The inliner pass for the new pass manager.
@@ -107,6 +110,7 @@ public:
 private:
   InlineParams Params;
   std::unique_ptr<ImportedFunctionsInliningStatistics> ImportedFunctionsStats;
+  InlineCostSummaryCache CalleeSummaries;
 };
 
 } // end namespace llvm
@@ -160,6 +160,12 @@ Pass *createLoopPredicationPass();
 //
 Pass *createLoopInterchangePass();
 
+//===----------------------------------------------------------------------===//
+//
+// LoopTile - This pass tiles perfect loop nests for cache reuse.
+//
+Pass *createLoopTilePass();
+
 //===----------------------------------------------------------------------===//
 //
 // LoopStrengthReduce - This pass is strength reduces GEP instructions that use
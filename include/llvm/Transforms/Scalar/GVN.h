@@ -46,6 +46,10 @@ class FunctionPass;
 class IntrinsicInst;
 class LoadInst;
 class LoopInfo;
+class MemoryAccess;
+class MemoryLocation;
+class MemorySSA;
+class MemorySSAUpdater;
 class OptimizationRemarkEmitter;
 class PHINode;
 class TargetLibraryInfo;
@@ -81,7 +85,7 @@ public:
 
   DominatorTree &getDominatorTree() const { return *DT; }
   AliasAnalysis *getAliasAnalysis() const { return VN.getAliasAnalysis(); }
-  MemoryDependenceResults &getMemDep() const { return *MD; }
+  MemoryDependenceResults *getMemDep() const { return MD; }
 
   /// This class holds the mapping between values and value numbers.  It is used
   /// as an efficient mechanism to determine the expression-wise equivalence of
@@ -109,8 +113,13 @@ public:
 
     AliasAnalysis *AA;
     MemoryDependenceResults *MD;
+    MemorySSA *MSSA = nullptr;
     DominatorTree *DT;
 
+    // Value numbers of the memory states read by readonly calls, by the ID of
+    // the MemorySSA access that clobbers them. Used when MD is not.
+    DenseMap<unsigned, uint32_t> memoryStateNumbering;
+
     uint32_t nextValueNumber = 1;
 
     Expression createExpr(Instruction *I);
@@ -143,6 +152,7 @@ public:
     void setAliasAnalysis(AliasAnalysis *A) { AA = A; }
     AliasAnalysis *getAliasAnalysis() const { return AA; }
     void setMemDep(MemoryDependenceResults *M) { MD = M; }
+    void setMemorySSA(MemorySSA *M) { MSSA = M; }
     void setDomTree(DominatorTree *D) { DT = D; }
     uint32_t getNextUnusedValueNumber() { return nextValueNumber; }
     void verifyRemoved(const Value *) const;
@@ -153,6 +163,9 @@ private:
   friend struct DenseMapInfo<Expression>;
 
   MemoryDependenceResults *MD;
+  // MemorySSA and its updater, used instead of MD with -gvn-memoryssa.
+  MemorySSA *MSSA = nullptr;
+  MemorySSAUpdater *MSSAU = nullptr;
   DominatorTree *DT;
   const TargetLibraryInfo *TLI;
   AssumptionCache *AC;
@@ -191,8 +204,8 @@ private:
 
   bool runImpl(Function &F, AssumptionCache &RunAC, DominatorTree &RunDT,
                const TargetLibraryInfo &RunTLI, AAResults &RunAA,
-               MemoryDependenceResults *RunMD, LoopInfo *LI,
-               OptimizationRemarkEmitter *ORE);
+               MemoryDependenceResults *RunMD, bool UseMemorySSA,
+               LoopInfo *LI, OptimizationRemarkEmitter *ORE);
 
   /// Push a new Value to the LeaderTable onto the list for its value number.
   void addToLeaderTable(uint32_t N, Value *V, const BasicBlock *BB) {
@@ -247,6 +260,15 @@ private:
   bool processNonLocalLoad(LoadInst *L);
   bool processAssumeIntrinsic(IntrinsicInst *II);
 
+  // Dependence queries for loads answered with MemorySSA. They return the
+  // same kind of results as the MemoryDependenceResults queries they replace.
+  MemDepResult getDependencyMSSA(LoadInst *L);
+  void getNonLocalDependenciesMSSA(LoadInst *L, LoadDepVect &Deps);
+  MemDepResult getBlockDependencyMSSA(const MemoryLocation &Loc,
+                                      BasicBlock *BB, Instruction *ScanFrom,
+                                      MemoryAccess *&Acc);
+  MemoryAccess *getLiveOutAccess(BasicBlock *BB) const;
+
   /// Given a local dependency (Def or Clobber) determine if a value is
   /// available for the load.  Returns true if an value is known to be
   /// available and populates Res.  Returns false otherwise.
@@ -70,11 +70,15 @@ public:
   GlobalNumberState() = default;
 
   uint64_t getNumber(GlobalValue* Global) {
-    ValueNumberMap::iterator MapIter;
-    bool Inserted;
-    std::tie(MapIter, Inserted) = GlobalNumbers.insert({Global, NextNumber});
-    if (Inserted)
-      NextNumber++;
+    // Look the global up first: inserting creates a value handle, even if the
+    // global already has a number. Once every global has been numbered,
+    // getNumber() doesn't modify any state and may be called from several
+    // threads.
+    ValueNumberMap::iterator MapIter = GlobalNumbers.find(Global);
+    if (MapIter != GlobalNumbers.end())
+      return MapIter->second;
+    MapIter = GlobalNumbers.insert({Global, NextNumber}).first;
+    NextNumber++;
     return MapIter->second;
   }
 
@@ -105,6 +109,15 @@ public:
   using FunctionHash = uint64_t;
   static FunctionHash functionHash(Function &);
 
+  /// Hash a function like functionHash, but also take into account the
+  /// signature, the types of instructions and of their operands, and the
+  /// values of integer and floating point constants. Equivalent functions have
+  /// the same fingerprint. Global values and other constants are not hashed,
+  /// so replacing a call target doesn't change the fingerprint.
+  ///
+  /// Only reads the IR, so fingerprints can be computed in parallel.
+  static FunctionHash functionFingerprint(Function &);
+
 protected:
   /// Start the comparison.
   void beginCompare() {
@@ -119,6 +119,8 @@ bool DivergenceAnalysis::updateTerminator(const TerminatorInst &term) const {
     return isDivergent(*branchInst->getCondition());
   } else if (auto *switchInst = dyn_cast<SwitchInst>(&term)) {
     return isDivergent(*switchInst->getCondition());
+  } else if (auto *indirectBr = dyn_cast<IndirectBrInst>(&term)) {
+    return isDivergent(*indirectBr->getAddress());
   } else if (isa<InvokeInst>(term)) {
     return false; // ignore abnormal executions through landingpad
   } else {
@@ -174,8 +176,11 @@ void DivergenceAnalysis::taintLoopLiveOuts(const BasicBlock &loopHeader) {
     auto *userBlock = taintStack.back();
     taintStack.pop_back();
 
-    assert(!divLoop->contains(userBlock) &&
-           "irreducible control flow detected");
+    // re-entering divLoop through irreducible control flow: the values of
+    // divLoop are then live-out of an irreducible cycle containing it, which
+    // taintCycleLiveOuts handles
+    if (divLoop->contains(userBlock))
+      continue;
 
     // phi nodes at the fringes of the dominance region
     if (!DT.dominates(&loopHeader, userBlock)) {
@@ -210,13 +215,32 @@ void DivergenceAnalysis::taintLoopLiveOuts(const BasicBlock &loopHeader) {
 
     // visit all blocks in the dominance region
     for (auto *succBlock : successors(userBlock)) {
-      if (!visited.insert(userBlock).second)
+      if (!visited.insert(succBlock).second)
         continue;
       taintStack.push_back(succBlock);
     }
   }
 }
 
+// marks all users outside of @cycle of values defined in it as divergent
+void DivergenceAnalysis::taintCycleLiveOuts(
+    const BranchDependenceAnalysis::IrreducibleCycle &cycle) {
+  for (const auto *block : cycle.blocks) {
+    for (const auto &I : *block) {
+      for (const auto *user : I.users()) {
+        const auto *userInst = dyn_cast<Instruction>(user);
+        if (!userInst || cycle.blocks.count(userInst->getParent()) ||
+            !inRegion(*userInst))
+          continue;
+        if (isAlwaysUniform(*userInst) || isDivergent(*userInst))
+          continue;
+        markDivergent(*userInst);
+        pushUsers(*userInst);
+      }
+    }
+  }
+}
+
 void DivergenceAnalysis::pushUsers(const Instruction &I) {
   for (const auto *user : I.users()) {
     const auto *userInst = dyn_cast<const Instruction>(user);
@@ -279,6 +303,16 @@ void DivergenceAnalysis::compute(bool IsLCSSA) {
               worklist.push_back(&blockInst);
             }
 
+          } else if (!branchLoop || branchLoop->contains(joinBlock)) {
+            // a join inside a loop nested in branchLoop, e.g. in the blocks of
+            // an irreducible cycle
+            markBlockJoinDivergent(*joinBlock);
+            for (auto &blockInst : *joinBlock) {
+              if (!isa<PHINode>(blockInst))
+                break;
+              worklist.push_back(&blockInst);
+            }
+
           } else {
             // users of values carried by (branchLoop) outside the loop become
             // divergent these users have to be dominated by the header of
@@ -288,6 +322,11 @@ void DivergenceAnalysis::compute(bool IsLCSSA) {
             taintLoopLiveOuts(*branchLoop->getHeader());
           }
         }
+
+        // the threads may leave the irreducible cycles in different
+        // iterations
+        for (const auto *cycle : BDA.divergent_cycles(*term.getParent()))
+          taintCycleLiveOuts(*cycle);
         continue;
       }
     }
@@ -316,6 +355,11 @@ bool DivergenceAnalysis::isDivergent(const Value &val) const {
   return divergentValues.count(&val);
 }
 
+void DivergenceAnalysis::removeValue(const Value &val) {
+  divergentValues.erase(&val);
+  uniformOverrides.erase(&val);
+}
+
 void DivergenceAnalysis::print(raw_ostream &OS, const Module *) const {
   if (divergentValues.empty())
     return;
@@ -43,6 +43,11 @@ using namespace llvm;
 #define DEBUG_TYPE "inline-cost"
 
 STATISTIC(NumCallsAnalyzed, "Number of call sites analyzed");
+STATISTIC(NumCalleeSummariesComputed, "Number of callee summaries computed");
+STATISTIC(NumCalleeSummaryHits,
+          "Number of call sites analyzed with a cached callee summary");
+STATISTIC(NumCalleeSummaryMisses,
+          "Number of call sites whose arguments prevent using a summary");
 
 static cl::opt<int> InlineThreshold(
     "inline-threshold", cl::Hidden, cl::init(225), cl::ZeroOrMore,
@@ -85,6 +90,11 @@ static cl::opt<int> HotCallSiteRelFreq(
              "entry frequency, for a callsite to be hot in the absence of "
              "profile information."));
 
+static cl::opt<bool> EnableCalleeSummaries(
+    "inline-cost-callee-summaries", cl::Hidden, cl::init(true),
+    cl::desc("Reuse the cost of a callee across the call sites whose arguments "
+             "don't enable any simplification"));
+
 static cl::opt<bool> OptComputeFullInlineCost(
     "inline-cost-full", cl::Hidden, cl::init(false),
     cl::desc("Compute the full inline cost of a call site even when the cost "
@@ -125,6 +135,9 @@ class CallAnalyzer : public InstVisitor<CallAnalyzer, bool> {
   /// Tunable parameters that control the analysis.
   const InlineParams &Params;
 
+  /// The callee summaries to reuse and fill, if any.
+  InlineCostSummaryCache *Summaries;
+
   int Threshold;
   int Cost;
   bool ComputeFullInlineCost;
@@ -229,6 +242,13 @@ class CallAnalyzer : public InstVisitor<CallAnalyzer, bool> {
   // Custom analysis routines.
   InlineResult analyzeBlock(BasicBlock *BB,
                             SmallPtrSetImpl<const Value *> &EphValues);
+  InlineResult analyzeBody(SmallPtrSetImpl<const Value *> &EphValues,
+                           bool &SingleBB);
+  InlineResult finishAnalysis(CallSite CS);
+
+  /// Return true if the arguments of the call site enable no simplification
+  /// that a callee summary doesn't account for.
+  bool canUseSummary();
 
   // Disable several entry points to the visitor so we don't accidentally use
   // them by declaring but not defining them here.
@@ -274,10 +294,12 @@ public:
                std::function<AssumptionCache &(Function &)> &GetAssumptionCache,
                Optional<function_ref<BlockFrequencyInfo &(Function &)>> &GetBFI,
                ProfileSummaryInfo *PSI, OptimizationRemarkEmitter *ORE,
-               Function &Callee, CallSite CSArg, const InlineParams &Params)
+               Function &Callee, CallSite CSArg, const InlineParams &Params,
+               InlineCostSummaryCache *Summaries = nullptr)
       : TTI(TTI), GetAssumptionCache(GetAssumptionCache), GetBFI(GetBFI),
         PSI(PSI), F(Callee), DL(F.getParent()->getDataLayout()), ORE(ORE),
-        CandidateCS(CSArg), Params(Params), Threshold(Params.DefaultThreshold),
+        CandidateCS(CSArg), Params(Params), Summaries(Summaries),
+        Threshold(Params.DefaultThreshold),
         Cost(0), ComputeFullInlineCost(OptComputeFullInlineCost ||
                                        Params.ComputeFullInlineCost || ORE),
         IsCallerRecursive(false), IsRecursiveCall(false),
@@ -293,6 +315,10 @@ public:
 
   InlineResult analyzeCall(CallSite CS);
 
+  /// Analyze the whole body of the callee as if nothing was known about its
+  /// arguments, for any call site.
+  void summarizeCallee(CalleeInlineSummary &Summary);
+
   int getThreshold() { return Threshold; }
   int getCost() { return Cost; }
 
@@ -741,6 +767,9 @@ bool CallAnalyzer::visitUnaryInstruction(UnaryInstruction &I) {
 }
 
 bool CallAnalyzer::paramHasAttr(Argument *A, Attribute::AttrKind Attr) {
+  // When summarizing the callee, there is no call site.
+  if (!CandidateCS)
+    return F.hasParamAttribute(A->getArgNo(), Attr);
   return CandidateCS.paramHasAttr(A->getArgNo(), Attr);
 }
 
@@ -1787,12 +1816,114 @@ InlineResult CallAnalyzer::analyzeCall(CallSite CS) {
   NumConstantOffsetPtrArgs = ConstantOffsetPtrs.size();
   NumAllocaArgs = SROAArgValues.size();
 
-  // FIXME: If a caller has multiple calls to a callee, we end up recomputing
-  // the ephemeral values multiple times (and they're completely determined by
-  // the callee, so this is purely duplicate work).
+  // The body of the callee costs the same at every call site whose arguments
+  // don't enable any simplification, so it is only analyzed once for them.
+  CalleeInlineSummary *Summary = nullptr;
+  if (Summaries && EnableCalleeSummaries) {
+    Summary = Summaries->lookup(F);
+    if (canUseSummary()) {
+      if (Summary) {
+        ++NumCalleeSummaryHits;
+      } else {
+        Summary = &Summaries->getOrCreate(F);
+        CallAnalyzer CA(TTI, GetAssumptionCache, GetBFI, PSI, /*ORE=*/nullptr,
+                        F, CallSite(), Params);
+        CA.summarizeCallee(*Summary);
+      }
+      // The analysis of the body stops early for recursive callers when the
+      // callee allocates too much stack space.
+      if (Summary->IsValid &&
+          (!IsCallerRecursive ||
+           Summary->AllocatedSize <=
+               InlineConstants::TotalAllocaSizeRecursiveCaller)) {
+        Cost += Summary->Cost;
+        AllocatedSize = Summary->AllocatedSize;
+        NumInstructions = Summary->NumInstructions;
+        NumVectorInstructions = Summary->NumVectorInstructions;
+        NumInstructionsSimplified = Summary->NumInstructionsSimplified;
+        NumConstantPtrCmps = Summary->NumConstantPtrCmps;
+        NumConstantPtrDiffs = Summary->NumConstantPtrDiffs;
+        ContainsNoDuplicateCall = Summary->ContainsNoDuplicateCall;
+        if (!Summary->SingleBB)
+          Threshold -= SingleBBBonus;
+        return finishAnalysis(CS);
+      }
+    } else {
+      ++NumCalleeSummaryMisses;
+    }
+  }
+
+  // The ephemeral values are completely determined by the callee, so reuse
+  // them from its summary if there is one.
   SmallPtrSet<const Value *, 32> EphValues;
-  CodeMetrics::collectEphemeralValues(&F, &GetAssumptionCache(F), EphValues);
+  if (!Summary)
+    CodeMetrics::collectEphemeralValues(&F, &GetAssumptionCache(F), EphValues);
+
+  bool SingleBB = true;
+  InlineResult IR =
+      analyzeBody(Summary ? Summary->EphValues : EphValues, SingleBB);
+  if (!IR)
+    return IR;
+  return finishAnalysis(CS);
+}
 
+/// Test whether the arguments of the call site, mapped by analyzeCall(), only
+/// enable simplifications that summarizeCallee() also finds.
+bool CallAnalyzer::canUseSummary() {
+  // Constant arguments and arguments pointing into the caller's allocas
+  // simplify the callee.
+  if (!SimplifiedValues.empty() || !SROAArgValues.empty())
+    return false;
+
+  SmallPtrSet<Value *, 8> Bases;
+  for (Argument &A : F.args()) {
+    if (!A.getType()->isPointerTy())
+      continue;
+    // The summary tracks every pointer argument relative to itself, so
+    // comparisons only fold between pointers derived from the same argument.
+    auto It = ConstantOffsetPtrs.find(&A);
+    if (It == ConstantOffsetPtrs.end() || !It->second.second.isNullValue() ||
+        !Bases.insert(It->second.first).second)
+      return false;
+    // Comparisons with null fold for arguments known to be non-null.
+    if (paramHasAttr(&A, Attribute::NonNull) &&
+        !F.hasParamAttribute(A.getArgNo(), Attribute::NonNull))
+      return false;
+  }
+  return true;
+}
+
+void CallAnalyzer::summarizeCallee(CalleeInlineSummary &Summary) {
+  ++NumCalleeSummariesComputed;
+  ComputeFullInlineCost = true;
+
+  for (Argument &A : F.args())
+    if (A.getType()->isPointerTy()) {
+      unsigned AS = A.getType()->getPointerAddressSpace();
+      ConstantOffsetPtrs[&A] =
+          std::make_pair(&A, APInt::getNullValue(DL.getIndexSizeInBits(AS)));
+    }
+
+  CodeMetrics::collectEphemeralValues(&F, &GetAssumptionCache(F),
+                                      Summary.EphValues);
+  bool SingleBB = true;
+  Summary.IsValid = !F.empty() && analyzeBody(Summary.EphValues, SingleBB);
+  Summary.Cost = Cost;
+  Summary.SingleBB = SingleBB;
+  Summary.ContainsNoDuplicateCall = ContainsNoDuplicateCall;
+  Summary.AllocatedSize = AllocatedSize;
+  Summary.NumInstructions = NumInstructions;
+  Summary.NumVectorInstructions = NumVectorInstructions;
+  Summary.NumInstructionsSimplified = NumInstructionsSimplified;
+  Summary.NumConstantPtrCmps = NumConstantPtrCmps;
+  Summary.NumConstantPtrDiffs = NumConstantPtrDiffs;
+}
+
+/// Walk the basic blocks of the callee that are live at the call site, and
+/// accumulate their cost.
+InlineResult
+CallAnalyzer::analyzeBody(SmallPtrSetImpl<const Value *> &EphValues,
+                          bool &SingleBB) {
   // The worklist of live basic blocks in the callee *after* inlining. We avoid
   // adding basic blocks of the callee which can be proven to be dead for this
   // particular call site in order to get more accurate cost estimates. This
@@ -1805,7 +1936,6 @@ InlineResult CallAnalyzer::analyzeCall(CallSite CS) {
       BBSetVector;
   BBSetVector BBWorklist;
   BBWorklist.insert(&F.getEntryBlock());
-  bool SingleBB = true;
   // Note that we *must not* cache the size, this loop grows the worklist.
   for (unsigned Idx = 0; Idx != BBWorklist.size(); ++Idx) {
     // Bail out the moment we cross the threshold. This means we'll under-count
@@ -1877,6 +2007,11 @@ InlineResult CallAnalyzer::analyzeCall(CallSite CS) {
     }
   }
 
+  return true;
+}
+
+/// Make the final inlining decision once the cost of the body is known.
+InlineResult CallAnalyzer::finishAnalysis(CallSite CS) {
   bool OnlyOneCallAndLocalLinkage =
       F.hasLocalLinkage() && F.hasOneUse() && &F == CS.getCalledFunction();
   // If this is a noduplicate call, we can still inline as long as
@@ -1963,9 +2098,10 @@ InlineCost llvm::getInlineCost(
     CallSite CS, const InlineParams &Params, TargetTransformInfo &CalleeTTI,
     std::function<AssumptionCache &(Function &)> &GetAssumptionCache,
     Optional<function_ref<BlockFrequencyInfo &(Function &)>> GetBFI,
-    ProfileSummaryInfo *PSI, OptimizationRemarkEmitter *ORE) {
+    ProfileSummaryInfo *PSI, OptimizationRemarkEmitter *ORE,
+    InlineCostSummaryCache *Summaries) {
   return getInlineCost(CS, CS.getCalledFunction(), Params, CalleeTTI,
-                       GetAssumptionCache, GetBFI, PSI, ORE);
+                       GetAssumptionCache, GetBFI, PSI, ORE, Summaries);
 }
 
 InlineCost llvm::getInlineCost(
@@ -1973,7 +2109,8 @@ InlineCost llvm::getInlineCost(
     TargetTransformInfo &CalleeTTI,
     std::function<AssumptionCache &(Function &)> &GetAssumptionCache,
     Optional<function_ref<BlockFrequencyInfo &(Function &)>> GetBFI,
-    ProfileSummaryInfo *PSI, OptimizationRemarkEmitter *ORE) {
+    ProfileSummaryInfo *PSI, OptimizationRemarkEmitter *ORE,
+    InlineCostSummaryCache *Summaries) {
 
   // Cannot inline indirect calls.
   if (!Callee)
@@ -2032,7 +2169,7 @@ InlineCost llvm::getInlineCost(
                           << "... (caller:" << Caller->getName() << ")\n");
 
   CallAnalyzer CA(CalleeTTI, GetAssumptionCache, GetBFI, PSI, ORE, *Callee, CS,
-                  Params);
+                  Params, Summaries);
   InlineResult ShouldInline = CA.analyzeCall(CS);
 
   LLVM_DEBUG(CA.dump());
@@ -66,6 +66,9 @@
 
 #include "llvm/Analysis/DivergenceAnalysis.h"
 #include "llvm/Analysis/KernelDivergenceAnalysis.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/Passes.h"
 #include "llvm/Analysis/PostDominators.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
@@ -82,10 +85,23 @@ using namespace llvm;
 
 // Use the VPlan+RV DivergenceAnalysis
 static cl::opt<bool> UseRVDA(
-    "use-rv-da", cl::init(false), cl::Hidden,
+    "use-rv-da", cl::init(true), cl::Hidden,
     cl::desc(
         "Use the VPlan+RV DivergenceAnalysis to detect divergent values."));
 
+// Run both analyses and report the values they disagree on.
+static cl::opt<bool> CompareDA(
+    "divergence-compare", cl::init(false), cl::Hidden,
+    cl::desc("Run both the VPlan+RV DivergenceAnalysis and the "
+             "DivergencePropagator, and report the values on which they "
+             "disagree."));
+
+STATISTIC(NumPropagatorOnlyDivergent,
+          "Number of values only divergent under the DivergencePropagator");
+STATISTIC(NumGPUDAOnlyDivergent,
+          "Number of values only divergent under the VPlan+RV "
+          "DivergenceAnalysis");
+
 namespace {
 
 class DivergencePropagator {
@@ -288,7 +304,7 @@ FunctionPass *llvm::createKernelDivergenceAnalysisPass() {
 void KernelDivergenceAnalysis::getAnalysisUsage(AnalysisUsage &AU) const {
   AU.addRequired<DominatorTreeWrapperPass>();
   AU.addRequired<PostDominatorTreeWrapperPass>();
-  if (UseRVDA) AU.addRequired<LoopInfoWrapperPass>();
+  AU.addRequired<LoopInfoWrapperPass>();
   AU.setPreservesAll();
 }
 
@@ -304,17 +320,22 @@ bool KernelDivergenceAnalysis::runOnFunction(Function &F) {
     return false;
 
   DivergentValues.clear();
+  PropagatorOnlyDivergent.clear();
+  GPUDAOnlyDivergent.clear();
   gpuDA = nullptr;
 
   auto &DT = getAnalysis<DominatorTreeWrapperPass>().getDomTree();
   auto &PDT = getAnalysis<PostDominatorTreeWrapperPass>().getPostDomTree();
+  auto &LI = getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
+
+  UseGPUDA = UseRVDA;
 
-  if (UseRVDA) {
+  if (UseRVDA || CompareDA) {
     // run the new GPU divergence analysis
-    auto &LI = getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
-    gpuDA = std::make_unique<GPUDivergenceAnalysis>(F, DT, PDT, LI, TTI);
+    gpuDA = llvm::make_unique<GPUDivergenceAnalysis>(F, DT, PDT, LI, TTI);
+  }
 
-  } else {
+  if (!UseGPUDA || CompareDA) {
     // run LLVM's existing DivergenceAnalysis
     DivergencePropagator DP(F, TTI,
                             DT,
@@ -323,6 +344,9 @@ bool KernelDivergenceAnalysis::runOnFunction(Function &F) {
     DP.propagate();
   }
 
+  if (CompareDA && gpuDA)
+    compareEngines(F);
+
   LLVM_DEBUG(
     dbgs() << "\nAfter divergence analysis on " << F.getName() << ":\n";
     print(dbgs(), F.getParent())
@@ -332,10 +356,43 @@ bool KernelDivergenceAnalysis::runOnFunction(Function &F) {
 }
 
 bool KernelDivergenceAnalysis::isDivergent(const Value *V) const {
-  if (gpuDA) return gpuDA->isDivergent(*V);
+  if (UseGPUDA) return gpuDA->isDivergent(*V);
   else return DivergentValues.count(V);
 }
 
+void KernelDivergenceAnalysis::removeValue(const Value *V) {
+  DivergentValues.erase(V);
+  if (gpuDA)
+    gpuDA->removeValue(*V);
+  auto IsV = [V](const Value *Other) { return Other == V; };
+  erase_if(PropagatorOnlyDivergent, IsV);
+  erase_if(GPUDAOnlyDivergent, IsV);
+}
+
+void KernelDivergenceAnalysis::compareEngines(const Function &F) {
+  auto Compare = [this](const Value &V) {
+    bool PropagatorDivergent = DivergentValues.count(&V);
+    if (PropagatorDivergent == gpuDA->isDivergent(V))
+      return;
+    if (PropagatorDivergent) {
+      PropagatorOnlyDivergent.push_back(&V);
+      ++NumPropagatorOnlyDivergent;
+    } else {
+      GPUDAOnlyDivergent.push_back(&V);
+      ++NumGPUDAOnlyDivergent;
+    }
+  };
+  for (auto &Arg : F.args())
+    Compare(Arg);
+  for (auto &I : instructions(F))
+    Compare(I);
+
+  LLVM_DEBUG(dbgs() << "Divergence analyses of " << F.getName()
+                    << " disagree on " << PropagatorOnlyDivergent.size()
+                    << " propagator-only and " << GPUDAOnlyDivergent.size()
+                    << " gpuda-only divergent values\n");
+}
+
 void KernelDivergenceAnalysis::print(raw_ostream &OS, const Module *) const {
   if ((!gpuDA || !gpuDA->hasDivergence()) && DivergentValues.empty())
     return;
@@ -355,6 +412,13 @@ void KernelDivergenceAnalysis::print(raw_ostream &OS, const Module *) const {
     F = &gpuDA->getFunction();
   }
 
+  // In -divergence-compare mode, list the values that only one of the
+  // analyses considers divergent.
+  for (const Value *V : PropagatorOnlyDivergent)
+    OS << "PROPAGATOR-ONLY: " << *V << "\n";
+  for (const Value *V : GPUDAOnlyDivergent)
+    OS << "GPUDA-ONLY: " << *V << "\n";
+
   // Dumps all divergent values in F, arguments and then instructions.
   for (auto &Arg : F->args()) {
     OS << (isDivergent(&Arg) ? "DIVERGENT: " : "           ");
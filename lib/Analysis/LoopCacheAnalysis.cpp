@@ -0,0 +1,169 @@
+//===- LoopCacheAnalysis.cpp - Loop cache cost ----------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the CacheCost class, which estimates the cache lines
+// touched by a perfect loop nest for each choice of its innermost loop.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Analysis/LoopCacheAnalysis.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+
+using namespace llvm;
+
+static cl::opt<unsigned> DefaultTripCount(
+    "loop-cache-default-trip-count", cl::init(100), cl::Hidden,
+    cl::desc("Trip count assumed for loops whose trip count is unknown"));
+
+static cl::opt<unsigned> DefaultCacheLineSize(
+    "loop-cache-default-line-size", cl::init(64), cl::Hidden,
+    cl::desc("Cache line size in bytes assumed if the target doesn't set one"));
+
+/// Returns the amount \p Ptr advances by per iteration of \p L, or null if it
+/// isn't an affine function of \p L.
+static const SCEV *getStride(const SCEV *Ptr, const Loop &L,
+                             ScalarEvolution &SE) {
+  while (const auto *AR = dyn_cast<SCEVAddRecExpr>(Ptr)) {
+    if (AR->getLoop() == &L)
+      return AR->isAffine() ? AR->getStepRecurrence(SE) : nullptr;
+    Ptr = AR->getStart();
+  }
+  return nullptr;
+}
+
+/// Returns true if the value of \p Ptr may change between iterations of \p L,
+/// including through the loops nested in it.
+static bool variesWith(const SCEV *Ptr, const Loop &L) {
+  return SCEVExprContains(Ptr, [&](const SCEV *S) {
+    if (const auto *AR = dyn_cast<SCEVAddRecExpr>(S))
+      return AR->getLoop() == &L;
+    if (const auto *U = dyn_cast<SCEVUnknown>(S))
+      if (const auto *I = dyn_cast<Instruction>(U->getValue()))
+        return L.contains(I);
+    return false;
+  });
+}
+
+std::unique_ptr<CacheCost> CacheCost::get(const Loop &Root,
+                                          ScalarEvolution &SE,
+                                          const TargetTransformInfo &TTI) {
+  unsigned LineSize = TTI.getCacheLineSize();
+  if (!LineSize)
+    LineSize = DefaultCacheLineSize;
+  std::unique_ptr<CacheCost> CC(new CacheCost(SE, LineSize));
+
+  for (const Loop *L = &Root;;) {
+    CC->Loops.push_back(L);
+    unsigned TripCount = SE.getSmallConstantTripCount(L);
+    CC->TripCounts.push_back(TripCount ? TripCount : DefaultTripCount);
+    if (L->empty())
+      break;
+    if (L->getSubLoops().size() != 1)
+      return nullptr;
+    L = L->getSubLoops().front();
+  }
+
+  for (const BasicBlock *BB : Root.blocks()) {
+    for (const Instruction &I : *BB) {
+      const Value *Ptr;
+      if (const auto *LI = dyn_cast<LoadInst>(&I))
+        Ptr = LI->getPointerOperand();
+      else if (const auto *SI = dyn_cast<StoreInst>(&I))
+        Ptr = SI->getPointerOperand();
+      else
+        continue;
+
+      const SCEV *PtrSCEV = SE.getSCEV(const_cast<Value *>(Ptr));
+      bool SameLines = any_of(CC->Groups, [&](const SCEV *Group) {
+        const auto *Diff = dyn_cast<SCEVConstant>(
+            SE.getMinusSCEV(PtrSCEV, Group));
+        return Diff &&
+               std::abs(Diff->getAPInt().getSExtValue()) < (int64_t)LineSize;
+      });
+      if (!SameLines)
+        CC->Groups.push_back(PtrSCEV);
+    }
+  }
+
+  for (unsigned LoopIdx = 0, E = CC->Loops.size(); LoopIdx != E; ++LoopIdx) {
+    uint64_t OtherTrips = 1;
+    for (unsigned Idx = 0; Idx != E; ++Idx)
+      if (Idx != LoopIdx)
+        OtherTrips = SaturatingMultiply(OtherTrips, CC->TripCounts[Idx]);
+    uint64_t Cost = SaturatingMultiply(CC->getFootprint(*CC->Loops[LoopIdx]),
+                                       OtherTrips);
+    CC->LoopCosts.push_back(std::make_pair(CC->Loops[LoopIdx], Cost));
+  }
+  std::stable_sort(CC->LoopCosts.begin(), CC->LoopCosts.end(),
+                   [](const LoopCost &A, const LoopCost &B) {
+                     return A.second > B.second;
+                   });
+  return CC;
+}
+
+unsigned CacheCost::getLoopIndex(const Loop &L) const {
+  auto It = find(Loops, &L);
+  assert(It != Loops.end() && "Loop is not part of the nest");
+  return It - Loops.begin();
+}
+
+uint64_t CacheCost::computeRefCost(const SCEV *Group, unsigned LoopIdx) const {
+  const Loop &L = *Loops[LoopIdx];
+  if (!variesWith(Group, L))
+    return 1;
+
+  uint64_t TripCount = TripCounts[LoopIdx];
+  const auto *Stride = dyn_cast_or_null<SCEVConstant>(getStride(Group, L, SE));
+  if (!Stride)
+    return TripCount;
+  uint64_t AbsStride = std::abs(Stride->getAPInt().getSExtValue());
+  if (AbsStride >= LineSize)
+    return TripCount;
+  return std::max<uint64_t>(
+      SaturatingMultiply(TripCount, AbsStride) / LineSize, 1);
+}
+
+uint64_t CacheCost::getLoopCost(const Loop &L) const {
+  for (const LoopCost &LC : LoopCosts)
+    if (LC.first == &L)
+      return LC.second;
+  llvm_unreachable("Loop is not part of the nest");
+}
+
+uint64_t CacheCost::getFootprint(const Loop &L) const {
+  unsigned LoopIdx = getLoopIndex(L);
+  uint64_t Lines = 0;
+  for (const SCEV *Group : Groups)
+    Lines = SaturatingAdd(Lines, computeRefCost(Group, LoopIdx));
+  return Lines;
+}
+
+bool CacheCost::hasReuseAcross(const Loop &L, const Loop &Inner) const {
+  return any_of(Groups, [&](const SCEV *Group) {
+    return !variesWith(Group, L) && variesWith(Group, Inner);
+  });
+}
+
+uint64_t CacheCost::getTripCount(const Loop &L) const {
+  return TripCounts[getLoopIndex(L)];
+}
+
+void CacheCost::print(raw_ostream &OS) const {
+  for (const LoopCost &LC : LoopCosts)
+    OS << "Loop '" << LC.first->getHeader()->getName() << "' has cost = "
+       << LC.second << "\n";
+}
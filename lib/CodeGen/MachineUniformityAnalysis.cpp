@@ -0,0 +1,271 @@
+//===- MachineUniformityAnalysis.cpp - Machine divergence analysis --------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements MachineUniformityInfo, the divergence analysis of the
+// machine IR in SSA form. It mirrors the IR DivergenceAnalysis: the values
+// that are divergent in some thread are propagated to their users, and a
+// divergent branch makes divergent the phis of its join blocks and, through
+// the loop exits it reaches, the values defined in its loop that are used
+// after the loop.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/CodeGen/MachineUniformityAnalysis.h"
+#include "llvm/Analysis/BranchDependenceAnalysisImpl.h"
+#include "llvm/CodeGen/MachineBasicBlock.h"
+#include "llvm/CodeGen/MachineFunction.h"
+#include "llvm/CodeGen/MachineInstr.h"
+#include "llvm/CodeGen/MachineLoopInfo.h"
+#include "llvm/CodeGen/MachinePostDominators.h"
+#include "llvm/CodeGen/MachineRegisterInfo.h"
+#include "llvm/CodeGen/TargetInstrInfo.h"
+#include "llvm/CodeGen/TargetRegisterInfo.h"
+#include "llvm/CodeGen/TargetSubtargetInfo.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+#define DEBUG_TYPE "machine-uniformity"
+
+template class llvm::BranchDependenceAnalysisBase<MachineBasicBlock,
+                                                  MachineLoop>;
+
+char MachineUniformityInfo::ID = 0;
+
+INITIALIZE_PASS_BEGIN(MachineUniformityInfo, DEBUG_TYPE,
+                      "Machine Uniformity Analysis", false, true)
+INITIALIZE_PASS_DEPENDENCY(MachineLoopInfo)
+INITIALIZE_PASS_DEPENDENCY(MachinePostDominatorTree)
+INITIALIZE_PASS_END(MachineUniformityInfo, DEBUG_TYPE,
+                    "Machine Uniformity Analysis", false, true)
+
+MachineUniformityInfo::MachineUniformityInfo() : MachineFunctionPass(ID) {
+  initializeMachineUniformityInfoPass(*PassRegistry::getPassRegistry());
+}
+
+void MachineUniformityInfo::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<MachineLoopInfo>();
+  AU.addRequired<MachinePostDominatorTree>();
+  AU.setPreservesAll();
+  MachineFunctionPass::getAnalysisUsage(AU);
+}
+
+void MachineUniformityInfo::releaseMemory() {
+  AllDivergent = false;
+  DivergentRegs.clear();
+  DivergentInstrs.clear();
+  UniformOverrides.clear();
+  DivergentBranchBlocks.clear();
+  JoinDivergentBlocks.clear();
+  TaintedLoops.clear();
+  Worklist.clear();
+}
+
+bool MachineUniformityInfo::runOnMachineFunction(MachineFunction &Fn) {
+  releaseMemory();
+  MF = &Fn;
+  MRI = &Fn.getRegInfo();
+  MLI = &getAnalysis<MachineLoopInfo>();
+
+  // Without SSA form, the uses of a register don't tell which definition they
+  // read.
+  if (!MRI->isSSA()) {
+    AllDivergent = true;
+    return false;
+  }
+
+  BranchDependenceAnalysisBase<MachineBasicBlock, MachineLoop> BranchDeps(
+      getAnalysis<MachinePostDominatorTree>().getBase(),
+      getAnalysis<MachineLoopInfo>().getBase());
+  BDA = &BranchDeps;
+
+  // The sources of divergence are divergent whatever their operands are, so
+  // they are marked before the propagation starts.
+  const TargetInstrInfo &TII = *Fn.getSubtarget().getInstrInfo();
+  SmallVector<const MachineInstr *, 16> Sources;
+  for (const MachineBasicBlock &MBB : Fn) {
+    for (const MachineInstr &MI : MBB) {
+      switch (TII.getInstructionUniformity(MI)) {
+      case InstructionUniformity::AlwaysUniform:
+        UniformOverrides.insert(&MI);
+        break;
+      case InstructionUniformity::NeverUniform:
+        Sources.push_back(&MI);
+        break;
+      case InstructionUniformity::Default:
+        break;
+      }
+    }
+  }
+  for (const MachineInstr *MI : Sources)
+    markDivergent(*MI);
+
+  while (!Worklist.empty()) {
+    const MachineInstr &MI = *Worklist.back();
+    Worklist.pop_back();
+    if (!DivergentInstrs.count(&MI) && updateInstruction(MI))
+      markDivergent(MI);
+  }
+
+  BDA = nullptr;
+  return false;
+}
+
+void MachineUniformityInfo::markDivergent(const MachineInstr &MI) {
+  if (UniformOverrides.count(&MI) || !DivergentInstrs.insert(&MI).second)
+    return;
+
+  for (const MachineOperand &MO : MI.operands()) {
+    if (!MO.isReg() || !MO.isDef() ||
+        !TargetRegisterInfo::isVirtualRegister(MO.getReg()))
+      continue;
+    if (!DivergentRegs.insert(MO.getReg()).second)
+      continue;
+    for (const MachineInstr &UseMI : MRI->use_nodbg_instructions(MO.getReg()))
+      Worklist.push_back(&UseMI);
+  }
+
+  if (MI.isTerminator())
+    propagateBranchDivergence(*MI.getParent());
+}
+
+void MachineUniformityInfo::propagateBranchDivergence(
+    const MachineBasicBlock &MBB) {
+  if (MBB.succ_size() < 2 || !DivergentBranchBlocks.insert(&MBB).second)
+    return;
+
+  const MachineLoop *BranchLoop = MLI->getLoopFor(&MBB);
+  for (const MachineBasicBlock *JoinBlock : BDA->join_blocks(MBB)) {
+    JoinDivergentBlocks.insert(JoinBlock);
+    for (const MachineInstr &Phi : JoinBlock->phis())
+      Worklist.push_back(&Phi);
+
+    // The threads leave the loop in different iterations, so they see
+    // different values of the registers defined in the loop after it.
+    if (BranchLoop && !BranchLoop->contains(JoinBlock))
+      taintLoopLiveOuts(*BranchLoop);
+  }
+
+  // The same holds for the irreducible cycles, which are not MachineLoops.
+  for (const auto *Cycle : BDA->divergent_cycles(MBB))
+    taintCycleLiveOuts(Cycle->blocks);
+}
+
+void MachineUniformityInfo::taintLoopLiveOuts(const MachineLoop &L) {
+  if (!TaintedLoops.insert(&L).second)
+    return;
+
+  for (const MachineBasicBlock *MBB : L.blocks()) {
+    for (const MachineInstr &MI : *MBB) {
+      for (const MachineOperand &MO : MI.defs()) {
+        if (!TargetRegisterInfo::isVirtualRegister(MO.getReg()))
+          continue;
+        for (const MachineInstr &UseMI :
+             MRI->use_nodbg_instructions(MO.getReg()))
+          if (!L.contains(UseMI.getParent()))
+            markDivergent(UseMI);
+      }
+    }
+  }
+}
+
+void MachineUniformityInfo::taintCycleLiveOuts(
+    const SmallPtrSetImpl<const MachineBasicBlock *> &Cycle) {
+  for (const MachineBasicBlock *MBB : Cycle) {
+    for (const MachineInstr &MI : *MBB) {
+      for (const MachineOperand &MO : MI.defs()) {
+        if (!TargetRegisterInfo::isVirtualRegister(MO.getReg()))
+          continue;
+        for (const MachineInstr &UseMI :
+             MRI->use_nodbg_instructions(MO.getReg()))
+          if (!Cycle.count(UseMI.getParent()))
+            markDivergent(UseMI);
+      }
+    }
+  }
+}
+
+bool MachineUniformityInfo::updateInstruction(const MachineInstr &MI) const {
+  // A phi of a join block of a divergent branch selects different incoming
+  // values in different threads.
+  if (MI.isPHI() && JoinDivergentBlocks.count(MI.getParent())) {
+    for (unsigned I = 3, E = MI.getNumOperands(); I < E; I += 2)
+      if (MI.getOperand(I).getReg() != MI.getOperand(1).getReg())
+        return true;
+  }
+
+  for (const MachineOperand &MO : MI.uses())
+    if (MO.isReg() && TargetRegisterInfo::isVirtualRegister(MO.getReg()) &&
+        DivergentRegs.count(MO.getReg()))
+      return true;
+  return false;
+}
+
+bool MachineUniformityInfo::isDivergent(unsigned Reg) const {
+  return AllDivergent || DivergentRegs.count(Reg);
+}
+
+bool MachineUniformityInfo::isDivergent(const MachineInstr &MI) const {
+  return AllDivergent || DivergentInstrs.count(&MI);
+}
+
+bool MachineUniformityInfo::hasDivergentBranch(
+    const MachineBasicBlock &MBB) const {
+  if (AllDivergent)
+    return MBB.succ_size() > 1;
+  return DivergentBranchBlocks.count(&MBB);
+}
+
+void MachineUniformityInfo::print(raw_ostream &OS, const Module *) const {
+  if (!MF)
+    return;
+  OS << "Divergence of function " << MF->getName() << ":\n";
+  for (const MachineBasicBlock &MBB : *MF) {
+    for (const MachineInstr &MI : MBB)
+      if (isDivergent(MI))
+        OS << "DIVERGENT: " << MI;
+    if (hasDivergentBranch(MBB))
+      OS << "DIVERGENT BRANCH: " << printMBBReference(MBB) << '\n';
+  }
+}
+
+namespace {
+
+/// Prints the result of MachineUniformityInfo to the error stream, for the
+/// tests.
+class MachineUniformityPrinter : public MachineFunctionPass {
+public:
+  static char ID;
+
+  MachineUniformityPrinter() : MachineFunctionPass(ID) {
+    initializeMachineUniformityPrinterPass(*PassRegistry::getPassRegistry());
+  }
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override {
+    AU.addRequired<MachineUniformityInfo>();
+    AU.setPreservesAll();
+    MachineFunctionPass::getAnalysisUsage(AU);
+  }
+
+  bool runOnMachineFunction(MachineFunction &MF) override {
+    getAnalysis<MachineUniformityInfo>().print(errs());
+    return false;
+  }
+};
+
+} // end anonymous namespace
+
+char MachineUniformityPrinter::ID = 0;
+
+INITIALIZE_PASS_BEGIN(MachineUniformityPrinter, "print-machine-uniformity",
+                      "Print Machine Uniformity Analysis", false, true)
+INITIALIZE_PASS_DEPENDENCY(MachineUniformityInfo)
+INITIALIZE_PASS_END(MachineUniformityPrinter, "print-machine-uniformity",
+                    "Print Machine Uniformity Analysis", false, true)
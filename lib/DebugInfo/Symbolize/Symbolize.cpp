@@ -16,6 +16,7 @@
 #include "SymbolizableObjectFile.h"
 
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/BinaryFormat/COFF.h"
 #include "llvm/Config/config.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
@@ -50,14 +51,19 @@
 #endif
 #endif
 
+#define DEBUG_TYPE "symbolize"
+
+STATISTIC(NumModulesEvicted, "Number of modules unloaded by the cache limit");
+
 namespace llvm {
 namespace symbolize {
 
 Expected<DILineInfo>
 LLVMSymbolizer::symbolizeCode(const std::string &ModuleName,
                               uint64_t ModuleOffset, StringRef DWPName) {
+  std::unique_lock<std::mutex> ModuleLock;
   SymbolizableModule *Info;
-  if (auto InfoOrErr = getOrCreateModuleInfo(ModuleName, DWPName))
+  if (auto InfoOrErr = getOrCreateModuleInfo(ModuleName, ModuleLock, DWPName))
     Info = InfoOrErr.get();
   else
     return InfoOrErr.takeError();
@@ -82,8 +88,9 @@ LLVMSymbolizer::symbolizeCode(const std::string &ModuleName,
 Expected<DIInliningInfo>
 LLVMSymbolizer::symbolizeInlinedCode(const std::string &ModuleName,
                                      uint64_t ModuleOffset, StringRef DWPName) {
+  std::unique_lock<std::mutex> ModuleLock;
   SymbolizableModule *Info;
-  if (auto InfoOrErr = getOrCreateModuleInfo(ModuleName, DWPName))
+  if (auto InfoOrErr = getOrCreateModuleInfo(ModuleName, ModuleLock, DWPName))
     Info = InfoOrErr.get();
   else
     return InfoOrErr.takeError();
@@ -111,8 +118,9 @@ LLVMSymbolizer::symbolizeInlinedCode(const std::string &ModuleName,
 
 Expected<DIGlobal> LLVMSymbolizer::symbolizeData(const std::string &ModuleName,
                                                  uint64_t ModuleOffset) {
+  std::unique_lock<std::mutex> ModuleLock;
   SymbolizableModule *Info;
-  if (auto InfoOrErr = getOrCreateModuleInfo(ModuleName))
+  if (auto InfoOrErr = getOrCreateModuleInfo(ModuleName, ModuleLock))
     Info = InfoOrErr.get();
   else
     return InfoOrErr.takeError();
@@ -138,7 +146,9 @@ void LLVMSymbolizer::flush() {
   ObjectForUBPathAndArch.clear();
   BinaryForPath.clear();
   ObjectPairForPathArch.clear();
-  Modules.clear();
+  for (ModuleShard &Shard : ModuleShards)
+    Shard.Modules.clear();
+  CacheSize = 0;
 }
 
 namespace {
@@ -298,6 +308,7 @@ ObjectFile *LLVMSymbolizer::lookUpDebuglinkObject(const std::string &Path,
 Expected<LLVMSymbolizer::ObjectPair>
 LLVMSymbolizer::getOrCreateObjectPair(const std::string &Path,
                                       const std::string &ArchName) {
+  std::lock_guard<std::mutex> ObjectCacheGuard(ObjectCacheLock);
   const auto &I = ObjectPairForPathArch.find(std::make_pair(Path, ArchName));
   if (I != ObjectPairForPathArch.end()) {
     return I->second;
@@ -371,11 +382,35 @@ LLVMSymbolizer::getOrCreateObject(const std::string &Path,
 
 Expected<SymbolizableModule *>
 LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName,
+                                      std::unique_lock<std::mutex> &ModuleLock,
                                       StringRef DWPName) {
-  const auto &I = Modules.find(ModuleName);
-  if (I != Modules.end()) {
-    return I->second.get();
+  ModuleShard &Shard = ModuleShards[hash_value(ModuleName) % NumModuleShards];
+  ModuleEntry *Entry;
+  {
+    std::lock_guard<std::mutex> ShardGuard(Shard.Lock);
+    std::unique_ptr<ModuleEntry> &Slot = Shard.Modules[ModuleName];
+    if (!Slot)
+      Slot = llvm::make_unique<ModuleEntry>();
+    Entry = Slot.get();
   }
+
+  ModuleLock = std::unique_lock<std::mutex>(Entry->Lock);
+  Entry->LastUse = ++UseClock;
+  if (Entry->Loaded)
+    return Entry->Module.get();
+
+  auto ModuleOrErr = loadModule(ModuleName, *Entry, DWPName);
+  if (ModuleOrErr && *ModuleOrErr && Opts.MaxCacheSize) {
+    CacheSize += Entry->Size;
+    evictModules(Entry);
+  }
+  return ModuleOrErr;
+}
+
+Expected<SymbolizableModule *>
+LLVMSymbolizer::loadModule(const std::string &ModuleName, ModuleEntry &Entry,
+                           StringRef DWPName) {
+  Entry.Loaded = true;
   std::string BinaryName = ModuleName;
   std::string ArchName = Opts.DefaultArch;
   size_t ColonPos = ModuleName.find_last_of(':');
@@ -390,8 +425,6 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName,
   auto ObjectsOrErr = getOrCreateObjectPair(BinaryName, ArchName);
   if (!ObjectsOrErr) {
     // Failed to find valid object file.
-    Modules.insert(
-        std::make_pair(ModuleName, std::unique_ptr<SymbolizableModule>()));
     return ObjectsOrErr.takeError();
   }
   ObjectPair Objects = ObjectsOrErr.get();
@@ -407,11 +440,8 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName,
       using namespace pdb;
       std::unique_ptr<IPDBSession> Session;
       if (auto Err = loadDataForEXE(PDB_ReaderType::DIA,
-                                    Objects.first->getFileName(), Session)) {
-        Modules.insert(
-            std::make_pair(ModuleName, std::unique_ptr<SymbolizableModule>()));
+                                    Objects.first->getFileName(), Session))
         return std::move(Err);
-      }
       Context.reset(new PDBContext(*CoffObject, std::move(Session)));
     }
   }
@@ -421,15 +451,42 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName,
   assert(Context);
   auto InfoOrErr =
       SymbolizableObjectFile::create(Objects.first, std::move(Context));
-  std::unique_ptr<SymbolizableModule> SymMod;
-  if (InfoOrErr)
-    SymMod = std::move(InfoOrErr.get());
-  auto InsertResult =
-      Modules.insert(std::make_pair(ModuleName, std::move(SymMod)));
-  assert(InsertResult.second);
   if (auto EC = InfoOrErr.getError())
     return errorCodeToError(EC);
-  return InsertResult.first->second.get();
+  Entry.Module = std::move(InfoOrErr.get());
+  Entry.Size = Objects.second->getData().size();
+  return Entry.Module.get();
+}
+
+void LLVMSymbolizer::evictModules(const ModuleEntry *InUse) {
+  std::lock_guard<std::mutex> EvictionGuard(EvictionLock);
+  while (CacheSize > Opts.MaxCacheSize) {
+    // Find the least recently used module that is loaded. Modules that are in
+    // use by other threads are skipped rather than waited for.
+    ModuleEntry *Victim = nullptr;
+    std::unique_lock<std::mutex> VictimLock;
+    for (ModuleShard &Shard : ModuleShards) {
+      std::lock_guard<std::mutex> ShardGuard(Shard.Lock);
+      for (auto &NameAndEntry : Shard.Modules) {
+        ModuleEntry *Entry = NameAndEntry.second.get();
+        if (Entry == InUse)
+          continue;
+        std::unique_lock<std::mutex> EntryLock(Entry->Lock, std::try_to_lock);
+        if (!EntryLock || !Entry->Module)
+          continue;
+        if (Victim && Victim->LastUse <= Entry->LastUse)
+          continue;
+        Victim = Entry;
+        VictimLock = std::move(EntryLock);
+      }
+    }
+    if (!Victim)
+      return;
+    Victim->Module.reset();
+    Victim->Loaded = false;
+    CacheSize -= Victim->Size;
+    ++NumModulesEvicted;
+  }
 }
 
 namespace {
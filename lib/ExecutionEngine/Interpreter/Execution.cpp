@@ -40,7 +40,7 @@ static cl::opt<bool> PrintVolatile("interpreter-print-volatile", cl::Hidden,
 //===----------------------------------------------------------------------===//
 
 static void SetValue(Value *V, GenericValue Val, ExecutionContext &SF) {
-  SF.Values[V] = Val;
+  SF.getValue(V) = Val;
 }
 
 //===----------------------------------------------------------------------===//
@@ -931,6 +931,7 @@ void Interpreter::SwitchToNewBasicBlock(BasicBlock *Dest, ExecutionContext &SF){
   BasicBlock *PrevBB = SF.CurBB;      // Remember where we came from...
   SF.CurBB   = Dest;                  // Update CurBB to branch destination
   SF.CurInst = SF.CurBB->begin();     // Update new instruction ptr...
+  SF.setBlock();
 
   if (!isa<PHINode>(SF.CurInst)) return;  // Nothing fancy to do
 
@@ -938,6 +939,7 @@ void Interpreter::SwitchToNewBasicBlock(BasicBlock *Dest, ExecutionContext &SF){
   std::vector<GenericValue> ResultValues;
 
   for (; PHINode *PN = dyn_cast<PHINode>(SF.CurInst); ++SF.CurInst) {
+    SF.step(*PN);
     // Search for the value corresponding to this previous bb...
     int i = PN->getBasicBlockIndex(PrevBB);
     assert(i != -1 && "PHINode doesn't contain entry for predecessor??");
@@ -949,8 +951,10 @@ void Interpreter::SwitchToNewBasicBlock(BasicBlock *Dest, ExecutionContext &SF){
 
   // Now loop over all of the PHI nodes setting their values...
   SF.CurInst = SF.CurBB->begin();
+  SF.setBlock();
   for (unsigned i = 0; isa<PHINode>(SF.CurInst); ++SF.CurInst, ++i) {
     PHINode *PN = cast<PHINode>(SF.CurInst);
+    SF.step(*PN);
     SetValue(PN, ResultValues[i], SF);
   }
 }
@@ -1091,6 +1095,7 @@ void Interpreter::visitCallSite(CallSite CS) {
       if (!atBegin)
         --me;
       IL->LowerIntrinsicCall(cast<CallInst>(CS.getInstruction()));
+      SF.Slots->invalidate();
 
       // Restore the CurInst pointer to the first instruction newly inserted, if
       // any.
@@ -2061,7 +2066,7 @@ GenericValue Interpreter::getOperandValue(Value *V, ExecutionContext &SF) {
   } else if (GlobalValue *GV = dyn_cast<GlobalValue>(V)) {
     return PTOGV(getPointerToGlobal(GV));
   } else {
-    return SF.Values[V];
+    return SF.getValue(V);
   }
 }
 
@@ -2069,6 +2074,59 @@ GenericValue Interpreter::getOperandValue(Value *V, ExecutionContext &SF) {
 //                        Dispatch and Execution Code
 //===----------------------------------------------------------------------===//
 
+FunctionSlots::FunctionSlots(const Function &F) {
+  for (const Argument &A : F.args())
+    getSlot(&A);
+  for (const BasicBlock &BB : F)
+    for (const Instruction &I : BB)
+      if (!I.getType()->isVoidTy())
+        getSlot(&I);
+}
+
+BlockCode &FunctionSlots::getBlockCode(BasicBlock &BB) {
+  BlockCode *&BC = Blocks[&BB];
+  if (BC)
+    return *BC;
+  Code.push_back(llvm::make_unique<BlockCode>());
+  BC = Code.back().get();
+
+  // Number the operands first, OperandSlots must not grow once the
+  // instructions point into it.
+  for (Instruction &I : BB)
+    for (Value *Op : I.operands())
+      BC->OperandSlots.push_back(isa<Instruction>(Op) || isa<Argument>(Op)
+                                     ? getSlot(Op)
+                                     : (unsigned)DecodedInst::NoSlot);
+  const unsigned *OperandSlots = BC->OperandSlots.data();
+  for (Instruction &I : BB) {
+    unsigned Slot =
+        I.getType()->isVoidTy() ? (unsigned)DecodedInst::NoSlot : getSlot(&I);
+    BC->Insts.push_back({&I, Slot, OperandSlots});
+    OperandSlots += I.getNumOperands();
+  }
+  return *BC;
+}
+
+void FunctionSlots::invalidate() {
+  for (auto &BC : Code)
+    BC->Stale = true;
+  Blocks.clear();
+}
+
+void ExecutionContext::resync(Instruction &I) {
+  Code = &Slots->getBlockCode(*I.getParent());
+  NextCode = 0;
+  while (Code->Insts[NextCode].Inst != &I)
+    ++NextCode;
+}
+
+FunctionSlots &Interpreter::getFunctionSlots(const Function &F) {
+  std::unique_ptr<FunctionSlots> &Slots = FunctionSlotMaps[&F];
+  if (!Slots)
+    Slots = llvm::make_unique<FunctionSlots>(F);
+  return *Slots;
+}
+
 //===----------------------------------------------------------------------===//
 // callFunction - Execute the specified function...
 //
@@ -2093,6 +2151,11 @@ void Interpreter::callFunction(Function *F, ArrayRef<GenericValue> ArgVals) {
   StackFrame.CurBB     = &F->front();
   StackFrame.CurInst   = StackFrame.CurBB->begin();
 
+  // Allocate the value plane for the frame.
+  StackFrame.Slots = &getFunctionSlots(*F);
+  StackFrame.Values.resize(StackFrame.Slots->getNumSlots());
+  StackFrame.setBlock();
+
   // Run through the function arguments and initialize their values...
   assert((ArgVals.size() == F->arg_size() ||
          (ArgVals.size() > F->arg_size() && F->getFunctionType()->isVarArg()))&&
@@ -2114,6 +2177,7 @@ void Interpreter::run() {
     // Interpret a single instruction & increment the "PC".
     ExecutionContext &SF = ECStack.back();  // Current stack frame
     Instruction &I = *SF.CurInst++;         // Increment before execute
+    SF.step(I);
 
     // Track the number of dynamic instructions executed.
     ++NumDynamicInsts;
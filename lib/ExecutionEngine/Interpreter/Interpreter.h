@@ -14,6 +14,7 @@
 #ifndef LLVM_LIB_EXECUTIONENGINE_INTERPRETER_INTERPRETER_H
 #define LLVM_LIB_EXECUTIONENGINE_INTERPRETER_INTERPRETER_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
 #include "llvm/ExecutionEngine/GenericValue.h"
 #include "llvm/IR/CallSite.h"
@@ -55,6 +56,56 @@ public:
 
 typedef std::vector<GenericValue> ValuePlaneTy;
 
+// DecodedInst - An instruction with the slots of its value and of its
+// operands resolved, so that executing it indexes the value plane directly.
+//
+struct DecodedInst {
+  enum : unsigned { NoSlot = ~0U };
+
+  Instruction *Inst;
+  unsigned Slot;                // Slot of the value of Inst, or NoSlot
+  const unsigned *OperandSlots; // Slot of each operand, or NoSlot
+};
+
+// BlockCode - The decoded instructions of a basic block, in order.  Changing
+// the IR of a function (intrinsic lowering) makes its block codes stale: they
+// stay allocated, as suspended frames may still point into them, but are
+// decoded again before being executed.
+//
+struct BlockCode {
+  std::vector<DecodedInst> Insts;
+  std::vector<unsigned> OperandSlots;
+  bool Stale = false;
+};
+
+// FunctionSlots - Dense numbering of the arguments and instructions of a
+// function, used to index the value plane of its stack frames.  The numbering
+// is computed once, the first time the function is called; values created
+// after that (e.g. by intrinsic lowering) are numbered on demand.  Blocks are
+// decoded the first time they are executed.
+//
+class FunctionSlots {
+  DenseMap<const Value *, unsigned> Slots;
+  DenseMap<const BasicBlock *, BlockCode *> Blocks;
+  std::vector<std::unique_ptr<BlockCode>> Code;
+
+public:
+  explicit FunctionSlots(const Function &F);
+
+  unsigned getSlot(const Value *V) {
+    return Slots.insert(std::make_pair(V, Slots.size())).first->second;
+  }
+
+  unsigned getNumSlots() const { return Slots.size(); }
+
+  // getBlockCode - Return the decoded instructions of BB.
+  BlockCode &getBlockCode(BasicBlock &BB);
+
+  // invalidate - Mark every decoded block as stale, after the IR of the
+  // function changed.
+  void invalidate();
+};
+
 // ExecutionContext struct - This struct represents one stack frame currently
 // executing.
 //
@@ -64,11 +115,59 @@ struct ExecutionContext {
   BasicBlock::iterator  CurInst;    // The next instruction to execute
   CallSite             Caller;     // Holds the call that called subframes.
                                    // NULL if main func or debugger invoked fn
-  std::map<Value *, GenericValue> Values; // LLVM values used in this invocation
+  FunctionSlots        *Slots;      // Slot numbering for CurFunction
+  BlockCode            *Code;       // Decoded instructions of CurBB
+  unsigned              NextCode;   // Index of CurInst in Code
+  const DecodedInst    *CurCode;    // The instruction being executed
+  ValuePlaneTy          Values;     // LLVM values used in this invocation
   std::vector<GenericValue>  VarArgs; // Values passed through an ellipsis
   AllocaHolder Allocas;            // Track memory allocated by alloca
 
-  ExecutionContext() : CurFunction(nullptr), CurBB(nullptr), CurInst(nullptr) {}
+  ExecutionContext()
+      : CurFunction(nullptr), CurBB(nullptr), CurInst(nullptr),
+        Slots(nullptr), Code(nullptr), NextCode(0), CurCode(nullptr) {}
+
+  // setBlock - Start decoding at the first instruction of CurBB.
+  void setBlock() {
+    Code = &Slots->getBlockCode(*CurBB);
+    NextCode = 0;
+  }
+
+  // step - Make I, the instruction at CurInst, the instruction being executed.
+  void step(Instruction &I) {
+    if (!Code || Code->Stale || NextCode >= Code->Insts.size() ||
+        Code->Insts[NextCode].Inst != &I)
+      resync(I);
+    CurCode = &Code->Insts[NextCode++];
+  }
+
+  // resync - Find the decoded instruction for I, e.g. after the block it is
+  // in was decoded again.
+  void resync(Instruction &I);
+
+  // getSlotValue - Return the value plane entry for Slot, growing the plane if
+  // the slot was numbered after this frame was created.
+  GenericValue &getSlotValue(unsigned Slot) {
+    if (Slot >= Values.size())
+      Values.resize(Slots->getNumSlots());
+    return Values[Slot];
+  }
+
+  // getValue - Return the value plane entry for V.  The value and operands of
+  // the instruction being executed are found through their decoded slots,
+  // other values are looked up in the numbering.
+  GenericValue &getValue(const Value *V) {
+    if (CurCode) {
+      if (V == CurCode->Inst)
+        return getSlotValue(CurCode->Slot);
+      const Instruction *I = CurCode->Inst;
+      for (unsigned Op = 0, E = I->getNumOperands(); Op != E; ++Op)
+        if (I->getOperand(Op) == V && CurCode->OperandSlots[Op] !=
+                                          DecodedInst::NoSlot)
+          return getSlotValue(CurCode->OperandSlots[Op]);
+    }
+    return getSlotValue(Slots->getSlot(V));
+  }
 };
 
 // Interpreter - This class represents the entirety of the interpreter.
@@ -85,6 +184,9 @@ class Interpreter : public ExecutionEngine, public InstVisitor<Interpreter> {
   // registered with the atexit() library function.
   std::vector<Function*> AtExitHandlers;
 
+  // FunctionSlotMaps - Value numbering for each function that has been called.
+  DenseMap<const Function *, std::unique_ptr<FunctionSlots>> FunctionSlotMaps;
+
 public:
   explicit Interpreter(std::unique_ptr<Module> M);
   ~Interpreter() override;
@@ -194,6 +296,10 @@ private:  // Helper functions
   //
   void SwitchToNewBasicBlock(BasicBlock *Dest, ExecutionContext &SF);
 
+  // getFunctionSlots - Return the value numbering for F, computing it on the
+  // first call.
+  FunctionSlots &getFunctionSlots(const Function &F);
+
   void *getPointerToFunction(Function *F) override { return (void*)F; }
 
   void initializeExecutionEngine() { }
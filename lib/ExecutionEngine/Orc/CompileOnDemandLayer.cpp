@@ -71,8 +71,8 @@ static void extractAliases(MaterializationResponsibility &R, Module &M,
   R.replace(symbolAliases(std::move(Aliases)));
 }
 
-static std::unique_ptr<Module>
-extractAndClone(Module &M, LLVMContext &NewContext, StringRef Suffix,
+static ThreadSafeModule
+extractAndClone(Module &M, ThreadSafeContext NewTSCtx, StringRef Suffix,
                 function_ref<bool(const GlobalValue *)> ShouldCloneDefinition) {
   SmallVector<char, 1> ClonedModuleBuffer;
 
@@ -112,17 +112,18 @@ extractAndClone(Module &M, LLVMContext &NewContext, StringRef Suffix,
       StringRef(ClonedModuleBuffer.data(), ClonedModuleBuffer.size()),
       "cloned module buffer");
 
+  auto Lock = NewTSCtx.getLock();
   auto ClonedModule =
-      cantFail(parseBitcodeFile(ClonedModuleBufferRef, NewContext));
+      cantFail(parseBitcodeFile(ClonedModuleBufferRef, *NewTSCtx.getContext()));
   ClonedModule->setModuleIdentifier((M.getName() + Suffix).str());
-  return ClonedModule;
+  return ThreadSafeModule(std::move(ClonedModule), std::move(NewTSCtx));
 }
 
-static std::unique_ptr<Module> extractGlobals(Module &M,
-                                              LLVMContext &NewContext) {
-  return extractAndClone(M, NewContext, ".globals", [](const GlobalValue *GV) {
-    return isa<GlobalVariable>(GV);
-  });
+static ThreadSafeModule extractGlobals(Module &M, ThreadSafeContext NewTSCtx) {
+  return extractAndClone(M, std::move(NewTSCtx), ".globals",
+                         [](const GlobalValue *GV) {
+                           return isa<GlobalVariable>(GV);
+                         });
 }
 
 namespace llvm {
@@ -132,14 +133,14 @@ class ExtractingIRMaterializationUnit : public IRMaterializationUnit {
 public:
   ExtractingIRMaterializationUnit(ExecutionSession &ES,
                                   CompileOnDemandLayer2 &Parent,
-                                  std::unique_ptr<Module> M)
-      : IRMaterializationUnit(ES, std::move(M)), Parent(Parent) {}
+                                  ThreadSafeModule TSM)
+      : IRMaterializationUnit(ES, std::move(TSM)), Parent(Parent) {}
 
-  ExtractingIRMaterializationUnit(std::unique_ptr<Module> M,
+  ExtractingIRMaterializationUnit(ThreadSafeModule TSM,
                                   SymbolFlagsMap SymbolFlags,
                                   SymbolNameToDefinitionMap SymbolToDefinition,
                                   CompileOnDemandLayer2 &Parent)
-      : IRMaterializationUnit(std::move(M), std::move(SymbolFlags),
+      : IRMaterializationUnit(std::move(TSM), std::move(SymbolFlags),
                               std::move(SymbolToDefinition)),
         Parent(Parent) {}
 
@@ -153,7 +154,7 @@ private:
     auto RequestedSymbols = R.getRequestedSymbols();
 
     // Extract the requested functions into a new module.
-    std::unique_ptr<Module> ExtractedFunctionsModule;
+    ThreadSafeModule ExtractedFunctionsModule;
     if (!RequestedSymbols.empty()) {
       std::string Suffix;
       std::set<const GlobalValue *> FunctionsToClone;
@@ -166,9 +167,10 @@ private:
         Suffix += *Name;
       }
 
-      std::lock_guard<std::mutex> Lock(SourceModuleMutex);
+      auto Lock = TSM.getContextLock();
       ExtractedFunctionsModule =
-          extractAndClone(*M, Parent.GetAvailableContext(), Suffix,
+          extractAndClone(*TSM.getModule(), Parent.GetAvailableContext(),
+                          Suffix,
                           [&](const GlobalValue *GV) -> bool {
                             return FunctionsToClone.count(GV);
                           });
@@ -193,7 +195,7 @@ private:
              "SymbolFlags and SymbolToDefinition should have the same number "
              "of entries");
       R.replace(llvm::make_unique<ExtractingIRMaterializationUnit>(
-          std::move(M), std::move(DelegatedSymbolFlags),
+          std::move(TSM), std::move(DelegatedSymbolFlags),
           std::move(DelegatedSymbolToDefinition), Parent));
     }
 
@@ -209,7 +211,6 @@ private:
                      "ExtractingIRMaterializationUnit");
   }
 
-  mutable std::mutex SourceModuleMutex;
   CompileOnDemandLayer2 &Parent;
 };
 
@@ -222,14 +223,19 @@ CompileOnDemandLayer2::CompileOnDemandLayer2(
       GetAvailableContext(std::move(GetAvailableContext)) {}
 
 Error CompileOnDemandLayer2::add(VSO &V, VModuleKey K,
-                                 std::unique_ptr<Module> M) {
-  return IRLayer::add(V, K, std::move(M));
+                                 ThreadSafeModule TSM) {
+  return IRLayer::add(V, K, std::move(TSM));
 }
 
 void CompileOnDemandLayer2::emit(MaterializationResponsibility R, VModuleKey K,
-                                 std::unique_ptr<Module> M) {
+                                 ThreadSafeModule TSM) {
   auto &ES = getExecutionSession();
-  assert(M && "M should not be null");
+  assert(TSM.getModule() && "Module should not be null");
+
+  // The source module is rewritten in place below, so keep its context locked
+  // until ownership passes to the function-body-extracting unit.
+  auto Lock = TSM.getContextLock();
+  auto *M = TSM.getModule();
 
   for (auto &GV : M->global_values())
     if (GV.hasWeakLinkage())
@@ -269,13 +275,20 @@ void CompileOnDemandLayer2::emit(MaterializationResponsibility R, VModuleKey K,
     auto StubName = Mangle(StubUnmangledName);
     auto BodyName = Mangle(F.getName());
     if (auto CallbackAddr = CCMgr.getCompileCallback(
-            [BodyName, &TargetVSO, &ES]() -> JITTargetAddress {
-              if (auto Sym = lookup({&TargetVSO}, BodyName))
-                return Sym->getAddress();
-              else {
+            [this, StubName, BodyName, &TargetVSO, &ES]() -> JITTargetAddress {
+              auto Sym = lookup({&TargetVSO}, BodyName);
+              if (!Sym) {
                 ES.reportError(Sym.takeError());
                 return 0;
               }
+              // Point the stub straight at the body so that later calls skip
+              // the compile callback.
+              if (auto Err = getStubsManager(TargetVSO).updatePointer(
+                      *StubName, Sym->getAddress())) {
+                ES.reportError(std::move(Err));
+                return 0;
+              }
+              return Sym->getAddress();
             })) {
       auto Flags = JITSymbolFlags::fromGlobalValue(F);
       Flags &= ~JITSymbolFlags::Weak;
@@ -296,7 +309,7 @@ void CompileOnDemandLayer2::emit(MaterializationResponsibility R, VModuleKey K,
   // Build the function-body-extracting materialization unit.
   if (auto Err = R.getTargetVSO().define(
           llvm::make_unique<ExtractingIRMaterializationUnit>(ES, *this,
-                                                             std::move(M)))) {
+                                                             std::move(TSM)))) {
     ES.reportError(std::move(Err));
     R.failMaterialization();
     return;
@@ -334,9 +347,9 @@ IndirectStubsManager &CompileOnDemandLayer2::getStubsManager(const VSO &V) {
 }
 
 void CompileOnDemandLayer2::emitExtractedFunctionsModule(
-    MaterializationResponsibility R, std::unique_ptr<Module> M) {
+    MaterializationResponsibility R, ThreadSafeModule TSM) {
   auto K = getExecutionSession().allocateVModule();
-  BaseLayer.emit(std::move(R), std::move(K), std::move(M));
+  BaseLayer.emit(std::move(R), std::move(K), std::move(TSM));
 }
 
 } // end namespace orc
@@ -21,17 +21,44 @@ void IRCompileLayer2::setNotifyCompiled(NotifyCompiledFunction NotifyCompiled) {
   this->NotifyCompiled = std::move(NotifyCompiled);
 }
 
+void IRCompileLayer2::setObjectCache(ObjectCache *ObjCache) {
+  std::lock_guard<std::mutex> Lock(IRLayerMutex);
+  this->ObjCache = ObjCache;
+}
+
 void IRCompileLayer2::emit(MaterializationResponsibility R, VModuleKey K,
-                           std::unique_ptr<Module> M) {
-  assert(M && "Module must not be null");
+                           ThreadSafeModule TSM) {
+  assert(TSM.getModule() && "Module must not be null");
+
+  ObjectCache *Cache;
+  {
+    std::lock_guard<std::mutex> Lock(IRLayerMutex);
+    Cache = ObjCache;
+  }
+
+  // Hold the context lock for the duration of the compile: Other threads may
+  // be compiling or extracting modules that share this context.
+  auto Obj = [&]() -> Expected<std::unique_ptr<MemoryBuffer>> {
+    auto Lock = TSM.getContextLock();
+    auto &M = *TSM.getModule();
+
+    if (Cache)
+      if (auto CachedObj = Cache->getObject(&M))
+        return std::move(CachedObj);
+
+    auto Obj = Compile(M);
+    if (Cache && Obj && *Obj)
+      Cache->notifyObjectCompiled(&M, (*Obj)->getMemBufferRef());
+    return Obj;
+  }();
 
-  if (auto Obj = Compile(*M)) {
+  if (Obj) {
     {
       std::lock_guard<std::mutex> Lock(IRLayerMutex);
       if (NotifyCompiled)
-        NotifyCompiled(K, std::move(M));
+        NotifyCompiled(K, std::move(TSM));
       else
-        M = nullptr;
+        TSM = ThreadSafeModule();
     }
     BaseLayer.emit(std::move(R), std::move(K), std::move(*Obj));
   } else {
@@ -8,13 +8,22 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/ExecutionEngine/Orc/OrcError.h"
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
 #include "llvm/IR/Mangler.h"
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/TargetRegistry.h"
 
 namespace llvm {
 namespace orc {
 
+/// True on the threads of an LLJIT compile pool. Materializers block on
+/// lookups (e.g. when linking references to other JIT'd symbols), so any
+/// materialization dispatched from a compile thread has to run on that thread:
+/// queueing it behind the blocked thread could starve the pool.
+static LLVM_THREAD_LOCAL bool IsCompileThread = false;
+
 Expected<std::unique_ptr<LLJIT>>
 LLJIT::Create(std::unique_ptr<ExecutionSession> ES,
               std::unique_ptr<TargetMachine> TM, DataLayout DL) {
@@ -22,20 +31,46 @@ LLJIT::Create(std::unique_ptr<ExecutionSession> ES,
       new LLJIT(std::move(ES), std::move(TM), std::move(DL)));
 }
 
+Expected<std::unique_ptr<LLJIT>>
+LLJIT::Create(std::unique_ptr<ExecutionSession> ES,
+              JITTargetMachineBuilder JTMB, DataLayout DL,
+              unsigned NumCompileThreads) {
+#if !LLVM_ENABLE_THREADS
+  // Without threads the pool would defer all work until it is waited on,
+  // deadlocking the first blocking lookup. Compile on the calling thread.
+  NumCompileThreads = 0;
+#endif
+
+  if (NumCompileThreads == 0) {
+    auto TM = JTMB.createTargetMachine();
+    if (!TM)
+      return TM.takeError();
+    return Create(std::move(ES), std::move(*TM), std::move(DL));
+  }
+
+  return std::unique_ptr<LLJIT>(new LLJIT(std::move(ES), std::move(JTMB),
+                                          std::move(DL), NumCompileThreads));
+}
+
+LLJIT::~LLJIT() { waitForCompileThreads(); }
+
 Error LLJIT::defineAbsolute(StringRef Name, JITEvaluatedSymbol Sym) {
   auto InternedName = ES->getSymbolStringPool().intern(Name);
   SymbolMap Symbols({{InternedName, Sym}});
   return Main.define(absoluteSymbols(std::move(Symbols)));
 }
 
-Error LLJIT::addIRModule(VSO &V, std::unique_ptr<Module> M) {
-  assert(M && "Can not add null module");
+Error LLJIT::addIRModule(VSO &V, ThreadSafeModule TSM) {
+  assert(TSM && "Can not add null module");
 
-  if (auto Err = applyDataLayout(*M))
-    return Err;
+  {
+    auto Lock = TSM.getContextLock();
+    if (auto Err = applyDataLayout(*TSM.getModule()))
+      return Err;
+  }
 
   auto K = ES->allocateVModule();
-  return CompileLayer.add(V, K, std::move(M));
+  return CompileLayer.add(V, K, std::move(TSM));
 }
 
 Expected<JITEvaluatedSymbol> LLJIT::lookupLinkerMangled(VSO &V,
@@ -52,6 +87,41 @@ LLJIT::LLJIT(std::unique_ptr<ExecutionSession> ES,
       CompileLayer(*this->ES, ObjLinkingLayer, SimpleCompiler(*this->TM)),
       CtorRunner(Main), DtorRunner(Main) {}
 
+LLJIT::LLJIT(std::unique_ptr<ExecutionSession> ES,
+             JITTargetMachineBuilder JTMB, DataLayout DL,
+             unsigned NumCompileThreads)
+    : ES(std::move(ES)), Main(this->ES->createVSO("main")),
+      DL(std::move(DL)),
+      ObjLinkingLayer(*this->ES,
+                      [this](VModuleKey K) { return getMemoryManager(K); }),
+      CompileLayer(*this->ES, ObjLinkingLayer,
+                   MultiThreadedSimpleCompiler(std::move(JTMB))),
+      CtorRunner(Main), DtorRunner(Main) {
+  assert(NumCompileThreads != 0 &&
+         "Multithreaded LLJIT instance can not be created with 0 threads");
+
+  CompileThreads = llvm::make_unique<ThreadPool>(NumCompileThreads);
+  this->ES->setDispatchMaterialization(
+      [this](VSO &V, std::unique_ptr<MaterializationUnit> MU) {
+        if (IsCompileThread) {
+          MU->doMaterialize(V);
+          return;
+        }
+        // FIXME: Switch to move capture once we have c++14.
+        auto SharedMU = std::shared_ptr<MaterializationUnit>(std::move(MU));
+        auto Work = [SharedMU, &V]() {
+          IsCompileThread = true;
+          SharedMU->doMaterialize(V);
+        };
+        CompileThreads->async(std::move(Work));
+      });
+}
+
+void LLJIT::waitForCompileThreads() {
+  if (CompileThreads)
+    CompileThreads->wait();
+}
+
 std::shared_ptr<RuntimeDyld::MemoryManager>
 LLJIT::getMemoryManager(VModuleKey K) {
   return llvm::make_unique<SectionMemoryManager>();
@@ -85,8 +155,7 @@ void LLJIT::recordCtorDtors(Module &M) {
 
 Expected<std::unique_ptr<LLLazyJIT>>
 LLLazyJIT::Create(std::unique_ptr<ExecutionSession> ES,
-                  std::unique_ptr<TargetMachine> TM, DataLayout DL,
-                  LLVMContext &Ctx) {
+                  std::unique_ptr<TargetMachine> TM, DataLayout DL) {
   const Triple &TT = TM->getTargetTriple();
 
   auto CCMgr = createLocalCompileCallbackManager(TT, *ES, 0);
@@ -101,34 +170,123 @@ LLLazyJIT::Create(std::unique_ptr<ExecutionSession> ES,
         std::string("No indirect stubs manager builder for ") + TT.str(),
         inconvertibleErrorCode());
 
+  // Baseline tier code is generated without optimization (e.g. with FastISel).
+  std::unique_ptr<TargetMachine> BaselineTM(TM->getTarget().createTargetMachine(
+      TT.str(), TM->getTargetCPU(), TM->getTargetFeatureString(),
+      TM->Options, TM->getRelocationModel(), TM->getCodeModel(),
+      CodeGenOpt::None, /*JIT*/ true));
+  if (!BaselineTM)
+    return make_error<StringError>("Could not allocate target machine",
+                                   inconvertibleErrorCode());
+
+  return std::unique_ptr<LLLazyJIT>(
+      new LLLazyJIT(std::move(ES), std::move(TM), std::move(BaselineTM),
+                    std::move(DL), std::move(CCMgr), std::move(ISMBuilder)));
+}
+
+Expected<std::unique_ptr<LLLazyJIT>>
+LLLazyJIT::Create(std::unique_ptr<ExecutionSession> ES,
+                  JITTargetMachineBuilder JTMB, DataLayout DL,
+                  unsigned NumCompileThreads) {
+#if !LLVM_ENABLE_THREADS
+  NumCompileThreads = 0;
+#endif
+
+  if (NumCompileThreads == 0) {
+    auto TM = JTMB.createTargetMachine();
+    if (!TM)
+      return TM.takeError();
+    return Create(std::move(ES), std::move(*TM), std::move(DL));
+  }
+
+  const Triple &TT = JTMB.getTargetTriple();
+
+  auto CCMgr = createLocalCompileCallbackManager(TT, *ES, 0);
+  if (!CCMgr)
+    return make_error<StringError>(
+        std::string("No callback manager available for ") + TT.str(),
+        inconvertibleErrorCode());
+
+  auto ISMBuilder = createLocalIndirectStubsManagerBuilder(TT);
+  if (!ISMBuilder)
+    return make_error<StringError>(
+        std::string("No indirect stubs manager builder for ") + TT.str(),
+        inconvertibleErrorCode());
+
+  // Baseline tier code is generated without optimization (e.g. with FastISel).
+  auto BaselineJTMB = JTMB;
+  BaselineJTMB.setCodeGenOptLevel(CodeGenOpt::None);
+
   return std::unique_ptr<LLLazyJIT>(
-      new LLLazyJIT(std::move(ES), std::move(TM), std::move(DL), Ctx,
-                    std::move(CCMgr), std::move(ISMBuilder)));
+      new LLLazyJIT(std::move(ES), std::move(JTMB), std::move(BaselineJTMB),
+                    std::move(DL), NumCompileThreads, std::move(CCMgr),
+                    std::move(ISMBuilder)));
 }
 
-Error LLLazyJIT::addLazyIRModule(VSO &V, std::unique_ptr<Module> M) {
-  assert(M && "Can not add null module");
+LLLazyJIT::~LLLazyJIT() {
+  // Tier-ups and the compile threads may still be using the layers owned by
+  // this class. Tier-ups dispatch work to the compile threads, so wait for
+  // them first.
+  TieredLayer.waitForPendingTierUps();
+  waitForCompileThreads();
+}
 
-  if (auto Err = applyDataLayout(*M))
-    return Err;
+Error LLLazyJIT::addLazyIRModule(VSO &V, ThreadSafeModule TSM) {
+  assert(TSM && "Can not add null module");
 
-  makeAllSymbolsExternallyAccessible(*M);
+  {
+    auto Lock = TSM.getContextLock();
+    auto &M = *TSM.getModule();
 
-  recordCtorDtors(*M);
+    if (auto Err = applyDataLayout(M))
+      return Err;
+
+    makeAllSymbolsExternallyAccessible(M);
+
+    recordCtorDtors(M);
+  }
 
   auto K = ES->allocateVModule();
-  return CODLayer.add(V, K, std::move(M));
+  return CODLayer.add(V, K, std::move(TSM));
 }
 
 LLLazyJIT::LLLazyJIT(
     std::unique_ptr<ExecutionSession> ES, std::unique_ptr<TargetMachine> TM,
-    DataLayout DL, LLVMContext &Ctx,
+    std::unique_ptr<TargetMachine> BaselineTM, DataLayout DL,
     std::unique_ptr<JITCompileCallbackManager> CCMgr,
     std::function<std::unique_ptr<IndirectStubsManager>()> ISMBuilder)
     : LLJIT(std::move(ES), std::move(TM), std::move(DL)),
-      CCMgr(std::move(CCMgr)), TransformLayer(*this->ES, CompileLayer),
-      CODLayer(*this->ES, TransformLayer, *this->CCMgr, std::move(ISMBuilder),
-               [&]() -> LLVMContext & { return Ctx; }) {}
+      CCMgr(std::move(CCMgr)), BaselineTM(std::move(BaselineTM)),
+      BaselineCompileLayer(*this->ES, ObjLinkingLayer,
+                           SimpleCompiler(*this->BaselineTM)),
+      BaselineTransformLayer(*this->ES, BaselineCompileLayer),
+      TransformLayer(*this->ES, CompileLayer),
+      TieredLayer(*this->ES, BaselineTransformLayer, TransformLayer,
+                  ISMBuilder),
+      CODLayer(*this->ES, TieredLayer, *this->CCMgr, std::move(ISMBuilder),
+               createPartitionContext) {}
+
+LLLazyJIT::LLLazyJIT(
+    std::unique_ptr<ExecutionSession> ES, JITTargetMachineBuilder JTMB,
+    JITTargetMachineBuilder BaselineJTMB, DataLayout DL,
+    unsigned NumCompileThreads,
+    std::unique_ptr<JITCompileCallbackManager> CCMgr,
+    std::function<std::unique_ptr<IndirectStubsManager>()> ISMBuilder)
+    : LLJIT(std::move(ES), std::move(JTMB), std::move(DL), NumCompileThreads),
+      CCMgr(std::move(CCMgr)),
+      BaselineCompileLayer(
+          *this->ES, ObjLinkingLayer,
+          MultiThreadedSimpleCompiler(std::move(BaselineJTMB))),
+      BaselineTransformLayer(*this->ES, BaselineCompileLayer),
+      TransformLayer(*this->ES, CompileLayer),
+      TieredLayer(*this->ES, BaselineTransformLayer, TransformLayer,
+                  ISMBuilder),
+      CODLayer(*this->ES, TieredLayer, *this->CCMgr, std::move(ISMBuilder),
+               createPartitionContext) {}
+
+ThreadSafeContext LLLazyJIT::createPartitionContext() {
+  return ThreadSafeContext(llvm::make_unique<LLVMContext>());
+}
 
 } // End namespace orc.
 } // End namespace llvm.
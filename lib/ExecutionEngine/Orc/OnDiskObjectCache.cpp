@@ -0,0 +1,143 @@
+//===------ OnDiskObjectCache.cpp - Persistent object cache for the JIT ---===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/OnDiskObjectCache.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+/// Returns a string describing the parts of TM's configuration that affect
+/// the generated code.
+static std::string getTargetKey(const TargetMachine &TM) {
+  std::string Key;
+  raw_string_ostream OS(Key);
+
+  OS << TM.getTargetTriple().str() << '\0' << TM.getTargetCPU() << '\0'
+     << TM.getTargetFeatureString() << '\0';
+  OS << (unsigned)TM.getOptLevel() << ',' << (unsigned)TM.getRelocationModel()
+     << ',' << (unsigned)TM.getCodeModel();
+
+  // FIXME: Hash more of Options. This covers the options that JIT clients
+  //        commonly set.
+  const TargetOptions &Opts = TM.Options;
+  OS << ',' << Opts.UnsafeFPMath << Opts.NoInfsFPMath << Opts.NoNaNsFPMath
+     << Opts.NoTrappingFPMath << Opts.NoSignedZerosFPMath
+     << Opts.GuaranteedTailCallOpt << Opts.EnableFastISel
+     << Opts.EnableGlobalISel << Opts.RelaxELFRelocations
+     << Opts.FunctionSections << Opts.DataSections << Opts.EmulatedTLS
+     << Opts.EnableIPRA << Opts.TrapUnreachable;
+  OS << ',' << (unsigned)Opts.FloatABIType << ','
+     << (unsigned)Opts.AllowFPOpFusion << ',' << (unsigned)Opts.ThreadModel
+     << ',' << (unsigned)Opts.ExceptionModel << ','
+     << (unsigned)Opts.DebuggerTuning << ',' << Opts.StackAlignmentOverride;
+
+  return OS.str();
+}
+
+Expected<std::unique_ptr<OnDiskObjectCache>>
+OnDiskObjectCache::Create(StringRef CacheDir, const TargetMachine &TM,
+                          CachePruningPolicy Policy) {
+  if (auto EC = sys::fs::create_directories(CacheDir))
+    return errorCodeToError(EC);
+
+  return std::unique_ptr<OnDiskObjectCache>(
+      new OnDiskObjectCache(CacheDir, getTargetKey(TM), std::move(Policy)));
+}
+
+OnDiskObjectCache::OnDiskObjectCache(std::string CacheDir,
+                                     std::string TargetKey,
+                                     CachePruningPolicy Policy)
+    : CacheDir(std::move(CacheDir)), TargetKey(std::move(TargetKey)),
+      Policy(std::move(Policy)) {}
+
+OnDiskObjectCache::~OnDiskObjectCache() { prune(); }
+
+std::unique_ptr<MemoryBuffer> OnDiskObjectCache::getObject(const Module *M) {
+  std::string EntryPath = getEntryPath(*M);
+
+  // Open with OF_UpdateAtime so that pruning sees the entry as recently used.
+  int FD;
+  if (!sys::fs::openFileForRead(EntryPath, FD, sys::fs::OF_UpdateAtime)) {
+    auto Obj = MemoryBuffer::getOpenFile(FD, EntryPath, /*FileSize=*/-1,
+                                         /*RequiresNullTerminator=*/false);
+    sys::Process::SafelyCloseFileDescriptor(FD);
+    if (Obj)
+      return std::move(*Obj);
+  }
+
+  std::lock_guard<std::mutex> Lock(PendingEntriesMutex);
+  PendingEntries[M] = std::move(EntryPath);
+  return nullptr;
+}
+
+void OnDiskObjectCache::notifyObjectCompiled(const Module *M,
+                                             MemoryBufferRef Obj) {
+  std::string EntryPath;
+  {
+    std::lock_guard<std::mutex> Lock(PendingEntriesMutex);
+    auto I = PendingEntries.find(M);
+    if (I == PendingEntries.end())
+      return;
+    EntryPath = std::move(I->second);
+    PendingEntries.erase(I);
+  }
+
+  // Write to a temporary file and rename it into place, so that concurrent
+  // readers never see a partial entry.
+  SmallString<128> TempFileModel(CacheDir);
+  sys::path::append(TempFileModel, "Orc-%%%%%%.tmp.o");
+  auto Temp = sys::fs::TempFile::create(TempFileModel);
+  if (!Temp) {
+    consumeError(Temp.takeError());
+    return;
+  }
+
+  {
+    raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+    OS << Obj.getBuffer();
+  }
+
+  if (auto Err = Temp->keep(EntryPath)) {
+    consumeError(std::move(Err));
+    consumeError(Temp->discard());
+  }
+}
+
+void OnDiskObjectCache::prune() { pruneCache(CacheDir, Policy); }
+
+std::string OnDiskObjectCache::getEntryPath(const Module &M) {
+  SHA1 Hasher;
+  Hasher.update(LLVM_VERSION_STRING);
+  Hasher.update(TargetKey);
+
+  {
+    SmallVector<char, 0> Bitcode;
+    raw_svector_ostream OS(Bitcode);
+    WriteBitcodeToFile(M, OS);
+    Hasher.update(StringRef(Bitcode.data(), Bitcode.size()));
+  }
+
+  // This choice of file name allows the cache to be pruned (see pruneCache()
+  // in include/llvm/Support/CachePruning.h).
+  SmallString<128> EntryPath(CacheDir);
+  sys::path::append(EntryPath, "llvmcache-" + toHex(Hasher.result()));
+  return EntryPath.str();
+}
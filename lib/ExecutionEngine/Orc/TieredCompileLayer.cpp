@@ -0,0 +1,401 @@
+//===------ TieredCompileLayer.cpp - Tiered IR compilation ---------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/TieredCompileLayer.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/MDBuilder.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+/// Returns true if functions in M can be recompiled independently of the
+/// baseline code for M. An optimized copy of a function refers to the
+/// baseline module's globals by name, which is impossible for local globals,
+/// so only local constants (which can be duplicated) are permitted.
+static bool isTierable(const Module &M) {
+  for (auto &GV : M.globals())
+    if (GV.hasLocalLinkage() && !GV.isConstant())
+      return false;
+  return true;
+}
+
+static Constant *addressAsConstant(LLVMContext &Ctx, const DataLayout &DL,
+                                   uintptr_t Addr, Type *PtrTy) {
+  return ConstantExpr::getIntToPtr(
+      ConstantInt::get(DL.getIntPtrType(Ctx), Addr), PtrTy);
+}
+
+namespace llvm {
+namespace orc {
+
+TieredCompileLayer::TieredCompileLayer(
+    ExecutionSession &ES, IRLayer &BaselineLayer, IRLayer &OptimizedLayer,
+    IndirectStubsManagerBuilder BuildIndirectStubsManager,
+    unsigned NumOptimizeThreads)
+    : IRLayer(ES), BaselineLayer(BaselineLayer),
+      OptimizedLayer(OptimizedLayer),
+      BuildIndirectStubsManager(std::move(BuildIndirectStubsManager)),
+      NumOptimizeThreads(NumOptimizeThreads) {}
+
+TieredCompileLayer::~TieredCompileLayer() { waitForPendingTierUps(); }
+
+void TieredCompileLayer::setOptimizeTransform(
+    IRTransformLayer2::TransformFunction Optimize) {
+  std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+  this->Optimize = std::move(Optimize);
+}
+
+void TieredCompileLayer::setTierUpPolicy(TierUpPolicy Policy) {
+  std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+  this->Policy = std::move(Policy);
+}
+
+TieredCompileLayer::TierUpPolicy
+TieredCompileLayer::callCountThreshold(uint64_t Threshold) {
+  return [Threshold](const Function &) { return Threshold; };
+}
+
+Optional<TieredCompileLayer::FunctionTierState>
+TieredCompileLayer::getTierState(const VSO &V, const SymbolStringPtr &Name) {
+  std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+  auto I = TieredFunctions.find(std::make_pair(&V, Name));
+  if (I == TieredFunctions.end())
+    return None;
+  auto &TF = *I->second;
+  return FunctionTierState{TF.CurrentTier.load(), TF.CallCount.load()};
+}
+
+std::vector<std::pair<SymbolStringPtr, TieredCompileLayer::FunctionTierState>>
+TieredCompileLayer::getTierStates(const VSO &V) {
+  std::vector<std::pair<SymbolStringPtr, FunctionTierState>> States;
+  std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+  for (auto &KV : TieredFunctions) {
+    if (KV.first.first != &V)
+      continue;
+    auto &TF = *KV.second;
+    States.push_back(std::make_pair(
+        TF.Name,
+        FunctionTierState{TF.CurrentTier.load(), TF.CallCount.load()}));
+  }
+  return States;
+}
+
+Error TieredCompileLayer::tierUp(VSO &V, const SymbolStringPtr &Name) {
+  TieredFunction *TF = nullptr;
+  {
+    std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+    auto I = TieredFunctions.find(std::make_pair(&V, Name));
+    if (I == TieredFunctions.end())
+      return make_error<StringError>("Symbol " + *Name +
+                                         " is not a tiered function",
+                                     inconvertibleErrorCode());
+    TF = I->second.get();
+  }
+
+  Tier Expected = Tier::Baseline;
+  if (!TF->CurrentTier.compare_exchange_strong(Expected, Tier::Optimizing))
+    return Error::success();
+
+  return reoptimize(*TF);
+}
+
+void TieredCompileLayer::waitForPendingTierUps() {
+  ThreadPool *Pool = nullptr;
+  {
+    std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+    Pool = OptimizeThreads.get();
+  }
+  if (Pool)
+    Pool->wait();
+}
+
+void TieredCompileLayer::emit(MaterializationResponsibility R, VModuleKey K,
+                              ThreadSafeModule TSM) {
+  auto &ES = getExecutionSession();
+  assert(TSM.getModule() && "Module should not be null");
+
+  TierUpPolicy CurPolicy;
+  {
+    std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+    if (Optimize)
+      CurPolicy = Policy;
+  }
+
+  auto &TargetVSO = R.getTargetVSO();
+  auto RSymbols = R.getSymbols();
+
+  // Rename and instrument each tiered function, recording the name of its
+  // baseline body against its original (stub) name.
+  std::vector<TieredFunction *> NewTieredFunctions;
+  std::map<SymbolStringPtr, SymbolStringPtr> BaselineNames;
+  SymbolFlagsMap BaselineFlags;
+  {
+    auto Lock = TSM.getContextLock();
+    auto &M = *TSM.getModule();
+
+    MangleAndInterner Mangle(ES, M.getDataLayout());
+
+    std::vector<std::pair<Function *, uint64_t>> ToTier;
+    if (CurPolicy && isTierable(M)) {
+      for (auto &F : M) {
+        if (F.isDeclaration() || !F.hasName() || F.hasLocalLinkage() ||
+            F.hasAvailableExternallyLinkage())
+          continue;
+        if (!RSymbols.count(Mangle(F.getName())))
+          continue;
+        if (uint64_t Threshold = CurPolicy(F))
+          ToTier.push_back(std::make_pair(&F, Threshold));
+      }
+    }
+
+    if (!ToTier.empty()) {
+      // Take the pristine copy before any function is instrumented.
+      auto Pristine =
+          std::make_shared<ThreadSafeModule>(CloneModule(M), TSM.getContext());
+
+      for (auto &KV : ToTier) {
+        auto &F = *KV.first;
+        auto Name = Mangle(F.getName());
+        auto TF = llvm::make_unique<TieredFunction>(
+            *this, TargetVSO, Name, F.getName(),
+            JITSymbolFlags::stripTransientFlags(RSymbols[Name]), Pristine);
+
+        // Route calls from the rest of the module through the stub so that
+        // they pick up the optimized code too.
+        F.setName(F.getName() + "$tier0");
+        auto *StubDecl = cloneFunctionDecl(M, F);
+        StubDecl->setName(TF->IRName);
+        StubDecl->setPersonalityFn(nullptr);
+        StubDecl->setLinkage(GlobalValue::ExternalLinkage);
+        F.replaceAllUsesWith(StubDecl);
+
+        instrumentEntry(F, *TF, KV.second);
+
+        auto BaselineName = Mangle(F.getName());
+        BaselineFlags[BaselineName] = JITSymbolFlags::fromGlobalValue(F);
+        BaselineNames[Name] = std::move(BaselineName);
+        NewTieredFunctions.push_back(TF.get());
+
+        std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+        auto &Slot = TieredFunctions[std::make_pair(&TargetVSO, Name)];
+        assert(!Slot && "Function tiered twice");
+        Slot = std::move(TF);
+      }
+    }
+  }
+
+  if (NewTieredFunctions.empty()) {
+    OptimizedLayer.emit(std::move(R), std::move(K), std::move(TSM));
+    return;
+  }
+
+  // Split off responsibility for the stubs, take responsibility for the
+  // renamed baseline bodies, and pass the module on to the baseline layer.
+  SymbolNameSet StubNames;
+  for (auto &KV : BaselineNames)
+    StubNames.insert(KV.first);
+  auto StubsR = R.delegate(StubNames);
+
+  if (auto Err = R.defineMaterializing(BaselineFlags)) {
+    ES.reportError(std::move(Err));
+    R.failMaterialization();
+    StubsR.failMaterialization();
+    return;
+  }
+
+  BaselineLayer.emit(std::move(R), std::move(K), std::move(TSM));
+
+  // Point the stubs at the baseline bodies.
+  SymbolNameSet BaselineSymbols;
+  for (auto &KV : BaselineNames)
+    BaselineSymbols.insert(KV.second);
+  auto BaselineSyms = ES.lookup(
+      {&TargetVSO}, BaselineSymbols,
+      [&](const SymbolDependenceMap &Deps) {
+        StubsR.addDependenciesForAll(Deps);
+      },
+      false);
+  if (!BaselineSyms) {
+    ES.reportError(BaselineSyms.takeError());
+    StubsR.failMaterialization();
+    return;
+  }
+
+  IndirectStubsManager::StubInitsMap StubInits;
+  for (auto *TF : NewTieredFunctions)
+    StubInits[*TF->Name] = std::make_pair(
+        (*BaselineSyms)[BaselineNames[TF->Name]].getAddress(), TF->Flags);
+
+  auto &StubsMgr = getStubsManager(TargetVSO);
+  if (auto Err = StubsMgr.createStubs(StubInits)) {
+    ES.reportError(std::move(Err));
+    StubsR.failMaterialization();
+    return;
+  }
+
+  // Resolve the stubs with the flags StubsR has for them, less the transient
+  // Materializing flag.
+  auto StubFlags = StubsR.getSymbols();
+  SymbolMap ResolvedStubs;
+  for (auto *TF : NewTieredFunctions) {
+    auto Sym = StubsMgr.findStub(*TF->Name, false);
+    assert(Sym && "Stub went missing");
+    auto Flags = StubFlags[TF->Name];
+    Flags &= ~JITSymbolFlags::Materializing;
+    ResolvedStubs[TF->Name] = JITEvaluatedSymbol(Sym.getAddress(), Flags);
+  }
+
+  StubsR.resolve(ResolvedStubs);
+  StubsR.finalize();
+}
+
+void TieredCompileLayer::requestTierUpFromJITCode(void *TF) {
+  auto &F = *static_cast<TieredFunction *>(TF);
+  F.Parent.requestTierUp(F);
+}
+
+void TieredCompileLayer::instrumentEntry(Function &F, TieredFunction &TF,
+                                         uint64_t Threshold) {
+  auto &Ctx = F.getContext();
+  auto &DL = F.getParent()->getDataLayout();
+  auto *Int64Ty = Type::getInt64Ty(Ctx);
+  auto *Int8PtrTy = Type::getInt8PtrTy(Ctx);
+
+  // Keep the static allocas at the top of the entry block.
+  auto IP = F.getEntryBlock().getFirstInsertionPt();
+  while (isa<AllocaInst>(IP))
+    ++IP;
+
+  // Bump the counter, and call back into the layer on the call that reaches
+  // the threshold.
+  IRBuilder<> Builder(&*IP);
+  auto *Counter = addressAsConstant(
+      Ctx, DL, reinterpret_cast<uintptr_t>(&TF.CallCount),
+      Int64Ty->getPointerTo());
+  auto *OldCount =
+      Builder.CreateAtomicRMW(AtomicRMWInst::Add, Counter,
+                              ConstantInt::get(Int64Ty, 1),
+                              AtomicOrdering::Monotonic);
+  auto *IsHot =
+      Builder.CreateICmpEQ(OldCount, ConstantInt::get(Int64Ty, Threshold - 1));
+  auto *HotTerm = SplitBlockAndInsertIfThen(
+      IsHot, &*IP, false, MDBuilder(Ctx).createBranchWeights(1, 1 << 20));
+
+  Builder.SetInsertPoint(HotTerm);
+  auto *HookTy = FunctionType::get(Type::getVoidTy(Ctx), {Int8PtrTy}, false);
+  auto *Hook = addressAsConstant(
+      Ctx, DL, reinterpret_cast<uintptr_t>(&requestTierUpFromJITCode),
+      HookTy->getPointerTo());
+  Builder.CreateCall(
+      Hook, addressAsConstant(Ctx, DL, reinterpret_cast<uintptr_t>(&TF),
+                              Int8PtrTy));
+}
+
+IndirectStubsManager &TieredCompileLayer::getStubsManager(const VSO &V) {
+  std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+  StubManagersMap::iterator I = StubsMgrs.find(&V);
+  if (I == StubsMgrs.end())
+    I = StubsMgrs.insert(std::make_pair(&V, BuildIndirectStubsManager())).first;
+  return *I->second;
+}
+
+void TieredCompileLayer::requestTierUp(TieredFunction &TF) {
+  Tier Expected = Tier::Baseline;
+  if (!TF.CurrentTier.compare_exchange_strong(Expected, Tier::Optimizing))
+    return;
+
+#if LLVM_ENABLE_THREADS
+  ThreadPool *Pool = nullptr;
+  {
+    std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+    if (!OptimizeThreads)
+      OptimizeThreads = llvm::make_unique<ThreadPool>(NumOptimizeThreads);
+    Pool = OptimizeThreads.get();
+  }
+  Pool->async([this, &TF]() {
+    if (auto Err = reoptimize(TF))
+      getExecutionSession().reportError(std::move(Err));
+  });
+#else
+  if (auto Err = reoptimize(TF))
+    getExecutionSession().reportError(std::move(Err));
+#endif
+}
+
+Error TieredCompileLayer::reoptimize(TieredFunction &TF) {
+  auto &ES = getExecutionSession();
+  assert(TF.CurrentTier == Tier::Optimizing &&
+         "Function should be marked as optimizing");
+
+  // On failure leave the function running its baseline code.
+  auto Fail = [&TF](Error Err) {
+    TF.CurrentTier = Tier::Baseline;
+    return Err;
+  };
+
+  IRTransformLayer2::TransformFunction CurOptimize;
+  {
+    std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+    CurOptimize = Optimize;
+  }
+
+  // Clone the function (and any local constants it uses) out of the pristine
+  // module. Everything else is shared with the baseline code by name.
+  ThreadSafeModule OptimizedTSM;
+  SymbolStringPtr OptimizedName;
+  {
+    auto Lock = TF.Pristine->getContextLock();
+    auto &Src = *TF.Pristine->getModule();
+    ValueToValueMapTy VMap;
+    auto M = CloneModule(Src, VMap, [&](const GlobalValue *GV) {
+      return GV->hasLocalLinkage() || GV->getName() == TF.IRName;
+    });
+    M->setModuleIdentifier((Src.getName() + "." + TF.IRName + "$tier1").str());
+
+    auto *F = M->getFunction(TF.IRName);
+    assert(F && "Tiered function missing from pristine module");
+    F->setName(TF.IRName + "$tier1");
+    OptimizedName = MangleAndInterner(ES, M->getDataLayout())(F->getName());
+
+    OptimizedTSM = ThreadSafeModule(std::move(M), TF.Pristine->getContext());
+  }
+
+  if (CurOptimize) {
+    auto Optimized = [&]() {
+      auto Lock = OptimizedTSM.getContextLock();
+      return CurOptimize(std::move(OptimizedTSM));
+    }();
+    if (!Optimized)
+      return Fail(Optimized.takeError());
+    OptimizedTSM = std::move(*Optimized);
+  }
+
+  if (auto Err = OptimizedLayer.add(TF.V, ES.allocateVModule(),
+                               std::move(OptimizedTSM)))
+    return Fail(std::move(Err));
+
+  auto Sym = lookup({&TF.V}, OptimizedName);
+  if (!Sym)
+    return Fail(Sym.takeError());
+
+  if (auto Err = getStubsManager(TF.V).updatePointer(*TF.Name,
+                                                      Sym->getAddress()))
+    return Fail(std::move(Err));
+
+  TF.CurrentTier = Tier::Optimized;
+  TF.Pristine = nullptr;
+  return Error::success();
+}
+
+} // end namespace orc
+} // end namespace llvm
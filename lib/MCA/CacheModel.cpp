@@ -0,0 +1,129 @@
+//===------------------------- CacheModel.cpp -------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file implements a simple model of the data cache hierarchy.
+///
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MCA/CacheModel.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/MathExtras.h"
+
+#define DEBUG_TYPE "llvm-mca"
+
+namespace mca {
+
+using namespace llvm;
+
+Optional<uint64_t> AddressStreams::getAddress(unsigned SourceIndex,
+                                              unsigned NumInstructions) const {
+  unsigned Index = SourceIndex % NumInstructions;
+  if (Index >= Streams.size())
+    return None;
+
+  const Stream &S = Streams[Index];
+  unsigned Iteration = SourceIndex / NumInstructions;
+  if (!S.Trace.empty())
+    return S.Trace[Iteration % S.Trace.size()];
+  if (S.Base)
+    return *S.Base + static_cast<uint64_t>(S.Stride) * Iteration;
+  return None;
+}
+
+CacheModel::CacheLevel::CacheLevel(const CacheLevelDesc &Desc,
+                                   unsigned LineSize) {
+  unsigned NumLines = std::max(Desc.Size / LineSize, 1U);
+  NumWays = Desc.Associativity ? std::min(Desc.Associativity, NumLines)
+                               : NumLines;
+  NumSets = NumLines / NumWays;
+  Ways.assign(NumSets * NumWays, std::make_pair(0, 0));
+}
+
+bool CacheModel::CacheLevel::lookup(uint64_t Line, uint64_t Now) {
+  auto *Set = &Ways[(Line % NumSets) * NumWays];
+  for (unsigned I = 0; I < NumWays; ++I) {
+    if (Set[I].second && Set[I].first == Line) {
+      Set[I].second = Now;
+      return true;
+    }
+  }
+  return false;
+}
+
+void CacheModel::CacheLevel::insert(uint64_t Line, uint64_t Now) {
+  auto *Set = &Ways[(Line % NumSets) * NumWays];
+  auto *Victim = Set;
+  for (unsigned I = 1; I < NumWays; ++I)
+    if (Set[I].second < Victim->second)
+      Victim = &Set[I];
+  *Victim = std::make_pair(Line, Now);
+}
+
+CacheModel::CacheModel(const MemoryHierarchyDesc &Desc,
+                       const AddressStreams &Addresses,
+                       unsigned NumInstructions)
+    : Desc(Desc), Addresses(Addresses), NumInstructions(NumInstructions),
+      LineShift(Log2_32(Desc.LineSize)), Now(0) {
+  assert(isPowerOf2_32(Desc.LineSize) && "Invalid cache line size!");
+  for (const CacheLevelDesc &Level : Desc.Levels)
+    Levels.emplace_back(Level, Desc.LineSize);
+}
+
+unsigned CacheModel::accessLine(uint64_t Line) {
+  ++Now;
+  unsigned Level = 0;
+  for (unsigned E = Levels.size(); Level < E; ++Level)
+    if (Levels[Level].lookup(Line, Now))
+      break;
+
+  for (unsigned I = 0; I < Level; ++I)
+    Levels[I].insert(Line, Now);
+  return Level;
+}
+
+Optional<CacheAccess> CacheModel::access(const InstRef &IR) {
+  const InstrDesc &D = IR.getInstruction()->getDesc();
+  if (!D.MayLoad && !D.MayStore)
+    return None;
+
+  Optional<uint64_t> Address =
+      Addresses.getAddress(IR.getSourceIndex(), NumInstructions);
+  if (!Address)
+    return None;
+
+  uint64_t Line = *Address >> LineShift;
+  CacheAccess Access;
+  Access.Address = *Address;
+  Access.IsStore = !D.MayLoad;
+  Access.Level = accessLine(Line);
+  Access.StallCycles = 0;
+
+  if (!Access.IsStore && Access.Level) {
+    unsigned Latency = Access.Level < Levels.size()
+                           ? Desc.Levels[Access.Level].Latency
+                           : Desc.MemoryLatency;
+    // The scheduling model latency already accounts for an L1 hit.
+    Access.StallCycles = Latency - std::min(Latency, Desc.Levels[0].Latency);
+  }
+
+  // On an L1 miss, the next-line prefetcher brings the following lines in.
+  // Prefetches are assumed to complete before they are needed.
+  if (Access.Level)
+    for (unsigned I = 1; I <= Desc.PrefetchDegree; ++I)
+      accessLine(Line + I);
+
+  LLVM_DEBUG(dbgs() << "[CacheModel] Instruction #" << IR << " accessed 0x";
+             dbgs().write_hex(*Address);
+             dbgs() << ", serviced by level " << Access.Level << " (+"
+                    << Access.StallCycles << " cycles)\n");
+  return Access;
+}
+
+} // namespace mca
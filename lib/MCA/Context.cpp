@@ -15,14 +15,14 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#include "Context.h"
-#include "DispatchStage.h"
-#include "ExecuteStage.h"
-#include "FetchStage.h"
-#include "RegisterFile.h"
-#include "RetireControlUnit.h"
-#include "RetireStage.h"
-#include "Scheduler.h"
+#include "llvm/MCA/Context.h"
+#include "llvm/MCA/DispatchStage.h"
+#include "llvm/MCA/ExecuteStage.h"
+#include "llvm/MCA/FetchStage.h"
+#include "llvm/MCA/RegisterFile.h"
+#include "llvm/MCA/RetireControlUnit.h"
+#include "llvm/MCA/RetireStage.h"
+#include "llvm/MCA/Scheduler.h"
 
 namespace mca {
 
@@ -45,12 +45,21 @@ Context::createDefaultPipeline(const PipelineOptions &Opts, InstrBuilder &IB,
   auto D = llvm::make_unique<DispatchStage>(
       STI, MRI, Opts.RegisterFileSize, Opts.DispatchWidth, *RCU, *PRF, *HWS);
   auto R = llvm::make_unique<RetireStage>(*RCU, *PRF);
-  auto E = llvm::make_unique<ExecuteStage>(*RCU, *HWS);
+
+  std::unique_ptr<CacheModel> Caches;
+  if (Opts.MemoryHierarchy) {
+    assert(Opts.MemoryAddresses && "Cache model without addresses!");
+    Caches = llvm::make_unique<CacheModel>(
+        *Opts.MemoryHierarchy, *Opts.MemoryAddresses, SrcMgr.size());
+  }
+  auto E = llvm::make_unique<ExecuteStage>(*RCU, *HWS, Caches.get());
 
   // Add the hardware to the context.
   addHardwareUnit(std::move(RCU));
   addHardwareUnit(std::move(PRF));
   addHardwareUnit(std::move(HWS));
+  if (Caches)
+    addHardwareUnit(std::move(Caches));
 
   // Build the pipeline.
   P->appendStage(std::move(F));
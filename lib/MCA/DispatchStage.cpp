@@ -16,9 +16,9 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#include "DispatchStage.h"
-#include "HWEventListener.h"
-#include "Scheduler.h"
+#include "llvm/MCA/DispatchStage.h"
+#include "llvm/MCA/HWEventListener.h"
+#include "llvm/MCA/Scheduler.h"
 #include "llvm/Support/Debug.h"
 
 using namespace llvm;
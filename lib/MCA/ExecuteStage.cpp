@@ -15,9 +15,9 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#include "ExecuteStage.h"
-#include "Scheduler.h"
+#include "llvm/MCA/ExecuteStage.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/MCA/Scheduler.h"
 #include "llvm/Support/Debug.h"
 
 #define DEBUG_TYPE "llvm-mca"
@@ -52,6 +52,7 @@ void ExecuteStage::issueReadyInstructions() {
   SmallVector<InstRef, 4> InstructionIDs;
   InstRef IR = HWS.select();
   while (IR.isValid()) {
+    simulateMemoryAccess(IR);
     SmallVector<std::pair<ResourceRef, double>, 4> Used;
     HWS.issueInstruction(IR, Used);
 
@@ -139,6 +140,7 @@ bool ExecuteStage::execute(InstRef &IR) {
                     << " issued immediately\n");
 
   // Issue IR.  The resources for this issuance will be placed in 'Used.'
+  simulateMemoryAccess(IR);
   SmallVector<std::pair<ResourceRef, double>, 4> Used;
   HWS.issueInstruction(IR, Used);
 
@@ -151,6 +153,18 @@ bool ExecuteStage::execute(InstRef &IR) {
   return true;
 }
 
+void ExecuteStage::simulateMemoryAccess(InstRef &IR) {
+  if (!Caches)
+    return;
+
+  Optional<CacheAccess> Access = Caches->access(IR);
+  if (!Access)
+    return;
+
+  IR.getInstruction()->setMemoryStallCycles(Access->StallCycles);
+  notifyEvent<HWInstructionEvent>(HWMemoryAccessEvent(IR, *Access));
+}
+
 void ExecuteStage::notifyInstructionExecuted(const InstRef &IR) {
   HWS.onInstructionExecuted(IR);
   LLVM_DEBUG(dbgs() << "[E] Instruction Executed: #" << IR << '\n');
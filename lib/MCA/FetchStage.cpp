@@ -13,7 +13,7 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#include "FetchStage.h"
+#include "llvm/MCA/FetchStage.h"
 
 namespace mca {
 
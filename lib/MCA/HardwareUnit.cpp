@@ -13,7 +13,7 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#include "HardwareUnit.h"
+#include "llvm/MCA/HardwareUnit.h"
 
 namespace mca {
 
@@ -12,7 +12,7 @@
 //
 //===----------------------------------------------------------------------===//
 
-#include "Instruction.h"
+#include "llvm/MCA/Instruction.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -38,10 +38,10 @@ void ReadState::writeStartEvent(unsigned Cycles) {
   }
 }
 
-void WriteState::onInstructionIssued() {
+void WriteState::onInstructionIssued(unsigned ExtraLatency) {
   assert(CyclesLeft == UNKNOWN_CYCLES);
   // Update the number of cycles left based on the WriteDescriptor info.
-  CyclesLeft = getLatency();
+  CyclesLeft = getLatency() + ExtraLatency;
 
   // Now that the time left before write-back is known, notify
   // all the users.
@@ -120,10 +120,10 @@ void Instruction::execute() {
   Stage = IS_EXECUTING;
 
   // Set the cycles left before the write-back stage.
-  CyclesLeft = Desc.MaxLatency;
+  CyclesLeft = Desc.MaxLatency + MemoryStallCycles;
 
   for (UniqueDef &Def : Defs)
-    Def->onInstructionIssued();
+    Def->onInstructionIssued(MemoryStallCycles);
 
   // Transition to the "executed" stage if this is a zero-latency instruction.
   if (!CyclesLeft)
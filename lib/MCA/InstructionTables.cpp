@@ -15,7 +15,7 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#include "InstructionTables.h"
+#include "llvm/MCA/InstructionTables.h"
 
 namespace mca {
 
@@ -12,8 +12,8 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#include "LSUnit.h"
-#include "Instruction.h"
+#include "llvm/MCA/LSUnit.h"
+#include "llvm/MCA/Instruction.h"
 
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
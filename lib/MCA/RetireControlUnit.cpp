@@ -12,7 +12,7 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#include "RetireControlUnit.h"
+#include "llvm/MCA/RetireControlUnit.h"
 #include "llvm/Support/Debug.h"
 
 using namespace llvm;
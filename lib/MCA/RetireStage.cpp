@@ -14,8 +14,8 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#include "RetireStage.h"
-#include "HWEventListener.h"
+#include "llvm/MCA/RetireStage.h"
+#include "llvm/MCA/HWEventListener.h"
 #include "llvm/Support/Debug.h"
 
 using namespace llvm;
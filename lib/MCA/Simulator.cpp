@@ -0,0 +1,109 @@
+//===---------------------------- Simulator.cpp -----------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// A programmatic interface to the default out-of-order pipeline.
+///
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MCA/Simulator.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/MCA/HWEventListener.h"
+#include "llvm/MCA/Pipeline.h"
+#include "llvm/MCA/SourceMgr.h"
+#include "llvm/Support/MathExtras.h"
+
+namespace mca {
+
+using namespace llvm;
+
+namespace {
+
+/// Collects the statistics reported in a SimulationResult.
+class ResultCollector : public HWEventListener {
+  SimulationResult &Result;
+  DenseMap<unsigned, unsigned> Resource2UnitIndex;
+
+public:
+  ResultCollector(const MCSchedModel &SM, SimulationResult &Result)
+      : Result(Result) {
+    unsigned NumUnits = 0;
+    for (unsigned I = 0, E = SM.getNumProcResourceKinds(); I < E; ++I) {
+      const MCProcResourceDesc &ProcResource = *SM.getProcResource(I);
+      // Skip groups and invalid resources with zero units.
+      if (ProcResource.SubUnitsIdxBegin || !ProcResource.NumUnits)
+        continue;
+      Resource2UnitIndex[I] = NumUnits;
+      NumUnits += ProcResource.NumUnits;
+    }
+    Result.ResourcePressure.assign(NumUnits, 0.0);
+  }
+
+  void onCycleEnd() override { ++Result.TotalCycles; }
+
+  void onEvent(const HWInstructionEvent &Event) override {
+    if (Event.Type == HWInstructionEvent::Dispatched) {
+      ++Result.TotalInstructions;
+      Result.TotalUOps += Event.IR.getInstruction()->getDesc().NumMicroOps;
+      return;
+    }
+
+    if (Event.Type != HWInstructionEvent::Issued)
+      return;
+
+    const auto &IssueEvent =
+        static_cast<const HWInstructionIssuedEvent &>(Event);
+    for (const std::pair<ResourceRef, double> &Use : IssueEvent.UsedResources) {
+      const ResourceRef &RR = Use.first;
+      assert(Resource2UnitIndex.count(RR.first) && "Unknown resource!");
+      unsigned Index =
+          Resource2UnitIndex[RR.first] + countTrailingZeros(RR.second);
+      Result.ResourcePressure[Index] += Use.second;
+    }
+  }
+};
+
+} // end anonymous namespace
+
+Simulator::Simulator(const MCSubtargetInfo &STI, const MCInstrInfo &MCII,
+                     const MCRegisterInfo &MRI, const MCInstrAnalysis &MCIA,
+                     MCInstPrinter &MCIP, const PipelineOptions &Opts)
+    : STI(STI), MRI(MRI), IB(STI, MCII, MRI, MCIA, MCIP), Opts(Opts) {
+  if (!this->Opts.DispatchWidth)
+    this->Opts.DispatchWidth = STI.getSchedModel().IssueWidth;
+}
+
+SimulationResult Simulator::run(ArrayRef<MCInst> Insts, unsigned Iterations) {
+  SimulationResult Result;
+  if (Insts.empty())
+    return Result;
+
+  std::vector<std::unique_ptr<const MCInst>> Sequence;
+  Sequence.reserve(Insts.size());
+  for (const MCInst &MCI : Insts)
+    Sequence.emplace_back(llvm::make_unique<const MCInst>(MCI));
+
+  SourceMgr S(Sequence, Iterations);
+  Context Ctx(MRI, STI);
+  std::unique_ptr<Pipeline> P = Ctx.createDefaultPipeline(Opts, IB, S);
+  ResultCollector Collector(STI.getSchedModel(), Result);
+  P->addEventListener(&Collector);
+  P->run();
+
+  Result.Iterations = S.getNumIterations();
+  for (double &Pressure : Result.ResourcePressure)
+    Pressure /= Result.Iterations;
+
+  // Variant descriptors are keyed by MCInst address, so they must not outlive
+  // Sequence.
+  IB.clear();
+  return Result;
+}
+
+} // namespace mca
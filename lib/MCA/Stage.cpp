@@ -13,7 +13,7 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#include "Stage.h"
+#include "llvm/MCA/Stage.h"
 
 namespace mca {
 
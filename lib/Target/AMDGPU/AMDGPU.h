@@ -170,6 +170,10 @@ extern char &AMDGPUAnnotateUniformValuesPassID;
 void initializeAMDGPUCodeGenPreparePass(PassRegistry&);
 extern char &AMDGPUCodeGenPrepareID;
 
+FunctionPass *createAMDGPUInsertReadFirstLanePass();
+void initializeAMDGPUInsertReadFirstLanePass(PassRegistry&);
+extern char &AMDGPUInsertReadFirstLaneID;
+
 void initializeSIAnnotateControlFlowPass(PassRegistry&);
 extern char &SIAnnotateControlFlowPassID;
 
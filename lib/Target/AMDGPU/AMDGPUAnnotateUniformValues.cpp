@@ -16,11 +16,14 @@
 #include "AMDGPU.h"
 #include "AMDGPUIntrinsicInfo.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/KernelDivergenceAnalysis.h"
-#include "llvm/Analysis/LoopInfo.h"
-#include "llvm/Analysis/MemoryDependenceAnalysis.h"
+#include "llvm/Analysis/MemorySSA.h"
+#include "llvm/Analysis/ValueTracking.h"
 #include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/InstVisitor.h"
+#include "llvm/IR/IntrinsicInst.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -33,9 +36,16 @@ namespace {
 class AMDGPUAnnotateUniformValues : public FunctionPass,
                        public InstVisitor<AMDGPUAnnotateUniformValues> {
   KernelDivergenceAnalysis *DA;
-  MemoryDependenceResults *MDR;
-  LoopInfo *LI;
+  MemorySSA *MSSA;
+  AliasAnalysis *AA;
   DenseMap<Value*, GetElementPtrInst*> noClobberClones;
+  // The underlying objects written by the MemoryDefs of the function, and
+  // whether one of them may write to any memory.
+  SmallSetVector<const Value *, 8> WrittenObjects;
+  bool WritesUnknownMemory;
+  // For each underlying object of a load, whether the function may write to
+  // it.
+  DenseMap<const Value *, bool> MayWriteObject;
   bool isKernelFunc;
   AMDGPUAS AMDGPUASI;
 
@@ -50,13 +60,14 @@ public:
   }
   void getAnalysisUsage(AnalysisUsage &AU) const override {
     AU.addRequired<KernelDivergenceAnalysis>();
-    AU.addRequired<MemoryDependenceWrapperPass>();
-    AU.addRequired<LoopInfoWrapperPass>();
+    AU.addRequired<MemorySSAWrapperPass>();
+    AU.addRequired<AAResultsWrapperPass>();
     AU.setPreservesAll();
  }
 
   void visitBranchInst(BranchInst &I);
   void visitLoadInst(LoadInst &I);
+  void collectWrittenObjects(Function &F);
   bool isClobberedInFunction(LoadInst * Load);
 };
 
@@ -65,8 +76,8 @@ public:
 INITIALIZE_PASS_BEGIN(AMDGPUAnnotateUniformValues, DEBUG_TYPE,
                       "Add AMDGPU uniform metadata", false, false)
 INITIALIZE_PASS_DEPENDENCY(KernelDivergenceAnalysis)
-INITIALIZE_PASS_DEPENDENCY(MemoryDependenceWrapperPass)
-INITIALIZE_PASS_DEPENDENCY(LoopInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(MemorySSAWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(AAResultsWrapperPass)
 INITIALIZE_PASS_END(AMDGPUAnnotateUniformValues, DEBUG_TYPE,
                     "Add AMDGPU uniform metadata", false, false)
 
@@ -79,42 +90,54 @@ static void setNoClobberMetadata(Instruction *I) {
   I->setMetadata("amdgpu.noclobber", MDNode::get(I->getContext(), {}));
 }
 
-static void DFS(BasicBlock *Root, SetVector<BasicBlock*> & Set) {
-  for (auto I : predecessors(Root))
-    if (Set.insert(I))
-      DFS(I, Set);
+/// Returns the underlying object of the memory written by \p I, or null if
+/// it may write to any memory.
+static const Value *getWrittenObject(Instruction *I, const DataLayout &DL) {
+  Value *Ptr = nullptr;
+  if (auto *SI = dyn_cast<StoreInst>(I))
+    Ptr = SI->getPointerOperand();
+  else if (auto *RMW = dyn_cast<AtomicRMWInst>(I))
+    Ptr = RMW->getPointerOperand();
+  else if (auto *CmpX = dyn_cast<AtomicCmpXchgInst>(I))
+    Ptr = CmpX->getPointerOperand();
+  else if (auto *MI = dyn_cast<AnyMemIntrinsic>(I))
+    Ptr = MI->getRawDest();
+  return Ptr ? GetUnderlyingObject(Ptr, DL, /*MaxLookup=*/0) : nullptr;
 }
 
-bool AMDGPUAnnotateUniformValues::isClobberedInFunction(LoadInst * Load) {
-  // 1. get Loop for the Load->getparent();
-  // 2. if it exists, collect all the BBs from the most outer
-  // loop and check for the writes. If NOT - start DFS over all preds.
-  // 3. Start DFS over all preds from the most outer loop header.
-  SetVector<BasicBlock *> Checklist;
-  BasicBlock *Start = Load->getParent();
-  Checklist.insert(Start);
-  const Value *Ptr = Load->getPointerOperand();
-  const Loop *L = LI->getLoopFor(Start);
-  if (L) {
-    const Loop *P = L;
-    do {
-      L = P;
-      P = P->getParentLoop();
-    } while (P);
-    Checklist.insert(L->block_begin(), L->block_end());
-    Start = L->getHeader();
+void AMDGPUAnnotateUniformValues::collectWrittenObjects(Function &F) {
+  const DataLayout &DL = F.getParent()->getDataLayout();
+  WritesUnknownMemory = false;
+  for (Instruction &I : instructions(F)) {
+    if (!dyn_cast_or_null<MemoryDef>(MSSA->getMemoryAccess(&I)))
+      continue;
+    if (const Value *Object = getWrittenObject(&I, DL))
+      WrittenObjects.insert(Object);
+    else
+      WritesUnknownMemory = true;
   }
+}
 
-  DFS(Start, Checklist);
-  for (auto &BB : Checklist) {
-    BasicBlock::iterator StartIt = (!L && (BB == Load->getParent())) ?
-      BasicBlock::iterator(Load) : BB->end();
-    auto Q = MDR->getPointerDependencyFrom(MemoryLocation(Ptr), true,
-                                           StartIt, BB, Load);
-    if (Q.isClobber() || Q.isUnknown())
-      return true;
-  }
-  return false;
+bool AMDGPUAnnotateUniformValues::isClobberedInFunction(LoadInst * Load) {
+  // Most uniform loads read objects that the kernel never writes to, which
+  // is answered once per underlying object.
+  const DataLayout &DL = Load->getModule()->getDataLayout();
+  const Value *Object =
+      GetUnderlyingObject(Load->getPointerOperand(), DL, /*MaxLookup=*/0);
+  auto Cached = MayWriteObject.insert({Object, true});
+  if (Cached.second)
+    Cached.first->second =
+        WritesUnknownMemory ||
+        any_of(WrittenObjects, [&](const Value *Written) {
+          return AA->alias(Written, Object) != NoAlias;
+        });
+  if (!Cached.first->second)
+    return false;
+
+  // Otherwise, the load is not clobbered if no MemoryDef may write to its
+  // location on any path from the entry of the function.
+  MemoryAccess *Clobber = MSSA->getWalker()->getClobberingMemoryAccess(Load);
+  return !MSSA->isLiveOnEntryDef(Clobber);
 }
 
 void AMDGPUAnnotateUniformValues::visitBranchInst(BranchInst &I) {
@@ -176,13 +199,17 @@ bool AMDGPUAnnotateUniformValues::runOnFunction(Function &F) {
   if (skipFunction(F))
     return false;
 
-  DA  = &getAnalysis<KernelDivergenceAnalysis>();
-  MDR = &getAnalysis<MemoryDependenceWrapperPass>().getMemDep();
-  LI  = &getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
+  DA   = &getAnalysis<KernelDivergenceAnalysis>();
+  MSSA = &getAnalysis<MemorySSAWrapperPass>().getMSSA();
+  AA   = &getAnalysis<AAResultsWrapperPass>().getAAResults();
   isKernelFunc = F.getCallingConv() == CallingConv::AMDGPU_KERNEL;
 
+  if (isKernelFunc)
+    collectWrittenObjects(F);
   visit(F);
   noClobberClones.clear();
+  WrittenObjects.clear();
+  MayWriteObject.clear();
   return true;
 }
 
@@ -209,5 +209,6 @@ InlineCost AMDGPUInliner::getInlineCost(CallSite CS) {
   };
 
   return llvm::getInlineCost(CS, Callee, LocalParams, TTI, GetAssumptionCache,
-                             None, PSI, RemarksEnabled ? &ORE : nullptr);
+                             None, PSI, RemarksEnabled ? &ORE : nullptr,
+                             &CalleeSummaries);
 }
@@ -0,0 +1,287 @@
+//===-- AMDGPUInsertReadFirstLane.cpp - Move uniform values to SGPRs ------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// This pass inserts llvm.amdgcn.readfirstlane after the loads that the
+/// divergence analysis proves uniform, but that are not selected as scalar
+/// loads and so return their result in a VGPR. Reading the first lane moves
+/// the value to an SGPR, so that the uniform integer arithmetic computed from
+/// it is selected to SALU instructions instead of VALU ones, and the VGPRs
+/// that held the value and its users are freed.
+///
+/// A value is only moved if the SALU instructions it enables outnumber the
+/// readfirstlanes inserted for it.
+//
+//===----------------------------------------------------------------------===//
+
+#include "AMDGPU.h"
+#include "AMDGPUSubtarget.h"
+#include "AMDGPUTargetMachine.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/KernelDivergenceAnalysis.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/CodeGen/TargetPassConfig.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Intrinsics.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+
+#define DEBUG_TYPE "amdgpu-insert-readfirstlane"
+
+using namespace llvm;
+
+STATISTIC(NumReadFirstLanes, "Number of readfirstlanes inserted");
+
+static cl::opt<unsigned> ReadFirstLaneCost(
+  "amdgpu-readfirstlane-cost",
+  cl::desc("Cost of a readfirstlane, in SALU instructions it has to enable"),
+  cl::init(1), cl::Hidden);
+
+static cl::opt<unsigned> MaxUsersVisited(
+  "amdgpu-readfirstlane-max-users",
+  cl::desc("Maximum number of transitive users of a value visited to estimate "
+           "the SALU instructions moving it to an SGPR enables"),
+  cl::init(32), cl::Hidden);
+
+namespace {
+
+class AMDGPUInsertReadFirstLane : public FunctionPass {
+  const GCNSubtarget *ST = nullptr;
+  KernelDivergenceAnalysis *DA = nullptr;
+  LoopInfo *LI = nullptr;
+  AMDGPUAS AMDGPUASI;
+
+  bool isScalarLoad(const LoadInst &Load) const;
+  bool isCandidate(const LoadInst &Load) const;
+  bool canReadFirstLane(const Instruction &Def, const Use &U) const;
+  unsigned getSALUSavings(const Instruction &Def) const;
+  void insertReadFirstLane(Instruction &Def);
+
+public:
+  static char ID;
+
+  AMDGPUInsertReadFirstLane() : FunctionPass(ID) {}
+
+  bool doInitialization(Module &M) override;
+  bool runOnFunction(Function &F) override;
+
+  StringRef getPassName() const override {
+    return "AMDGPU Insert ReadFirstLane";
+  }
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override {
+    AU.addRequired<KernelDivergenceAnalysis>();
+    AU.addRequired<LoopInfoWrapperPass>();
+    AU.setPreservesCFG();
+  }
+};
+
+} // end anonymous namespace
+
+INITIALIZE_PASS_BEGIN(AMDGPUInsertReadFirstLane, DEBUG_TYPE,
+                      "AMDGPU Insert ReadFirstLane", false, false)
+INITIALIZE_PASS_DEPENDENCY(KernelDivergenceAnalysis)
+INITIALIZE_PASS_DEPENDENCY(LoopInfoWrapperPass)
+INITIALIZE_PASS_END(AMDGPUInsertReadFirstLane, DEBUG_TYPE,
+                    "AMDGPU Insert ReadFirstLane", false, false)
+
+char AMDGPUInsertReadFirstLane::ID = 0;
+
+char &llvm::AMDGPUInsertReadFirstLaneID = AMDGPUInsertReadFirstLane::ID;
+
+/// Returns true if \p Load is selected as a scalar load, with the same
+/// conditions as SITargetLowering::LowerLOAD.
+bool AMDGPUInsertReadFirstLane::isScalarLoad(const LoadInst &Load) const {
+  unsigned AS = Load.getPointerAddressSpace();
+  if (Load.getAlignment() < 4 || Load.isVolatile())
+    return false;
+  if (AS == AMDGPUASI.CONSTANT_ADDRESS ||
+      AS == AMDGPUASI.CONSTANT_ADDRESS_32BIT)
+    return true;
+  if (AS != AMDGPUASI.GLOBAL_ADDRESS || !ST->getScalarizeGlobalBehavior())
+    return false;
+  const auto *Ptr = dyn_cast<Instruction>(Load.getPointerOperand());
+  return Ptr && Ptr->getMetadata("amdgpu.noclobber");
+}
+
+/// Returns true if \p Load returns a uniform value in a VGPR, of a type
+/// readfirstlane can be applied to, one dword at a time.
+bool AMDGPUInsertReadFirstLane::isCandidate(const LoadInst &Load) const {
+  Type *Ty = Load.getType();
+  if (!Ty->isIntegerTy() && !Ty->isFloatingPointTy() && !Ty->isPointerTy())
+    return false;
+  unsigned Size = Load.getModule()->getDataLayout().getTypeSizeInBits(Ty);
+  if (Size != 32 && Size != 64)
+    return false;
+  if (Load.isAtomic() || DA->isDivergent(&Load))
+    return false;
+  return Load.getPointerAddressSpace() != AMDGPUASI.PRIVATE_ADDRESS &&
+         !isScalarLoad(Load);
+}
+
+/// Returns true if the use \p U of \p Def may read the first lane of \p Def.
+/// The divergence analysis only proves \p Def uniform where it is defined:
+/// threads that leave a loop in different iterations see the values of
+/// different iterations after the loop.
+bool AMDGPUInsertReadFirstLane::canReadFirstLane(const Instruction &Def,
+                                                 const Use &U) const {
+  const Loop *DefLoop = LI->getLoopFor(Def.getParent());
+  if (!DefLoop)
+    return true;
+  const auto *User = cast<Instruction>(U.getUser());
+  const BasicBlock *UseBB = User->getParent();
+  if (const auto *Phi = dyn_cast<PHINode>(User))
+    UseBB = Phi->getIncomingBlock(U);
+  return DefLoop->contains(UseBB);
+}
+
+/// Returns the number of VALU instructions computed from \p Def that become
+/// SALU instructions once \p Def is in an SGPR: the uniform integer
+/// operations reached from \p Def through other such operations.
+unsigned AMDGPUInsertReadFirstLane::getSALUSavings(const Instruction &Def) const {
+  const DataLayout &DL = Def.getModule()->getDataLayout();
+  SmallVector<const Use *, 16> Worklist;
+  SmallPtrSet<const Instruction *, 16> Visited;
+  for (const Use &U : Def.uses())
+    if (canReadFirstLane(Def, U))
+      Worklist.push_back(&U);
+
+  unsigned Savings = 0;
+  while (!Worklist.empty() && Visited.size() < MaxUsersVisited) {
+    const auto *User = cast<Instruction>(Worklist.pop_back_val()->getUser());
+    if (!Visited.insert(User).second || DA->isDivergent(User))
+      continue;
+
+    Type *Ty = User->getType();
+    bool IsSALU;
+    switch (User->getOpcode()) {
+    case Instruction::Add:
+    case Instruction::Sub:
+    case Instruction::Mul:
+    case Instruction::Shl:
+    case Instruction::LShr:
+    case Instruction::AShr:
+    case Instruction::And:
+    case Instruction::Or:
+    case Instruction::Xor:
+    case Instruction::Trunc:
+    case Instruction::ZExt:
+    case Instruction::SExt:
+    case Instruction::Select:
+      IsSALU = Ty->isIntegerTy();
+      break;
+    case Instruction::ICmp:
+    case Instruction::GetElementPtr:
+    case Instruction::PtrToInt:
+    case Instruction::IntToPtr:
+      IsSALU = !Ty->isVectorTy();
+      break;
+    default:
+      IsSALU = false;
+      break;
+    }
+    if (!IsSALU)
+      continue;
+
+    // 64-bit operations are mostly split into two 32-bit ones.
+    Savings += Ty->isIntegerTy(1) || DL.getTypeSizeInBits(Ty) <= 32 ? 1 : 2;
+    for (const Use &U : User->uses())
+      Worklist.push_back(&U);
+  }
+  return Savings;
+}
+
+void AMDGPUInsertReadFirstLane::insertReadFirstLane(Instruction &Def) {
+  const DataLayout &DL = Def.getModule()->getDataLayout();
+  Type *Ty = Def.getType();
+  unsigned NumDwords = DL.getTypeSizeInBits(Ty) / 32;
+
+  SmallVector<Use *, 8> Uses;
+  for (Use &U : Def.uses())
+    if (canReadFirstLane(Def, U))
+      Uses.push_back(&U);
+
+  IRBuilder<> Builder(Def.getNextNode());
+  Builder.SetCurrentDebugLocation(Def.getDebugLoc());
+  Function *ReadFirstLane =
+      Intrinsic::getDeclaration(Def.getModule(), Intrinsic::amdgcn_readfirstlane);
+
+  Type *IntTy = Builder.getIntNTy(NumDwords * 32);
+  Value *Int = Ty->isPointerTy() ? Builder.CreatePtrToInt(&Def, IntTy)
+                                 : Builder.CreateBitCast(&Def, IntTy);
+  Value *Res;
+  if (NumDwords == 1) {
+    Res = Builder.CreateCall(ReadFirstLane, Int);
+  } else {
+    Type *VecTy = VectorType::get(Builder.getInt32Ty(), NumDwords);
+    Value *Vec = Builder.CreateBitCast(Int, VecTy);
+    Res = UndefValue::get(VecTy);
+    for (unsigned I = 0; I != NumDwords; ++I) {
+      Value *Elt = Builder.CreateExtractElement(Vec, I);
+      Res = Builder.CreateInsertElement(
+          Res, Builder.CreateCall(ReadFirstLane, Elt), I);
+    }
+    Res = Builder.CreateBitCast(Res, IntTy);
+  }
+  Res = Ty->isPointerTy() ? Builder.CreateIntToPtr(Res, Ty)
+                          : Builder.CreateBitCast(Res, Ty);
+  Res->setName(Def.getName() + ".readfirstlane");
+
+  for (Use *U : Uses)
+    U->set(Res);
+  NumReadFirstLanes += NumDwords;
+}
+
+bool AMDGPUInsertReadFirstLane::doInitialization(Module &M) {
+  AMDGPUASI = AMDGPU::getAMDGPUAS(M);
+  return false;
+}
+
+bool AMDGPUInsertReadFirstLane::runOnFunction(Function &F) {
+  if (skipFunction(F))
+    return false;
+
+  auto *TPC = getAnalysisIfAvailable<TargetPassConfig>();
+  if (!TPC)
+    return false;
+
+  const AMDGPUTargetMachine &TM = TPC->getTM<AMDGPUTargetMachine>();
+  ST = &TM.getSubtarget<GCNSubtarget>(F);
+  DA = &getAnalysis<KernelDivergenceAnalysis>();
+  LI = &getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
+
+  SmallVector<LoadInst *, 8> Candidates;
+  for (BasicBlock &BB : F) {
+    for (Instruction &I : BB) {
+      auto *Load = dyn_cast<LoadInst>(&I);
+      if (!Load || !isCandidate(*Load))
+        continue;
+      unsigned Cost = ReadFirstLaneCost *
+          (F.getParent()->getDataLayout().getTypeSizeInBits(Load->getType()) /
+           32);
+      unsigned Savings = getSALUSavings(*Load);
+      LLVM_DEBUG(dbgs() << "Uniform VGPR load " << *Load << ": cost " << Cost
+                        << ", SALU savings " << Savings << '\n');
+      if (Savings > Cost)
+        Candidates.push_back(Load);
+    }
+  }
+
+  for (LoadInst *Load : Candidates)
+    insertReadFirstLane(*Load);
+  return !Candidates.empty();
+}
+
+FunctionPass *llvm::createAMDGPUInsertReadFirstLanePass() {
+  return new AMDGPUInsertReadFirstLane();
+}
@@ -137,6 +137,12 @@ static cl::opt<bool> EnableLowerKernelArguments(
   cl::init(true),
   cl::Hidden);
 
+static cl::opt<bool> EnableInsertReadFirstLane(
+  "amdgpu-readfirstlane-loads",
+  cl::desc("Move uniform values loaded to VGPRs to SGPRs with readfirstlane"),
+  cl::init(false),
+  cl::Hidden);
+
 extern "C" void LLVMInitializeAMDGPUTarget() {
   // Register the target
   RegisterTargetMachine<R600TargetMachine> X(getTheAMDGPUTarget());
@@ -168,6 +174,7 @@ extern "C" void LLVMInitializeAMDGPUTarget() {
   initializeAMDGPUOpenCLEnqueuedBlockLoweringPass(*PR);
   initializeAMDGPUPromoteAllocaPass(*PR);
   initializeAMDGPUCodeGenPreparePass(*PR);
+  initializeAMDGPUInsertReadFirstLanePass(*PR);
   initializeAMDGPURewriteOutArgumentsPass(*PR);
   initializeAMDGPUUnifyMetadataPass(*PR);
   initializeSIAnnotateControlFlowPass(*PR);
@@ -771,6 +778,9 @@ bool GCNPassConfig::addPreISel() {
   }
   addPass(createSinkingPass());
   addPass(createAMDGPUAnnotateUniformValues());
+  // After AMDGPUAnnotateUniformValues, which tells which loads are scalar.
+  if (EnableInsertReadFirstLane)
+    addPass(createAMDGPUInsertReadFirstLanePass());
   if (!LateCFGStructurize) {
     addPass(createSIAnnotateControlFlowPass());
   }
@@ -4966,6 +4966,73 @@ bool SIInstrInfo::isBasicBlockPrologue(const MachineInstr &MI) const {
          MI.modifiesRegister(AMDGPU::EXEC, &RI);
 }
 
+InstructionUniformity
+SIInstrInfo::getInstructionUniformity(const MachineInstr &MI) const {
+  unsigned Opcode = MI.getOpcode();
+  switch (Opcode) {
+  // The lane that is read is the same in all the threads.
+  case AMDGPU::V_READFIRSTLANE_B32:
+  case AMDGPU::V_READLANE_B32:
+    return InstructionUniformity::AlwaysUniform;
+
+  // The control flow pseudos are only selected for divergent branches, and
+  // their results are masks of the active lanes.
+  case AMDGPU::SI_IF:
+  case AMDGPU::SI_ELSE:
+  case AMDGPU::SI_LOOP:
+  case AMDGPU::SI_IF_BREAK:
+  case AMDGPU::SI_ELSE_BREAK:
+  case AMDGPU::SI_BREAK:
+  // These depend on the lane that executes them.
+  case AMDGPU::V_MBCNT_LO_U32_B32_e32:
+  case AMDGPU::V_MBCNT_LO_U32_B32_e64:
+  case AMDGPU::V_MBCNT_HI_U32_B32_e32:
+  case AMDGPU::V_MBCNT_HI_U32_B32_e64:
+  case AMDGPU::V_WRITELANE_B32:
+  case AMDGPU::DS_SWIZZLE_B32:
+  case AMDGPU::DS_PERMUTE_B32:
+  case AMDGPU::DS_BPERMUTE_B32:
+    return InstructionUniformity::NeverUniform;
+
+  case AMDGPU::G_INTRINSIC:
+  case AMDGPU::G_INTRINSIC_W_SIDE_EFFECTS: {
+    unsigned IntrID = MI.getOperand(MI.getNumExplicitDefs()).getIntrinsicID();
+    return AMDGPU::isIntrinsicSourceOfDivergence(IntrID)
+               ? InstructionUniformity::NeverUniform
+               : InstructionUniformity::Default;
+  }
+  default:
+    break;
+  }
+
+  if (isDPP(MI))
+    return InstructionUniformity::NeverUniform;
+
+  // Atomics are executed sequentially by the threads, each of them returns
+  // the value written by the previous one.
+  if (MI.mayLoad() && MI.mayStore() && MI.getNumExplicitDefs() != 0)
+    return InstructionUniformity::NeverUniform;
+
+  // Every thread has its own private memory.
+  unsigned PrivateAS = ST.getAMDGPUAS().PRIVATE_ADDRESS;
+  if (MI.mayLoad() && any_of(MI.memoperands(), [=](MachineMemOperand *MMO) {
+        return MMO->getAddrSpace() == PrivateAS;
+      }))
+    return InstructionUniformity::NeverUniform;
+
+  // The VGPRs that are live-in, e.g. the work item ids or the results of a
+  // call, hold a value per thread.
+  for (const MachineOperand &MO : MI.uses()) {
+    if (!MO.isReg() || !TargetRegisterInfo::isPhysicalRegister(MO.getReg()))
+      continue;
+    const TargetRegisterClass *RC = RI.getPhysRegClass(MO.getReg());
+    if (RC && RI.hasVGPRs(RC))
+      return InstructionUniformity::NeverUniform;
+  }
+
+  return InstructionUniformity::Default;
+}
+
 MachineInstrBuilder
 SIInstrInfo::getAddNoCarry(MachineBasicBlock &MBB,
                            MachineBasicBlock::iterator I,
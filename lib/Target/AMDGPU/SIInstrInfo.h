@@ -865,6 +865,9 @@ public:
 
   bool isBasicBlockPrologue(const MachineInstr &MI) const override;
 
+  InstructionUniformity
+  getInstructionUniformity(const MachineInstr &MI) const override;
+
   /// Return a partially built integer add instruction without carry.
   /// Caller must add source operands.
   /// For pre-GFX9 it will generate unused carry destination operand.
@@ -45,6 +45,7 @@
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Target/TargetLoweringObjectFile.h"
 #include "llvm/Target/TargetOptions.h"
+#include "llvm/Transforms/Scalar.h"
 #include <memory>
 #include <string>
 
@@ -58,6 +59,11 @@ static cl::opt<bool> EnableSpeculativeLoadHardening(
     "x86-speculative-load-hardening",
     cl::desc("Enable speculative load hardening"), cl::init(false), cl::Hidden);
 
+static cl::opt<bool>
+    EnableLoopDataPrefetch("x86-enable-loop-data-prefetch", cl::Hidden,
+                           cl::desc("Enable the loop data prefetch pass"),
+                           cl::init(false));
+
 namespace llvm {
 
 void initializeWinEHStatePassPass(PassRegistry &);
@@ -404,6 +410,12 @@ TargetPassConfig *X86TargetMachine::createPassConfig(PassManagerBase &PM) {
 void X86PassConfig::addIRPasses() {
   addPass(createAtomicExpandPass());
 
+  // The hardware prefetchers cover most strided accesses, so the loop data
+  // prefetch pass is mostly useful for indirect accesses. Run it before LSR,
+  // which makes address recurrences harder to recognize.
+  if (TM->getOptLevel() != CodeGenOpt::None && EnableLoopDataPrefetch)
+    addPass(createLoopDataPrefetchPass());
+
   TargetPassConfig::addIRPasses();
 
   if (TM->getOptLevel() != CodeGenOpt::None)
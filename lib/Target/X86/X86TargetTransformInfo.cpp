@@ -66,6 +66,15 @@ X86TTIImpl::getPopcntSupport(unsigned TyWidth) {
   return ST->hasPOPCNT() ? TTI::PSK_FastHardware : TTI::PSK_Software;
 }
 
+void X86TTIImpl::getUnrollingPreferences(Loop *L, ScalarEvolution &SE,
+                                         TTI::UnrollingPreferences &UP) {
+  BaseT::getUnrollingPreferences(L, SE, UP);
+
+  // Unroll and jam limits itself to the registers of the target.
+  UP.UnrollAndJam = true;
+  UP.UnrollAndJamInnerLoopThreshold = 60;
+}
+
 llvm::Optional<unsigned> X86TTIImpl::getCacheSize(
   TargetTransformInfo::CacheLevel Level) const {
   switch (Level) {
@@ -117,6 +126,21 @@ llvm::Optional<unsigned> X86TTIImpl::getCacheAssociativity(
   llvm_unreachable("Unknown TargetTransformInfo::CacheLevel");
 }
 
+unsigned X86TTIImpl::getCacheLineSize() const { return 64; }
+
+unsigned X86TTIImpl::getPrefetchDistance() const {
+  // Roughly the latency of a DRAM access, in cycles. Only used when the loop
+  // data prefetch pass is enabled (-x86-enable-loop-data-prefetch).
+  return 300;
+}
+
+unsigned X86TTIImpl::getMinPrefetchStride() const {
+  // The IP-based stride prefetcher handles strides of up to 2 KB.
+  return 2048;
+}
+
+bool X86TTIImpl::enableIndirectPrefetch() const { return true; }
+
 unsigned X86TTIImpl::getNumberOfRegisters(bool Vector) {
   if (Vector && !ST->hasSSE1())
     return 0;
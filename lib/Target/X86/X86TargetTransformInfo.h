@@ -44,6 +44,8 @@ public:
   /// \name Scalar TTI Implementations
   /// @{
   TTI::PopcntSupportKind getPopcntSupport(unsigned TyWidth);
+  void getUnrollingPreferences(Loop *L, ScalarEvolution &SE,
+                               TTI::UnrollingPreferences &UP);
 
   /// @}
 
@@ -53,6 +55,10 @@ public:
     TargetTransformInfo::CacheLevel Level) const;
   llvm::Optional<unsigned> getCacheAssociativity(
     TargetTransformInfo::CacheLevel Level) const;
+  unsigned getCacheLineSize() const;
+  unsigned getPrefetchDistance() const;
+  unsigned getMinPrefetchStride() const;
+  bool enableIndirectPrefetch() const;
   /// @}
 
   /// \name Vector TTI Implementations
@@ -505,7 +505,8 @@ inlineCallsImpl(CallGraphSCC &SCC, CallGraph &CG,
                 bool InsertLifetime,
                 function_ref<InlineCost(CallSite CS)> GetInlineCost,
                 function_ref<AAResults &(Function &)> AARGetter,
-                ImportedFunctionsInliningStatistics &ImportedFunctionsStats) {
+                ImportedFunctionsInliningStatistics &ImportedFunctionsStats,
+                InlineCostSummaryCache &CalleeSummaries) {
   SmallPtrSet<Function *, 8> SCCFunctions;
   LLVM_DEBUG(dbgs() << "Inliner visiting SCC:");
   for (CallGraphNode *Node : SCC) {
@@ -673,6 +674,9 @@ inlineCallsImpl(CallGraphSCC &SCC, CallGraph &CG,
         }
       }
 
+      // The cost of inlining the caller itself has changed.
+      CalleeSummaries.invalidate(*Caller);
+
       // If we inlined or deleted the last possible call site to the function,
       // delete the function body now.
       if (Callee && Callee->use_empty() && Callee->hasLocalLinkage() &&
@@ -722,14 +726,23 @@ bool LegacyInlinerBase::inlineCalls(CallGraphSCC &SCC) {
   auto GetAssumptionCache = [&](Function &F) -> AssumptionCache & {
     return ACT->getAssumptionCache(F);
   };
-  return inlineCallsImpl(SCC, CG, GetAssumptionCache, PSI, TLI, InsertLifetime,
-                         [this](CallSite CS) { return getInlineCost(CS); },
-                         LegacyAARGetter(*this), ImportedFunctionsStats);
+  bool Changed = inlineCallsImpl(
+      SCC, CG, GetAssumptionCache, PSI, TLI, InsertLifetime,
+      [this](CallSite CS) { return getInlineCost(CS); },
+      LegacyAARGetter(*this), ImportedFunctionsStats, CalleeSummaries);
+
+  // The functions of the SCC are simplified next, which makes their summaries
+  // stale. The functions of the SCCs below are not modified anymore.
+  for (CallGraphNode *Node : SCC)
+    if (Function *F = Node->getFunction())
+      CalleeSummaries.invalidate(*F);
+  return Changed;
 }
 
 /// Remove now-dead linkonce functions at the end of
 /// processing to avoid breaking the SCC traversal.
 bool LegacyInlinerBase::doFinalization(CallGraph &CG) {
+  CalleeSummaries.clear();
   if (InlinerFunctionImportStats != InlinerFunctionImportStatsOpts::No)
     ImportedFunctionsStats.dump(InlinerFunctionImportStats ==
                                 InlinerFunctionImportStatsOpts::Verbose);
@@ -869,6 +882,7 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
   // and eventually they all become too large to inline, rather than
   // incrementally maknig a single function grow in a super linear fashion.
   SmallVector<std::pair<CallSite, int>, 16> Calls;
+  SmallVector<Function *, 4> SCCFunctions;
 
   FunctionAnalysisManager &FAM =
       AM.getResult<FunctionAnalysisManagerCGSCCProxy>(InitialC, CG)
@@ -876,6 +890,7 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
 
   // Populate the initial list of calls in this SCC.
   for (auto &N : InitialC) {
+    SCCFunctions.push_back(&N.getFunction());
     auto &ORE =
         FAM.getResult<OptimizationRemarkEmitterAnalysis>(N.getFunction());
     // We want to generally process call sites top-down in order for
@@ -964,7 +979,7 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
       Function &Callee = *CS.getCalledFunction();
       auto &CalleeTTI = FAM.getResult<TargetIRAnalysis>(Callee);
       return getInlineCost(CS, Params, CalleeTTI, GetAssumptionCache, {GetBFI},
-                           PSI, &ORE);
+                           PSI, &ORE, &CalleeSummaries);
     };
 
     // Now process as many calls as we have within this caller in the sequnece.
@@ -1023,6 +1038,7 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
       }
       DidInline = true;
       InlinedCallees.insert(&Callee);
+      CalleeSummaries.invalidate(F);
 
       emit_inlined_into(ORE, DLoc, Block, Callee, F, *OIC);
 
@@ -1062,6 +1078,7 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
           // Note that after this point, it is an error to do anything other
           // than use the callee's address or delete it.
           Callee.dropAllReferences();
+          CalleeSummaries.invalidate(Callee);
           assert(find(DeadFunctions, &Callee) == DeadFunctions.end() &&
                  "Cannot put cause a function to become dead twice!");
           DeadFunctions.push_back(&Callee);
@@ -1124,6 +1141,11 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
     InlinedCallees.clear();
   }
 
+  // The functions of the SCC are simplified next, which makes their summaries
+  // stale. The functions of the SCCs below are not modified anymore.
+  for (Function *F : SCCFunctions)
+    CalleeSummaries.invalidate(*F);
+
   // Now that we've finished inlining all of the calls across this SCC, delete
   // all of the trivially dead functions, updating the call graph and the CGSCC
   // pass manager in the process.
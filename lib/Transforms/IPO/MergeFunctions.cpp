@@ -90,6 +90,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
@@ -111,6 +112,7 @@
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
+#include "llvm/IR/TypeFinder.h"
 #include "llvm/IR/Use.h"
 #include "llvm/IR/User.h"
 #include "llvm/IR/Value.h"
@@ -120,12 +122,14 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/Utils/FunctionComparator.h"
 #include <algorithm>
 #include <cassert>
 #include <iterator>
+#include <numeric>
 #include <set>
 #include <utility>
 #include <vector>
@@ -138,6 +142,12 @@ STATISTIC(NumFunctionsMerged, "Number of functions merged");
 STATISTIC(NumThunksWritten, "Number of thunks generated");
 STATISTIC(NumDoubleWeak, "Number of new functions created");
 
+static cl::opt<unsigned> ParallelThreshold(
+    "mergefunc-parallel-threshold",
+    cl::desc("Minimum number of functions in a module for fingerprinting and "
+             "comparing them on several threads. '0' disables threading."),
+    cl::init(4096), cl::Hidden);
+
 static cl::opt<unsigned> NumFunctionsForSanityCheck(
     "mergefunc-sanity",
     cl::desc("How many functions in module could be used for "
@@ -174,7 +184,7 @@ class FunctionNode {
 public:
   // Note the hash is recalculated potentially multiple times, but it is cheap.
   FunctionNode(Function *F)
-    : F(F), Hash(FunctionComparator::functionHash(*F))  {}
+    : F(F), Hash(FunctionComparator::functionFingerprint(*F))  {}
 
   Function *getFunc() const { return F; }
   FunctionComparator::FunctionHash getHash() const { return Hash; }
@@ -213,7 +223,8 @@ private:
     FunctionNodeCmp(GlobalNumberState* GN) : GlobalNumbers(GN) {}
 
     bool operator()(const FunctionNode &LHS, const FunctionNode &RHS) const {
-      // Order first by hashes, then full function comparison.
+      // Order first by fingerprints, then full function comparison. Full
+      // comparisons only happen between functions with the same fingerprint.
       if (LHS.getHash() != RHS.getHash())
         return LHS.getHash() < RHS.getHash();
       FunctionComparator FCmp(LHS.getFunc(), RHS.getFunc(), GlobalNumbers);
@@ -234,6 +245,18 @@ private:
   bool doSanityCheck(std::vector<WeakTrackingVH> &Worklist);
 #endif
 
+  /// Number all the global values of M and compute the layouts of its struct
+  /// types, so that functions can then be compared on several threads.
+  void prepareForParallelComparison(Module &M);
+
+  /// Return true if the sorted functions in Bucket, which all have the same
+  /// fingerprint, can't change when other functions are merged. For every
+  /// function in such a bucket that is equal to another, set its HasPartner
+  /// entry.
+  bool findPartners(ArrayRef<Function *> Bucket,
+                    ArrayRef<char> ReferencesFunctions,
+                    MutableArrayRef<char> HasPartner);
+
   /// Insert a ComparableFunction into the FnTree, or merge it away if it's
   /// equal to one that's already present.
   bool insert(Function *NewFunction);
@@ -370,39 +393,166 @@ bool MergeFunctions::doSanityCheck(std::vector<WeakTrackingVH> &Worklist) {
 }
 #endif
 
+// Returns true if C refers to a function. When that function is merged, C is
+// replaced in the instructions that use it.
+static bool referencesFunction(const Constant *C, unsigned Depth = 0) {
+  if (isa<Function>(C))
+    return true;
+  if (isa<GlobalValue>(C))
+    return false;
+  // Give up conservatively on deeply nested constants.
+  if (Depth == 8)
+    return true;
+  for (const Value *Op : C->operand_values())
+    if (auto *OpC = dyn_cast<Constant>(Op))
+      if (referencesFunction(OpC, Depth + 1))
+        return true;
+  return false;
+}
+
+// Returns true if merging other functions may rewrite the body of F.
+static bool referencesFunctions(const Function &F) {
+  for (const BasicBlock &BB : F)
+    for (const Instruction &I : BB)
+      for (const Value *Op : I.operand_values())
+        if (auto *C = dyn_cast<Constant>(Op))
+          if (referencesFunction(C))
+            return true;
+  return false;
+}
+
+void MergeFunctions::prepareForParallelComparison(Module &M) {
+  // FunctionComparator assigns numbers to global values lazily.
+  for (GlobalValue &GV : M.global_values())
+    GlobalNumbers.getNumber(&GV);
+
+  // cmpTypes() maps pointers to integers, and cmpGEPs() computes struct
+  // layouts. Both are cached in the context and the data layout.
+  const DataLayout &DL = M.getDataLayout();
+  DL.getIntPtrType(M.getContext());
+  TypeFinder StructTypes;
+  StructTypes.run(M, /*onlyNamed=*/false);
+  for (StructType *STy : StructTypes)
+    if (STy->isSized())
+      DL.getStructLayout(STy);
+}
+
+bool MergeFunctions::findPartners(ArrayRef<Function *> Bucket,
+                                  ArrayRef<char> ReferencesFunctions,
+                                  MutableArrayRef<char> HasPartner) {
+  // A function that is not equal to any other function with the same
+  // fingerprint may still become equal to one later, once a function it calls
+  // has been merged.
+  if (llvm::any_of(ReferencesFunctions, [](char B) { return B; }))
+    return false;
+
+  // Partition the bucket into classes of equal functions, represented by
+  // their first member.
+  SmallVector<unsigned, 4> Representatives;
+  for (unsigned I = 0, E = Bucket.size(); I != E; ++I) {
+    auto Equal = llvm::find_if(Representatives, [&](unsigned R) {
+      return FunctionComparator(Bucket[R], Bucket[I], &GlobalNumbers)
+                 .compare() == 0;
+    });
+    if (Equal == Representatives.end()) {
+      Representatives.push_back(I);
+      continue;
+    }
+    HasPartner[*Equal] = true;
+    HasPartner[I] = true;
+  }
+  return true;
+}
+
 bool MergeFunctions::runOnModule(Module &M) {
   if (skipModule(M))
     return false;
 
   bool Changed = false;
 
-  // All functions in the module, ordered by hash. Functions with a unique
-  // hash value are easily eliminated.
-  std::vector<std::pair<FunctionComparator::FunctionHash, Function *>>
-    HashedFuncs;
+  std::vector<Function *> Funcs;
   for (Function &Func : M) {
     if (!Func.isDeclaration() && !Func.hasAvailableExternallyLinkage()) {
-      HashedFuncs.push_back({FunctionComparator::functionHash(Func), &Func});
+      Funcs.push_back(&Func);
     }
   }
 
-  std::stable_sort(
-      HashedFuncs.begin(), HashedFuncs.end(),
-      [](const std::pair<FunctionComparator::FunctionHash, Function *> &a,
-         const std::pair<FunctionComparator::FunctionHash, Function *> &b) {
-        return a.first < b.first;
-      });
-
-  auto S = HashedFuncs.begin();
-  for (auto I = HashedFuncs.begin(), IE = HashedFuncs.end(); I != IE; ++I) {
-    // If the hash value matches the previous value or the next one, we must
-    // consider merging it. Otherwise it is dropped and never considered again.
-    if ((I != S && std::prev(I)->first == I->first) ||
-        (std::next(I) != IE && std::next(I)->first == I->first) ) {
-      Deferred.push_back(WeakTrackingVH(I->second));
-    }
+  bool Parallel = ParallelThreshold && Funcs.size() >= ParallelThreshold;
+  auto ForEachIndex = [Parallel](size_t N, function_ref<void(size_t)> Fn) {
+    if (Parallel)
+      parallel::for_each_n(parallel::par, size_t(0), N, Fn);
+    else
+      for (size_t I = 0; I != N; ++I)
+        Fn(I);
+  };
+  if (Parallel)
+    prepareForParallelComparison(M);
+
+  // Fingerprint all the functions. Equal functions have the same fingerprint.
+  std::vector<FunctionComparator::FunctionHash> Hashes(Funcs.size());
+  std::vector<FunctionComparator::FunctionHash> Fingerprints(Funcs.size());
+  std::vector<char> ReferencesFunctions(Funcs.size());
+  ForEachIndex(Funcs.size(), [&](size_t I) {
+    Hashes[I] = FunctionComparator::functionHash(*Funcs[I]);
+    Fingerprints[I] = FunctionComparator::functionFingerprint(*Funcs[I]);
+    ReferencesFunctions[I] = referencesFunctions(*Funcs[I]);
+  });
+
+  // All functions in the module, ordered by fingerprint. Functions with a
+  // unique fingerprint are easily eliminated.
+  std::vector<unsigned> Order(Funcs.size());
+  std::iota(Order.begin(), Order.end(), 0);
+  std::stable_sort(Order.begin(), Order.end(), [&](unsigned A, unsigned B) {
+    return Fingerprints[A] < Fingerprints[B];
+  });
+  std::vector<Function *> SortedFuncs;
+  std::vector<char> SortedReferencesFunctions;
+  for (unsigned I : Order) {
+    SortedFuncs.push_back(Funcs[I]);
+    SortedReferencesFunctions.push_back(ReferencesFunctions[I]);
   }
 
+  // Functions with the same fingerprint must be considered for merging.
+  std::vector<std::pair<unsigned, unsigned>> Buckets;
+  for (unsigned I = 0, E = Order.size(); I != E;) {
+    unsigned J = I + 1;
+    while (J != E && Fingerprints[Order[J]] == Fingerprints[Order[I]])
+      ++J;
+    if (J - I > 1)
+      Buckets.push_back({I, J});
+    I = J;
+  }
+
+  // When none of the functions of a bucket can change, only the functions
+  // that are equal to another one in the bucket need to go into FnTree. The
+  // buckets are independent, so they are compared in parallel.
+  std::vector<char> HasPartner(Funcs.size(), false);
+  std::vector<char> CanPrune(Buckets.size(), false);
+  ForEachIndex(Buckets.size(), [&](size_t B) {
+    unsigned Begin = Buckets[B].first;
+    unsigned Size = Buckets[B].second - Begin;
+    CanPrune[B] = findPartners(
+        makeArrayRef(SortedFuncs).slice(Begin, Size),
+        makeArrayRef(SortedReferencesFunctions).slice(Begin, Size),
+        MutableArrayRef<char>(HasPartner).slice(Begin, Size));
+  });
+
+  std::vector<char> IsCandidate(Funcs.size(), false);
+  for (unsigned B = 0, E = Buckets.size(); B != E; ++B)
+    for (unsigned I = Buckets[B].first; I != Buckets[B].second; ++I)
+      if (!CanPrune[B] || HasPartner[I])
+        IsCandidate[Order[I]] = true;
+
+  // The functions are merged in the order of their hash, as they were before
+  // fingerprints, which decides the order of the thunks in the module.
+  std::iota(Order.begin(), Order.end(), 0);
+  std::stable_sort(Order.begin(), Order.end(), [&](unsigned A, unsigned B) {
+    return Hashes[A] < Hashes[B];
+  });
+  for (unsigned I : Order)
+    if (IsCandidate[I])
+      Deferred.push_back(WeakTrackingVH(Funcs[I]));
+
   do {
     std::vector<WeakTrackingVH> Worklist;
     Deferred.swap(Worklist);
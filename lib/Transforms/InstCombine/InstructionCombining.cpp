@@ -116,6 +116,11 @@ STATISTIC(NumSunkInst , "Number of instructions sunk");
 STATISTIC(NumExpand,    "Number of expansions");
 STATISTIC(NumFactor   , "Number of factorizations");
 STATISTIC(NumReassoc  , "Number of reassociations");
+STATISTIC(NumOneIteration, "Number of functions with one iteration");
+STATISTIC(NumTwoIterations, "Number of functions with two iterations");
+STATISTIC(NumThreeIterations, "Number of functions with three iterations");
+STATISTIC(NumFourOrMoreIterations,
+          "Number of functions with four or more iterations");
 DEBUG_COUNTER(VisitCounter, "instcombine-visit",
               "Controls which instructions are visited");
 
@@ -127,6 +132,20 @@ static cl::opt<unsigned>
 MaxArraySize("instcombine-maxarray-size", cl::init(1024),
              cl::desc("Maximum array size considered when doing a combine"));
 
+static cl::opt<bool>
+SingleSweep("instcombine-single-sweep", cl::Hidden, cl::init(false),
+            cl::desc("Reach a fixpoint through the worklist alone, instead of "
+                     "iterating over the whole function until nothing "
+                     "changes"));
+
+#ifndef NDEBUG
+static cl::opt<bool>
+VerifyFixpoint("instcombine-verify-fixpoint", cl::Hidden, cl::init(false),
+               cl::desc("With -instcombine-single-sweep, check that another "
+                        "iteration over the whole function doesn't combine "
+                        "anything"));
+#endif
+
 // FIXME: Remove this flag when it is no longer necessary to convert
 // llvm.dbg.declare to avoid inaccurate debug info. Setting this to false
 // increases variable availability at the cost of accuracy. Variables that
@@ -3049,6 +3068,14 @@ bool InstCombiner::run() {
     LLVM_DEBUG(raw_string_ostream SS(OrigI); I->print(SS); OrigI = SS.str(););
     LLVM_DEBUG(dbgs() << "IC: Visiting: " << OrigI << '\n');
 
+    // An in-place combine may leave the operands it replaced dead. The next
+    // iteration erases them, but a single sweep has to revisit them.
+    SmallVector<WeakVH, 4> OrigOperands;
+    if (SingleSweep)
+      for (Value *Op : I->operands())
+        if (isa<Instruction>(Op))
+          OrigOperands.push_back(Op);
+
     if (Instruction *Result = visit(*I)) {
       ++NumCombined;
       // Should we replace the old instruction with a new one?
@@ -3092,6 +3119,10 @@ bool InstCombiner::run() {
           Worklist.AddUsersToWorkList(*I);
           Worklist.Add(I);
         }
+        for (WeakVH &Op : OrigOperands)
+          if (auto *OpI = dyn_cast_or_null<Instruction>(Op))
+            if (OpI->use_empty())
+              Worklist.Add(OpI);
       }
       MadeIRChange = true;
     }
@@ -3283,9 +3314,40 @@ static bool combineInstructionsOverFunction(
 
     if (!IC.run())
       break;
+    MadeIRChange = true;
+
+    // The users and operands of every changed instruction are added back to
+    // the worklist, so a single sweep finds most of what another iteration
+    // would. What it misses is mostly code made unreachable by folded
+    // branches, which SimplifyCFG removes anyway.
+    if (SingleSweep)
+      break;
+  }
+
+  if (Iteration == 1)
+    ++NumOneIteration;
+  else if (Iteration == 2)
+    ++NumTwoIterations;
+  else if (Iteration == 3)
+    ++NumThreeIterations;
+  else
+    ++NumFourOrMoreIterations;
+
+#ifndef NDEBUG
+  if (SingleSweep && VerifyFixpoint) {
+    // Changes made while preparing the worklist only prune unreachable code
+    // and fold constants, and are not counted as missed combines.
+    MadeIRChange |= prepareICWorklistFromFunction(F, DL, &TLI, Worklist);
+    InstCombiner IC(Worklist, Builder, F.optForMinSize(), ExpensiveCombines, AA,
+                    AC, TLI, DT, ORE, DL, LI);
+    IC.MaxArraySizeForCombine = MaxArraySize;
+    if (IC.run())
+      report_fatal_error("InstCombine did not reach a fixpoint in a single "
+                         "sweep over '" + F.getName() + "'");
   }
+#endif
 
-  return MadeIRChange || Iteration > 1;
+  return MadeIRChange;
 }
 
 PreservedAnalyses InstCombinePass::run(Function &F,
@@ -35,6 +35,9 @@
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/MemoryBuiltins.h"
 #include "llvm/Analysis/MemoryDependenceAnalysis.h"
+#include "llvm/Analysis/MemoryLocation.h"
+#include "llvm/Analysis/MemorySSA.h"
+#include "llvm/Analysis/MemorySSAUpdater.h"
 #include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Analysis/PHITransAddr.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
@@ -93,11 +96,28 @@ STATISTIC(NumGVNBlocks, "Number of blocks merged");
 STATISTIC(NumGVNSimpl,  "Number of instructions simplified");
 STATISTIC(NumGVNEqProp, "Number of equalities propagated");
 STATISTIC(NumPRELoad,   "Number of loads PRE'd");
+STATISTIC(NumMSSADefsWalked,
+          "Number of MemoryDefs walked to find load dependencies");
 
 static cl::opt<bool> EnablePRE("enable-pre",
                                cl::init(true), cl::Hidden);
 static cl::opt<bool> EnableLoadPRE("enable-load-pre", cl::init(true));
 
+static cl::opt<bool> GVNUseMemorySSA(
+    "gvn-memoryssa", cl::init(false), cl::Hidden,
+    cl::desc("Find the dependencies of loads with MemorySSA instead of "
+             "MemoryDependenceAnalysis"));
+
+static cl::opt<unsigned> MSSAScanLimit(
+    "gvn-memoryssa-scan-limit", cl::init(100), cl::Hidden,
+    cl::desc("The number of instructions to scan in a block for an earlier "
+             "load of the same address with -gvn-memoryssa"));
+
+static cl::opt<unsigned> MSSABlockLimit(
+    "gvn-memoryssa-block-limit", cl::init(1000), cl::Hidden,
+    cl::desc("The number of blocks to visit to find the non-local "
+             "dependencies of a load with -gvn-memoryssa"));
+
 // Maximum allowed recursion depth.
 static cl::opt<uint32_t>
 MaxRecurseDepth("max-recurse-depth", cl::Hidden, cl::init(1000), cl::ZeroOrMore,
@@ -394,6 +414,21 @@ uint32_t GVN::ValueTable::lookupOrAddCall(CallInst *C) {
     return e;
   } else if (AA->onlyReadsMemory(C)) {
     Expression exp = createExpr(C);
+    if (MSSA) {
+      // Two readonly calls with the same operands are equal if they read the
+      // same memory state, so number that state like one more operand.
+      MemoryAccess *Clobber = MSSA->getWalker()->getClobberingMemoryAccess(C);
+      unsigned ID = isa<MemoryPhi>(Clobber) ? cast<MemoryPhi>(Clobber)->getID()
+                                            : cast<MemoryDef>(Clobber)->getID();
+      auto State =
+          memoryStateNumbering.insert(std::make_pair(ID, nextValueNumber));
+      if (State.second)
+        ++nextValueNumber;
+      exp.varargs.push_back(State.first->second);
+      uint32_t e = assignExpNewValueNum(exp).first;
+      valueNumbering[C] = e;
+      return e;
+    }
     auto ValNum = assignExpNewValueNum(exp);
     if (ValNum.second) {
       valueNumbering[C] = ValNum.first;
@@ -597,6 +632,7 @@ void GVN::ValueTable::clear() {
   expressionNumbering.clear();
   NumberingPhi.clear();
   PhiTranslateTable.clear();
+  memoryStateNumbering.clear();
   nextValueNumber = 1;
   Expressions.clear();
   ExprIdx.clear();
@@ -634,10 +670,11 @@ PreservedAnalyses GVN::run(Function &F, FunctionAnalysisManager &AM) {
   auto &DT = AM.getResult<DominatorTreeAnalysis>(F);
   auto &TLI = AM.getResult<TargetLibraryAnalysis>(F);
   auto &AA = AM.getResult<AAManager>(F);
-  auto &MemDep = AM.getResult<MemoryDependenceAnalysis>(F);
+  auto *MemDep =
+      GVNUseMemorySSA ? nullptr : &AM.getResult<MemoryDependenceAnalysis>(F);
   auto *LI = AM.getCachedResult<LoopAnalysis>(F);
   auto &ORE = AM.getResult<OptimizationRemarkEmitterAnalysis>(F);
-  bool Changed = runImpl(F, AC, DT, TLI, AA, &MemDep, LI, &ORE);
+  bool Changed = runImpl(F, AC, DT, TLI, AA, MemDep, GVNUseMemorySSA, LI, &ORE);
   if (!Changed)
     return PreservedAnalyses::all();
   PreservedAnalyses PA;
@@ -809,7 +846,8 @@ Value *AvailableValue::MaterializeAdjustedValue(LoadInst *LI,
       // tracks.  It is potentially possible to remove the load from the table,
       // but then there all of the operations based on it would need to be
       // rehashed.  Just leave the dead load around.
-      gvn.getMemDep().removeInstruction(Load);
+      if (MemoryDependenceResults *MD = gvn.getMemDep())
+        MD->removeInstruction(Load);
       LLVM_DEBUG(dbgs() << "GVN COERCED NONLOCAL LOAD:\nOffset: " << Offset
                         << "  " << *getCoercedLoadValue() << '\n'
                         << *Res << '\n'
@@ -1267,10 +1305,25 @@ bool GVN::PerformLoadPRE(LoadInst *LI, AvailValInBlkVect &ValuesPerBlock,
     // FIXME: How do we retain source locations without causing poor debugging
     // behavior?
 
+    if (MSSAU) {
+      // The new load reads the memory state at the end of its block.
+      MemoryAccess *NewAccess;
+      if (MemoryUseOrDef *TermAccess =
+              MSSA->getMemoryAccess(UnavailablePred->getTerminator()))
+        NewAccess = MSSAU->createMemoryAccessBefore(NewLoad, nullptr,
+                                                    TermAccess);
+      else
+        NewAccess = MSSAU->createMemoryAccessInBB(NewLoad, nullptr,
+                                                  UnavailablePred,
+                                                  MemorySSA::End);
+      MSSAU->insertUse(cast<MemoryUse>(NewAccess));
+    }
+
     // Add the newly created load.
     ValuesPerBlock.push_back(AvailableValueInBlock::get(UnavailablePred,
                                                         NewLoad));
-    MD->invalidateCachedPointerInfo(LoadPtr);
+    if (MD)
+      MD->invalidateCachedPointerInfo(LoadPtr);
     LLVM_DEBUG(dbgs() << "GVN INSERTED " << *NewLoad << '\n');
   }
 
@@ -1281,7 +1334,7 @@ bool GVN::PerformLoadPRE(LoadInst *LI, AvailValInBlkVect &ValuesPerBlock,
     V->takeName(LI);
   if (Instruction *I = dyn_cast<Instruction>(V))
     I->setDebugLoc(LI->getDebugLoc());
-  if (V->getType()->isPtrOrPtrVectorTy())
+  if (MD && V->getType()->isPtrOrPtrVectorTy())
     MD->invalidateCachedPointerInfo(V);
   markInstructionForDeletion(LI);
   ORE->emit([&]() {
@@ -1316,7 +1369,10 @@ bool GVN::processNonLocalLoad(LoadInst *LI) {
 
   // Step 1: Find the non-local dependencies of the load.
   LoadDepVect Deps;
-  MD->getNonLocalPointerDependency(LI, Deps);
+  if (MSSA)
+    getNonLocalDependenciesMSSA(LI, Deps);
+  else
+    MD->getNonLocalPointerDependency(LI, Deps);
 
   // If we had to process more than one hundred blocks to find the
   // dependencies, this load isn't worth worrying about.  Optimizing
@@ -1373,7 +1429,7 @@ bool GVN::processNonLocalLoad(LoadInst *LI) {
       // to propagate LI's DebugLoc because LI may not post-dominate I.
       if (LI->getDebugLoc() && LI->getParent() == I->getParent())
         I->setDebugLoc(LI->getDebugLoc());
-    if (V->getType()->isPtrOrPtrVectorTy())
+    if (MD && V->getType()->isPtrOrPtrVectorTy())
       MD->invalidateCachedPointerInfo(V);
     markInstructionForDeletion(LI);
     ++NumGVNLoad;
@@ -1399,9 +1455,23 @@ bool GVN::processAssumeIntrinsic(IntrinsicInst *IntrinsicI) {
       // Insert a new store to null instruction before the load to indicate that
       // this code is not reachable.  FIXME: We could insert unreachable
       // instruction directly because we can modify the CFG.
-      new StoreInst(UndefValue::get(Int8Ty),
-                    Constant::getNullValue(Int8Ty->getPointerTo()),
-                    IntrinsicI);
+      auto *NewS = new StoreInst(UndefValue::get(Int8Ty),
+                                 Constant::getNullValue(Int8Ty->getPointerTo()),
+                                 IntrinsicI);
+      if (MSSAU) {
+        // Place the new MemoryDef before the first access that follows it.
+        MemoryUseOrDef *Next = nullptr;
+        for (Instruction &I : make_range(std::next(NewS->getIterator()),
+                                         NewS->getParent()->end()))
+          if ((Next = MSSA->getMemoryAccess(&I)))
+            break;
+        MemoryAccess *NewDef =
+            Next ? MSSAU->createMemoryAccessBefore(NewS, nullptr, Next)
+                 : MSSAU->createMemoryAccessInBB(NewS, nullptr,
+                                                 NewS->getParent(),
+                                                 MemorySSA::End);
+        MSSAU->insertDef(cast<MemoryDef>(NewDef));
+      }
     }
     markInstructionForDeletion(IntrinsicI);
     return false;
@@ -1487,10 +1557,225 @@ static void patchAndReplaceAllUsesWith(Instruction *I, Value *Repl) {
   I->replaceAllUsesWith(Repl);
 }
 
+/// Returns the dependency of a load of \p Loc on \p Inst, a MemoryDef that
+/// may write to \p Loc: Def if the loaded value can be derived from it,
+/// Clobber otherwise.
+static MemDepResult getDefOrClobber(Instruction *Inst,
+                                    const MemoryLocation &Loc,
+                                    AliasAnalysis &AA,
+                                    const TargetLibraryInfo *TLI) {
+  if (auto *SI = dyn_cast<StoreInst>(Inst))
+    if (AA.alias(MemoryLocation::get(SI), Loc) == MustAlias)
+      return MemDepResult::getDef(Inst);
+  if (auto *II = dyn_cast<IntrinsicInst>(Inst))
+    if (II->getIntrinsicID() == Intrinsic::lifetime_start &&
+        AA.isMustAlias(II->getArgOperand(1), Loc.Ptr))
+      return MemDepResult::getDef(Inst);
+  const DataLayout &DL = Inst->getModule()->getDataLayout();
+  if (isNoAliasFn(Inst, TLI) && GetUnderlyingObject(Loc.Ptr, DL) == Inst)
+    return MemDepResult::getDef(Inst);
+  return MemDepResult::getClobber(Inst);
+}
+
+/// Returns the memory access that is live at the end of \p BB.
+MemoryAccess *GVN::getLiveOutAccess(BasicBlock *BB) const {
+  while (true) {
+    if (const auto *Defs = MSSA->getBlockDefs(BB))
+      return const_cast<MemoryAccess *>(&*Defs->rbegin());
+    // Without a MemoryPhi, all the predecessors of BB have the same live-out
+    // access, which is also the one of its immediate dominator.
+    DomTreeNode *Node = DT->getNode(BB);
+    if (!Node || !Node->getIDom())
+      return MSSA->getLiveOnEntryDef();
+    BB = Node->getIDom()->getBlock();
+  }
+}
+
+/// Find the dependency of a load of \p Loc in \p BB, before \p ScanFrom or at
+/// the end of BB if it is null. \p Acc is the memory access live at that
+/// point. This is the closest earlier load of the same address in BB, or the
+/// closest MemoryDef of BB that may write to it, found by walking the def
+/// chain rather than the instructions. If there is none, returns NonLocal
+/// and sets \p Acc to the first access reached outside of BB.
+MemDepResult GVN::getBlockDependencyMSSA(const MemoryLocation &Loc,
+                                         BasicBlock *BB, Instruction *ScanFrom,
+                                         MemoryAccess *&Acc) {
+  AliasAnalysis &AA = *VN.getAliasAnalysis();
+  Instruction *ClobberInst = nullptr;
+  while (auto *Def = dyn_cast<MemoryDef>(Acc)) {
+    if (MSSA->isLiveOnEntryDef(Def) || Def->getBlock() != BB)
+      break;
+    ++NumMSSADefsWalked;
+    Instruction *Inst = Def->getMemoryInst();
+    if (isModSet(AA.getModRefInfo(Inst, Loc))) {
+      ClobberInst = Inst;
+      break;
+    }
+    Acc = Def->getDefiningAccess();
+  }
+
+  // Loads don't clobber each other, so they are not on the def chain: scan
+  // for one between the clobber and ScanFrom.
+  const DataLayout &DL = BB->getModule()->getDataLayout();
+  const Value *Object = GetUnderlyingObject(Loc.Ptr, DL);
+  BasicBlock::iterator Begin =
+      ClobberInst ? ClobberInst->getIterator() : BB->begin();
+  unsigned Limit = MSSAScanLimit;
+  for (BasicBlock::iterator It = ScanFrom ? ScanFrom->getIterator() : BB->end();
+       It != Begin && Limit;) {
+    Instruction *Inst = &*--It;
+    if (isa<DbgInfoIntrinsic>(Inst))
+      continue;
+    --Limit;
+    if (Inst == Object && (isa<AllocaInst>(Inst) || isNoAliasFn(Inst, TLI)))
+      return MemDepResult::getDef(Inst);
+    auto *LI = dyn_cast<LoadInst>(Inst);
+    if (!LI || !LI->isUnordered())
+      continue;
+    AliasResult R = AA.alias(MemoryLocation::get(LI), Loc);
+    if (R == MustAlias)
+      return MemDepResult::getDef(LI);
+    if (R == PartialAlias)
+      return MemDepResult::getClobber(LI);
+  }
+
+  if (ClobberInst)
+    return getDefOrClobber(ClobberInst, Loc, AA, TLI);
+  return MemDepResult::getNonLocal();
+}
+
+/// The MemorySSA counterpart of MemoryDependenceResults::getDependency for
+/// loads.
+MemDepResult GVN::getDependencyMSSA(LoadInst *L) {
+  // Loads created while materializing coerced values have no access.
+  MemoryUseOrDef *Use = MSSA->getMemoryAccess(L);
+  if (!Use)
+    return MemDepResult::getUnknown();
+
+  BasicBlock *BB = L->getParent();
+  MemoryAccess *Acc = Use->getDefiningAccess();
+  MemDepResult Dep =
+      getBlockDependencyMSSA(MemoryLocation::get(L), BB, L, Acc);
+  if (Dep.isNonLocal() && BB == &BB->getParent()->getEntryBlock())
+    return MemDepResult::getNonFuncLocal();
+  return Dep;
+}
+
+/// The MemorySSA counterpart of
+/// MemoryDependenceResults::getNonLocalPointerDependency. Like it, this walks
+/// the CFG backwards from the block of \p L, translating the address through
+/// PHIs, and finds the dependency at the end of each predecessor. When a block
+/// has none, the def chain is followed directly to the next clobber instead of
+/// visiting the blocks in between, as long as the address is available there.
+void GVN::getNonLocalDependenciesMSSA(LoadInst *L, LoadDepVect &Deps) {
+  BasicBlock *LoadBB = L->getParent();
+  const DataLayout &DL = LoadBB->getModule()->getDataLayout();
+  AliasAnalysis &AA = *VN.getAliasAnalysis();
+  MemoryLocation Loc = MemoryLocation::get(L);
+
+  // The address of the load in each block queued so far.
+  DenseMap<BasicBlock *, Value *> Visited;
+  SmallPtrSet<BasicBlock *, 16> Reported;
+  SmallVector<std::pair<BasicBlock *, PHITransAddr>, 16> Worklist;
+
+  auto AddDep = [&](BasicBlock *BB, MemDepResult Dep, Value *Address) {
+    if (Reported.insert(BB).second)
+      Deps.push_back(NonLocalDepResult(BB, Dep, Address));
+  };
+  // Queue the reachable predecessors of BB. Returns false if one of them is
+  // reached with two different addresses.
+  auto AddPreds = [&](BasicBlock *BB, const PHITransAddr &Address) {
+    for (BasicBlock *Pred : predecessors(BB)) {
+      // Like MemoryDependenceResults, ignore unreachable predecessors: they
+      // have no DomTree node and MemorySSA doesn't describe their accesses.
+      if (!DT->isReachableFromEntry(Pred))
+        continue;
+      PHITransAddr PredAddress = Address;
+      if (PredAddress.NeedsPHITranslationFromBlock(BB) &&
+          PredAddress.PHITranslateValue(BB, Pred, DT,
+                                        /*MustDominate=*/false)) {
+        AddDep(Pred, MemDepResult::getUnknown(), nullptr);
+        continue;
+      }
+      auto It = Visited.insert({Pred, PredAddress.getAddr()});
+      if (!It.second) {
+        if (It.first->second != PredAddress.getAddr())
+          return false;
+        continue;
+      }
+      Worklist.push_back({Pred, PredAddress});
+    }
+    return true;
+  };
+
+  bool Failed = !AddPreds(LoadBB, PHITransAddr(L->getPointerOperand(), DL, AC));
+  while (!Failed && !Worklist.empty()) {
+    if (Visited.size() > MSSABlockLimit) {
+      Failed = true;
+      break;
+    }
+    BasicBlock *BB = Worklist.back().first;
+    PHITransAddr Address = Worklist.pop_back_val().second;
+    Value *Ptr = Address.getAddr();
+    MemoryLocation BBLoc = Loc.getWithNewPtr(Ptr);
+
+    MemoryAccess *Acc = getLiveOutAccess(BB);
+    MemDepResult Dep = getBlockDependencyMSSA(BBLoc, BB, nullptr, Acc);
+    if (!Dep.isNonLocal()) {
+      AddDep(BB, Dep, Ptr);
+      continue;
+    }
+
+    // Follow the def chain above BB while the address is available.
+    auto *PtrInst = dyn_cast<Instruction>(Ptr);
+    while (!MSSA->isLiveOnEntryDef(Acc) && isa<MemoryDef>(Acc)) {
+      Instruction *Inst = cast<MemoryDef>(Acc)->getMemoryInst();
+      if (PtrInst && !DT->dominates(PtrInst, Inst))
+        break;
+      ++NumMSSADefsWalked;
+      if (isModSet(AA.getModRefInfo(Inst, BBLoc))) {
+        Dep = getDefOrClobber(Inst, BBLoc, AA, TLI);
+        break;
+      }
+      Acc = cast<MemoryDef>(Acc)->getDefiningAccess();
+    }
+
+    if (!Dep.isNonLocal()) {
+      AddDep(Dep.getInst()->getParent(), Dep, Ptr);
+    } else if (MSSA->isLiveOnEntryDef(Acc)) {
+      // Nothing writes to the address on the way from the function entry.
+      const Value *Object = GetUnderlyingObject(Ptr, DL);
+      auto *ObjectInst = dyn_cast<Instruction>(const_cast<Value *>(Object));
+      if (ObjectInst &&
+          (isa<AllocaInst>(ObjectInst) || isNoAliasFn(ObjectInst, TLI)))
+        AddDep(ObjectInst->getParent(), MemDepResult::getDef(ObjectInst),
+               Ptr);
+      else
+        AddDep(&BB->getParent()->getEntryBlock(),
+               MemDepResult::getNonFuncLocal(), Ptr);
+    } else {
+      // Continue with the predecessors of the block of the MemoryPhi, or of
+      // BB if the address isn't available above it.
+      BasicBlock *PhiBB = isa<MemoryPhi>(Acc) ? Acc->getBlock() : BB;
+      if (PtrInst && !DT->dominates(PtrInst->getParent(), PhiBB))
+        PhiBB = BB;
+      Failed = !AddPreds(PhiBB, Address);
+    }
+  }
+
+  // Like MemoryDependenceResults, report a failure as a single unknown
+  // dependency in the block of the load.
+  if (Failed) {
+    Deps.clear();
+    Deps.push_back(NonLocalDepResult(LoadBB, MemDepResult::getUnknown(),
+                                     L->getPointerOperand()));
+  }
+}
+
 /// Attempt to eliminate a load, first by eliminating it
 /// locally, and then attempting non-local elimination if that fails.
 bool GVN::processLoad(LoadInst *L) {
-  if (!MD)
+  if (!MD && !MSSA)
     return false;
 
   // This code hasn't been audited for ordered or volatile memory access
@@ -1503,7 +1788,7 @@ bool GVN::processLoad(LoadInst *L) {
   }
 
   // ... to a pointer that has been loaded from before...
-  MemDepResult Dep = MD->getDependency(L);
+  MemDepResult Dep = MSSA ? getDependencyMSSA(L) : MD->getDependency(L);
 
   // If it is defined in another block, try harder.
   if (Dep.isNonLocal())
@@ -2012,8 +2297,8 @@ bool GVN::processInstruction(Instruction *I) {
 /// runOnFunction - This is the main transformation entry point for a function.
 bool GVN::runImpl(Function &F, AssumptionCache &RunAC, DominatorTree &RunDT,
                   const TargetLibraryInfo &RunTLI, AAResults &RunAA,
-                  MemoryDependenceResults *RunMD, LoopInfo *LI,
-                  OptimizationRemarkEmitter *RunORE) {
+                  MemoryDependenceResults *RunMD, bool UseMemorySSA,
+                  LoopInfo *LI, OptimizationRemarkEmitter *RunORE) {
   AC = &RunAC;
   DT = &RunDT;
   VN.setDomTree(DT);
@@ -2040,6 +2325,18 @@ bool GVN::runImpl(Function &F, AssumptionCache &RunAC, DominatorTree &RunDT,
     Changed |= removedBlock;
   }
 
+  // MemorySSA is built once the blocks are merged, so that it doesn't have
+  // to be updated for it, and is only owned by this run.
+  std::unique_ptr<MemorySSA> RunMSSA;
+  std::unique_ptr<MemorySSAUpdater> RunMSSAU;
+  if (UseMemorySSA) {
+    RunMSSA = llvm::make_unique<MemorySSA>(F, &RunAA, DT);
+    RunMSSAU = llvm::make_unique<MemorySSAUpdater>(RunMSSA.get());
+  }
+  MSSA = RunMSSA.get();
+  MSSAU = RunMSSAU.get();
+  VN.setMemorySSA(MSSA);
+
   unsigned Iteration = 0;
   while (ShouldContinue) {
     LLVM_DEBUG(dbgs() << "GVN iteration: " << Iteration << "\n");
@@ -2070,6 +2367,14 @@ bool GVN::runImpl(Function &F, AssumptionCache &RunAC, DominatorTree &RunDT,
   // iteration.
   DeadBlocks.clear();
 
+#ifdef EXPENSIVE_CHECKS
+  if (MSSA)
+    MSSA->verifyMemorySSA();
+#endif
+  MSSA = nullptr;
+  MSSAU = nullptr;
+  VN.setMemorySSA(nullptr);
+
   return Changed;
 }
 
@@ -2111,6 +2416,7 @@ bool GVN::processBlock(BasicBlock *BB) {
       LLVM_DEBUG(dbgs() << "GVN removed: " << *I << '\n');
       salvageDebugInfo(*I);
       if (MD) MD->removeInstruction(I);
+      if (MSSAU) MSSAU->removeMemoryAccess(I);
       LLVM_DEBUG(verifyRemoved(I));
       if (MaybeFirstICF == I) {
         // We have erased the first ICF in block. The map needs to be updated.
@@ -2375,6 +2681,17 @@ bool GVN::performPRE(Function &F) {
   return Changed;
 }
 
+/// Make the MemoryPhi of \p Succ, if any, take the value it had from \p Pred
+/// from \p NewBB, which was inserted on the edge between them.
+static void updateMemoryPhi(MemorySSA &MSSA, BasicBlock *Pred,
+                            BasicBlock *Succ, BasicBlock *NewBB) {
+  if (MemoryPhi *Phi = MSSA.getMemoryAccess(Succ)) {
+    int Idx = Phi->getBasicBlockIndex(Pred);
+    assert(Idx >= 0 && "MemoryPhi has no entry for the split edge");
+    Phi->setIncomingBlock(Idx, NewBB);
+  }
+}
+
 /// Split the critical edge connecting the given two blocks, and return
 /// the block inserted to the critical edge.
 BasicBlock *GVN::splitCriticalEdges(BasicBlock *Pred, BasicBlock *Succ) {
@@ -2382,6 +2699,8 @@ BasicBlock *GVN::splitCriticalEdges(BasicBlock *Pred, BasicBlock *Succ) {
       SplitCriticalEdge(Pred, Succ, CriticalEdgeSplittingOptions(DT));
   if (MD)
     MD->invalidateCachedPredecessors();
+  if (MSSA && BB)
+    updateMemoryPhi(*MSSA, Pred, Succ, BB);
   return BB;
 }
 
@@ -2392,8 +2711,12 @@ bool GVN::splitCriticalEdges() {
     return false;
   do {
     std::pair<TerminatorInst*, unsigned> Edge = toSplit.pop_back_val();
-    SplitCriticalEdge(Edge.first, Edge.second,
-                      CriticalEdgeSplittingOptions(DT));
+    BasicBlock *Pred = Edge.first->getParent();
+    BasicBlock *Succ = Edge.first->getSuccessor(Edge.second);
+    BasicBlock *BB = SplitCriticalEdge(Edge.first, Edge.second,
+                                       CriticalEdgeSplittingOptions(DT));
+    if (MSSA && BB)
+      updateMemoryPhi(*MSSA, Pred, Succ, BB);
   } while (!toSplit.empty());
   if (MD) MD->invalidateCachedPredecessors();
   return true;
@@ -2629,9 +2952,10 @@ public:
         getAnalysis<DominatorTreeWrapperPass>().getDomTree(),
         getAnalysis<TargetLibraryInfoWrapperPass>().getTLI(),
         getAnalysis<AAResultsWrapperPass>().getAAResults(),
-        NoLoads ? nullptr
-                : &getAnalysis<MemoryDependenceWrapperPass>().getMemDep(),
-        LIWP ? &LIWP->getLoopInfo() : nullptr,
+        NoLoads || GVNUseMemorySSA
+            ? nullptr
+            : &getAnalysis<MemoryDependenceWrapperPass>().getMemDep(),
+        !NoLoads && GVNUseMemorySSA, LIWP ? &LIWP->getLoopInfo() : nullptr,
         &getAnalysis<OptimizationRemarkEmitterWrapperPass>().getORE());
   }
 
@@ -2639,7 +2963,7 @@ public:
     AU.addRequired<AssumptionCacheTracker>();
     AU.addRequired<DominatorTreeWrapperPass>();
     AU.addRequired<TargetLibraryInfoWrapperPass>();
-    if (!NoLoads)
+    if (!NoLoads && !GVNUseMemorySSA)
       AU.addRequired<MemoryDependenceWrapperPass>();
     AU.addRequired<AAResultsWrapperPass>();
 
@@ -24,6 +24,7 @@
 #include "llvm/Analysis/ScalarEvolutionExpander.h"
 #include "llvm/Analysis/ScalarEvolutionExpressions.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/Analysis/ValueTracking.h"
 #include "llvm/IR/CFG.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/Function.h"
@@ -54,17 +55,22 @@ static cl::opt<unsigned> MaxPrefetchIterationsAhead(
     "max-prefetch-iters-ahead",
     cl::desc("Max number of iterations to prefetch ahead"), cl::Hidden);
 
+static cl::opt<bool>
+    PrefetchIndirect("loop-prefetch-indirect", cl::Hidden,
+                     cl::desc("Prefetch indirect accesses such as a[b[i]]"));
+
 STATISTIC(NumPrefetches, "Number of prefetches inserted");
+STATISTIC(NumIndirectPrefetches, "Number of indirect prefetches inserted");
 
 namespace {
 
 /// Loop prefetch implementation class.
 class LoopDataPrefetch {
 public:
-  LoopDataPrefetch(AssumptionCache *AC, LoopInfo *LI, ScalarEvolution *SE,
-                   const TargetTransformInfo *TTI,
+  LoopDataPrefetch(AssumptionCache *AC, DominatorTree *DT, LoopInfo *LI,
+                   ScalarEvolution *SE, const TargetTransformInfo *TTI,
                    OptimizationRemarkEmitter *ORE)
-      : AC(AC), LI(LI), SE(SE), TTI(TTI), ORE(ORE) {}
+      : AC(AC), DT(DT), LI(LI), SE(SE), TTI(TTI), ORE(ORE) {}
 
   bool run();
 
@@ -75,6 +81,24 @@ private:
   /// warrant a prefetch.
   bool isStrideLargeEnough(const SCEVAddRecExpr *AR);
 
+  /// If the only part of \p PtrSCEV that varies in \p L is the value of a
+  /// load whose address is an affine recurrence of \p L, as in a[b[i]],
+  /// return that load.
+  LoadInst *getIndexLoad(const SCEV *PtrSCEV, Loop *L);
+
+  /// Check if \p IndexLoad may be executed up to \p ItersAhead iterations
+  /// ahead: every iteration that is still to come will load the same address.
+  bool canLoadIndexAhead(LoadInst *IndexLoad, Loop *L);
+
+  /// Prefetch the address computed by \p MemI, which depends on
+  /// \p IndexLoad, \p ItersAhead iterations ahead. The load of the index
+  /// \p ItersAhead iterations ahead is cached in \p AheadIndexLoads.
+  bool prefetchIndirect(Instruction *MemI, const SCEV *PtrSCEV,
+                        LoadInst *IndexLoad, unsigned ItersAhead, Loop *L,
+                        DenseMap<LoadInst *, LoadInst *> &AheadIndexLoads);
+
+  void insertPrefetch(Instruction *MemI, Value *PrefPtrValue);
+
   unsigned getMinPrefetchStride() {
     if (MinPrefetchStride.getNumOccurrences() > 0)
       return MinPrefetchStride;
@@ -93,7 +117,14 @@ private:
     return TTI->getMaxPrefetchIterationsAhead();
   }
 
+  bool isIndirectPrefetchEnabled() {
+    if (PrefetchIndirect.getNumOccurrences() > 0)
+      return PrefetchIndirect;
+    return TTI->enableIndirectPrefetch();
+  }
+
   AssumptionCache *AC;
+  DominatorTree *DT;
   LoopInfo *LI;
   ScalarEvolution *SE;
   const TargetTransformInfo *TTI;
@@ -110,6 +141,7 @@ public:
 
   void getAnalysisUsage(AnalysisUsage &AU) const override {
     AU.addRequired<AssumptionCacheTracker>();
+    AU.addRequired<DominatorTreeWrapperPass>();
     AU.addPreserved<DominatorTreeWrapperPass>();
     AU.addRequired<LoopInfoWrapperPass>();
     AU.addPreserved<LoopInfoWrapperPass>();
@@ -127,6 +159,7 @@ char LoopDataPrefetchLegacyPass::ID = 0;
 INITIALIZE_PASS_BEGIN(LoopDataPrefetchLegacyPass, "loop-data-prefetch",
                       "Loop Data Prefetch", false, false)
 INITIALIZE_PASS_DEPENDENCY(AssumptionCacheTracker)
+INITIALIZE_PASS_DEPENDENCY(DominatorTreeWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(TargetTransformInfoWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(LoopInfoWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(OptimizationRemarkEmitterWrapperPass)
@@ -154,8 +187,126 @@ bool LoopDataPrefetch::isStrideLargeEnough(const SCEVAddRecExpr *AR) {
   return TargetMinStride <= AbsStride;
 }
 
+namespace {
+/// Find the load that an address varies with inside a loop.
+struct FindIndexLoad {
+  const Loop *L;
+  LoadInst *IndexLoad = nullptr;
+  bool Failed = false;
+
+  FindIndexLoad(const Loop *L) : L(L) {}
+
+  bool follow(const SCEV *S) {
+    if (const auto *AR = dyn_cast<SCEVAddRecExpr>(S)) {
+      if (L->contains(AR->getLoop()))
+        Failed = true;
+    } else if (const auto *U = dyn_cast<SCEVUnknown>(S)) {
+      auto *I = dyn_cast<Instruction>(U->getValue());
+      if (I && L->contains(I)) {
+        auto *Load = dyn_cast<LoadInst>(I);
+        if (!Load || (IndexLoad && IndexLoad != Load))
+          Failed = true;
+        else
+          IndexLoad = Load;
+      }
+    }
+    return !Failed;
+  }
+  bool isDone() const { return Failed; }
+};
+} // end anonymous namespace
+
+LoadInst *LoopDataPrefetch::getIndexLoad(const SCEV *PtrSCEV, Loop *L) {
+  FindIndexLoad Finder(L);
+  visitAll(PtrSCEV, Finder);
+  if (Finder.Failed || !Finder.IndexLoad || !Finder.IndexLoad->isSimple())
+    return nullptr;
+
+  const auto *IndexAR = dyn_cast<SCEVAddRecExpr>(
+      SE->getSCEV(Finder.IndexLoad->getPointerOperand()));
+  if (!IndexAR || IndexAR->getLoop() != L || !IndexAR->isAffine())
+    return nullptr;
+  return Finder.IndexLoad;
+}
+
+bool LoopDataPrefetch::canLoadIndexAhead(LoadInst *IndexLoad, Loop *L) {
+  // The index is loaded at min(i + ItersAhead, BackedgeTakenCount), which is
+  // only known to be dereferenceable if the loop runs all of its iterations,
+  // and the index load is executed in each of them.
+  BasicBlock *Latch = L->getLoopLatch();
+  if (!Latch || L->getExitingBlock() != Latch ||
+      !DT->dominates(IndexLoad->getParent(), Latch))
+    return false;
+  if (isa<SCEVCouldNotCompute>(SE->getBackedgeTakenCount(L)))
+    return false;
+  for (const auto BB : L->blocks())
+    if (!isGuaranteedToTransferExecutionToSuccessor(BB))
+      return false;
+  return true;
+}
+
+bool LoopDataPrefetch::prefetchIndirect(
+    Instruction *MemI, const SCEV *PtrSCEV, LoadInst *IndexLoad,
+    unsigned ItersAhead, Loop *L,
+    DenseMap<LoadInst *, LoadInst *> &AheadIndexLoads) {
+  const DataLayout &DL = MemI->getModule()->getDataLayout();
+
+  LoadInst *&AheadIndex = AheadIndexLoads[IndexLoad];
+  if (!AheadIndex || !DT->dominates(AheadIndex, MemI)) {
+    // Compute i + umin(ItersAhead, BackedgeTakenCount - i), which doesn't
+    // overflow since i <= BackedgeTakenCount.
+    const SCEV *BTC = SE->getBackedgeTakenCount(L);
+    Type *CountTy = BTC->getType();
+    const SCEV *IV = SE->getAddRecExpr(SE->getZero(CountTy),
+                                       SE->getOne(CountTy), L, SCEV::FlagNUW);
+    const SCEV *AheadIter = SE->getAddExpr(
+        IV, SE->getUMinExpr(SE->getConstant(CountTy, ItersAhead),
+                            SE->getMinusSCEV(BTC, IV)));
+
+    const auto *IndexAR =
+        cast<SCEVAddRecExpr>(SE->getSCEV(IndexLoad->getPointerOperand()));
+    const SCEV *Step = IndexAR->getStepRecurrence(*SE);
+    const SCEV *AheadOffset = SE->getMulExpr(
+        Step, SE->getTruncateOrZeroExtend(AheadIter, Step->getType()));
+    const SCEV *AheadAddr = SE->getAddExpr(IndexAR->getStart(), AheadOffset);
+    if (!isSafeToExpand(AheadAddr, *SE))
+      return false;
+
+    SCEVExpander SCEVE(*SE, DL, "prefidxaddr");
+    Value *AheadAddrValue = SCEVE.expandCodeFor(
+        AheadAddr, IndexLoad->getPointerOperand()->getType(), MemI);
+    IRBuilder<> Builder(MemI);
+    AheadIndex = Builder.CreateAlignedLoad(
+        AheadAddrValue, IndexLoad->getAlignment(), "prefidx");
+  }
+
+  ValueToValueMap Map;
+  Map[IndexLoad] = AheadIndex;
+  const SCEV *NextPtrSCEV = SCEVParameterRewriter::rewrite(PtrSCEV, *SE, Map);
+  if (!isSafeToExpand(NextPtrSCEV, *SE))
+    return false;
+
+  Type *I8Ptr = Type::getInt8PtrTy(MemI->getContext());
+  SCEVExpander SCEVE(*SE, DL, "prefaddr");
+  insertPrefetch(MemI, SCEVE.expandCodeFor(NextPtrSCEV, I8Ptr, MemI));
+  return true;
+}
+
+void LoopDataPrefetch::insertPrefetch(Instruction *MemI, Value *PrefPtrValue) {
+  IRBuilder<> Builder(MemI);
+  Module *M = MemI->getModule();
+  Type *I32 = Type::getInt32Ty(MemI->getContext());
+  Value *PrefetchFunc = Intrinsic::getDeclaration(M, Intrinsic::prefetch);
+  Builder.CreateCall(
+      PrefetchFunc,
+      {PrefPtrValue,
+       ConstantInt::get(I32, MemI->mayReadFromMemory() ? 0 : 1),
+       ConstantInt::get(I32, 3), ConstantInt::get(I32, 1)});
+}
+
 PreservedAnalyses LoopDataPrefetchPass::run(Function &F,
                                             FunctionAnalysisManager &AM) {
+  DominatorTree *DT = &AM.getResult<DominatorTreeAnalysis>(F);
   LoopInfo *LI = &AM.getResult<LoopAnalysis>(F);
   ScalarEvolution *SE = &AM.getResult<ScalarEvolutionAnalysis>(F);
   AssumptionCache *AC = &AM.getResult<AssumptionAnalysis>(F);
@@ -163,7 +314,7 @@ PreservedAnalyses LoopDataPrefetchPass::run(Function &F,
       &AM.getResult<OptimizationRemarkEmitterAnalysis>(F);
   const TargetTransformInfo *TTI = &AM.getResult<TargetIRAnalysis>(F);
 
-  LoopDataPrefetch LDP(AC, LI, SE, TTI, ORE);
+  LoopDataPrefetch LDP(AC, DT, LI, SE, TTI, ORE);
   bool Changed = LDP.run();
 
   if (Changed) {
@@ -180,6 +331,7 @@ bool LoopDataPrefetchLegacyPass::runOnFunction(Function &F) {
   if (skipFunction(F))
     return false;
 
+  DominatorTree *DT = &getAnalysis<DominatorTreeWrapperPass>().getDomTree();
   LoopInfo *LI = &getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
   ScalarEvolution *SE = &getAnalysis<ScalarEvolutionWrapperPass>().getSE();
   AssumptionCache *AC =
@@ -189,7 +341,7 @@ bool LoopDataPrefetchLegacyPass::runOnFunction(Function &F) {
   const TargetTransformInfo *TTI =
       &getAnalysis<TargetTransformInfoWrapperPass>().getTTI(F);
 
-  LoopDataPrefetch LDP(AC, LI, SE, TTI, ORE);
+  LoopDataPrefetch LDP(AC, DT, LI, SE, TTI, ORE);
   return LDP.run();
 }
 
@@ -220,8 +372,11 @@ bool LoopDataPrefetch::runOnLoop(Loop *L) {
   SmallPtrSet<const Value *, 32> EphValues;
   CodeMetrics::collectEphemeralValues(L, AC, EphValues);
 
+  bool IndirectEnabled = isIndirectPrefetchEnabled();
+
   // Calculate the number of iterations ahead to prefetch
   CodeMetrics Metrics;
+  unsigned LoopLatency = 0;
   for (const auto BB : L->blocks()) {
     // If the loop already has prefetches, then assume that the user knows
     // what they are doing and don't add any more.
@@ -232,6 +387,14 @@ bool LoopDataPrefetch::runOnLoop(Loop *L) {
             return MadeChange;
 
     Metrics.analyzeBasicBlock(BB, *TTI, EphValues);
+
+    // Indirect accesses are prefetched far enough ahead to hide the distance,
+    // taken as a latency, behind the latency of the loop body.
+    if (IndirectEnabled)
+      for (auto &I : *BB)
+        if (!EphValues.count(&I))
+          LoopLatency += std::max(
+              TTI->getInstructionCost(&I, TargetTransformInfo::TCK_Latency), 0);
   }
   unsigned LoopSize = Metrics.NumInsts;
   if (!LoopSize)
@@ -249,6 +412,8 @@ bool LoopDataPrefetch::runOnLoop(Loop *L) {
                     << L->getHeader()->getParent()->getName() << ": " << *L);
 
   SmallVector<std::pair<Instruction *, const SCEVAddRecExpr *>, 16> PrefLoads;
+  SmallVector<std::tuple<Instruction *, const SCEV *, LoadInst *>, 8>
+      IndirectLoads;
   for (const auto BB : L->blocks()) {
     for (auto &I : *BB) {
       Value *PtrValue;
@@ -272,8 +437,12 @@ bool LoopDataPrefetch::runOnLoop(Loop *L) {
 
       const SCEV *LSCEV = SE->getSCEV(PtrValue);
       const SCEVAddRecExpr *LSCEVAddRec = dyn_cast<SCEVAddRecExpr>(LSCEV);
-      if (!LSCEVAddRec)
+      if (!LSCEVAddRec) {
+        if (IndirectEnabled)
+          if (LoadInst *IndexLoad = getIndexLoad(LSCEV, L))
+            IndirectLoads.push_back(std::make_tuple(MemI, LSCEV, IndexLoad));
         continue;
+      }
 
       // Check if the stride of the accesses is large enough to warrant a
       // prefetch.
@@ -309,16 +478,7 @@ bool LoopDataPrefetch::runOnLoop(Loop *L) {
       Type *I8Ptr = Type::getInt8PtrTy(BB->getContext(), PtrAddrSpace);
       SCEVExpander SCEVE(*SE, I.getModule()->getDataLayout(), "prefaddr");
       Value *PrefPtrValue = SCEVE.expandCodeFor(NextLSCEV, I8Ptr, MemI);
-
-      IRBuilder<> Builder(MemI);
-      Module *M = BB->getParent()->getParent();
-      Type *I32 = Type::getInt32Ty(BB->getContext());
-      Value *PrefetchFunc = Intrinsic::getDeclaration(M, Intrinsic::prefetch);
-      Builder.CreateCall(
-          PrefetchFunc,
-          {PrefPtrValue,
-           ConstantInt::get(I32, MemI->mayReadFromMemory() ? 0 : 1),
-           ConstantInt::get(I32, 3), ConstantInt::get(I32, 1)});
+      insertPrefetch(MemI, PrefPtrValue);
       ++NumPrefetches;
       LLVM_DEBUG(dbgs() << "  Access: " << *PtrValue << ", SCEV: " << *LSCEV
                         << "\n");
@@ -331,6 +491,62 @@ bool LoopDataPrefetch::runOnLoop(Loop *L) {
     }
   }
 
+  if (IndirectLoads.empty())
+    return MadeChange;
+
+  if (!LoopLatency)
+    LoopLatency = 1;
+  unsigned IndirectItersAhead =
+      (getPrefetchDistance() + LoopLatency - 1) / LoopLatency;
+  if (IndirectItersAhead > getMaxPrefetchIterationsAhead())
+    return MadeChange;
+
+  LLVM_DEBUG(dbgs() << "Prefetching indirect accesses " << IndirectItersAhead
+                    << " iterations ahead (loop latency: " << LoopLatency
+                    << ")\n");
+
+  SmallVector<std::pair<LoadInst *, const SCEV *>, 8> IndirectPrefetched;
+  DenseMap<LoadInst *, LoadInst *> AheadIndexLoads;
+  for (const auto &IndirectLoad : IndirectLoads) {
+    Instruction *MemI = std::get<0>(IndirectLoad);
+    const SCEV *LSCEV = std::get<1>(IndirectLoad);
+    LoadInst *IndexLoad = std::get<2>(IndirectLoad);
+
+    // As above, skip accesses within a cache line of an access that was
+    // already prefetched through the same index.
+    bool DupPref = false;
+    for (const auto &Prefetched : IndirectPrefetched) {
+      if (Prefetched.first != IndexLoad)
+        continue;
+      const SCEV *PtrDiff = SE->getMinusSCEV(LSCEV, Prefetched.second);
+      if (const SCEVConstant *ConstPtrDiff = dyn_cast<SCEVConstant>(PtrDiff)) {
+        int64_t PD = std::abs(ConstPtrDiff->getValue()->getSExtValue());
+        if (PD < (int64_t) TTI->getCacheLineSize()) {
+          DupPref = true;
+          break;
+        }
+      }
+    }
+    if (DupPref || !canLoadIndexAhead(IndexLoad, L))
+      continue;
+
+    if (!prefetchIndirect(MemI, LSCEV, IndexLoad, IndirectItersAhead, L,
+                          AheadIndexLoads))
+      continue;
+
+    IndirectPrefetched.push_back(std::make_pair(IndexLoad, LSCEV));
+    ++NumPrefetches;
+    ++NumIndirectPrefetches;
+    LLVM_DEBUG(dbgs() << "  Indirect access: " << *MemI << ", index: "
+                      << *IndexLoad << "\n");
+    ORE->emit([&]() {
+      return OptimizationRemark(DEBUG_TYPE, "PrefetchedIndirect", MemI)
+             << "prefetched indirect memory access";
+    });
+
+    MadeChange = true;
+  }
+
   return MadeChange;
 }
 
@@ -0,0 +1,429 @@
+//===- LoopTile.cpp - Loop tiling pass ------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This pass tiles perfect nests of two loops for cache reuse. The inner loop
+// is strip-mined, and the loop over its tiles is moved outside the outer loop:
+//
+//   for (i = 0; i < N; ++i)           for (jj = 0; jj < M; jj += T)
+//     for (j = 0; j < M; ++j)    =>     for (i = 0; i < N; ++i)
+//       S(i, j);                          for (j = jj; j < min(jj + T, M); ++j)
+//                                           S(i, j);
+//
+// This keeps the lines touched by a tile of the inner loop in the cache across
+// the iterations of the outer loop. The nest is tiled if CacheCost estimates
+// that a run of the inner loop doesn't fit in the cache while the outer loop
+// reuses some of its lines, or if the inner loop has llvm.loop.tile metadata.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/DependenceAnalysis.h"
+#include "llvm/Analysis/LoopCacheAnalysis.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/ScalarEvolutionExpander.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DiagnosticInfo.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Scalar.h"
+#include "llvm/Transforms/Utils.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include "llvm/Transforms/Utils/Local.h"
+#include "llvm/Transforms/Utils/LoopUtils.h"
+
+using namespace llvm;
+
+#define DEBUG_TYPE "loop-tile"
+
+STATISTIC(LoopsTiled, "Number of loops tiled");
+
+static cl::opt<unsigned>
+    LoopTileSize("loop-tile-size", cl::init(0), cl::Hidden,
+                 cl::desc("Tile size to use instead of the one derived from "
+                          "the cache size"));
+
+static cl::opt<unsigned>
+    LoopTileCacheSize("loop-tile-cache-size", cl::init(0), cl::Hidden,
+                      cl::desc("Size in bytes of the cache the tiles should "
+                               "fit in (default: the L1 data cache size)"));
+
+// Tile size used when the nest can't be costed but tiling is forced by
+// metadata.
+static const unsigned DefaultTileSize = 64;
+
+namespace {
+
+/// A perfect nest of two loops that can be tiled.
+struct TileCandidate {
+  Loop *Outer;
+  Loop *Inner;
+  PHINode *InnerIV;
+  unsigned TileSize;
+};
+
+struct LoopTile : public FunctionPass {
+  static char ID;
+  ScalarEvolution *SE = nullptr;
+  DependenceInfo *DI = nullptr;
+  const TargetTransformInfo *TTI = nullptr;
+  OptimizationRemarkEmitter *ORE = nullptr;
+
+  LoopTile() : FunctionPass(ID) {
+    initializeLoopTilePass(*PassRegistry::getPassRegistry());
+  }
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override {
+    AU.addRequired<ScalarEvolutionWrapperPass>();
+    AU.addRequired<LoopInfoWrapperPass>();
+    AU.addRequired<DependenceAnalysisWrapperPass>();
+    AU.addRequired<TargetTransformInfoWrapperPass>();
+    AU.addRequiredID(LoopSimplifyID);
+    AU.addRequiredID(LCSSAID);
+    AU.addRequired<OptimizationRemarkEmitterWrapperPass>();
+  }
+
+  bool runOnFunction(Function &F) override;
+
+private:
+  PHINode *getTileableIV(Loop *Outer, Loop *Inner);
+  bool isLegal(Loop *Outer, Loop *Inner);
+  unsigned getTileSize(Loop *Outer, Loop *Inner);
+  void tile(const TileCandidate &C);
+};
+
+} // end anonymous namespace
+
+/// Returns the value of the llvm.loop.tile.enable metadata of \p L, or None.
+static Optional<bool> getTileEnable(Loop *L) {
+  Optional<const MDOperand *> Op =
+      findStringMetadataForLoop(L, "llvm.loop.tile.enable");
+  if (!Op)
+    return None;
+  if (!*Op)
+    return true;
+  return !mdconst::extract<ConstantInt>(**Op)->isZero();
+}
+
+/// Returns the value of the llvm.loop.tile.size metadata of \p L, or 0.
+static unsigned getTileSizeMetadata(Loop *L) {
+  Optional<const MDOperand *> Op =
+      findStringMetadataForLoop(L, "llvm.loop.tile.size");
+  if (!Op || !*Op)
+    return 0;
+  return mdconst::extract<ConstantInt>(**Op)->getZExtValue();
+}
+
+/// Returns true if the nest is tiled because of metadata, whatever its cost.
+static bool isTilingForced(Loop *Inner) {
+  return getTileEnable(Inner).getValueOr(false) || getTileSizeMetadata(Inner);
+}
+
+/// Returns the induction variable of \p Inner to strip-mine, if the nest of
+/// \p Outer and \p Inner has the shape the transformation expects.
+PHINode *LoopTile::getTileableIV(Loop *Outer, Loop *Inner) {
+  for (Loop *L : {Outer, Inner}) {
+    if (!L->isLoopSimplifyForm() || !L->getExitBlock() ||
+        L->getExitingBlock() != L->getLoopLatch()) {
+      LLVM_DEBUG(dbgs() << "Loop " << L->getHeader()->getName()
+                        << " is not rotated with a single exit\n");
+      return nullptr;
+    }
+    // The loops iterate over the same range in each tile, so they may not
+    // carry any value other than their induction variable.
+    auto Phis = L->getHeader()->phis();
+    if (std::distance(Phis.begin(), Phis.end()) != 1)
+      return nullptr;
+  }
+
+  // The outer loop may only branch to the inner loop, and only compute
+  // addresses and indices besides it.
+  for (BasicBlock *BB : Outer->blocks()) {
+    if (Inner->contains(BB))
+      continue;
+    auto *Br = dyn_cast<BranchInst>(BB->getTerminator());
+    if (!Br || (BB != Outer->getLoopLatch() && !Br->isUnconditional()))
+      return nullptr;
+    for (Instruction &I : *BB)
+      if (I.mayReadOrWriteMemory() || I.mayHaveSideEffects())
+        return nullptr;
+  }
+
+  // Values computed in a tile may not be used after it.
+  for (BasicBlock *BB : Outer->blocks())
+    for (Instruction &I : *BB)
+      for (User *U : I.users())
+        if (!(Inner->contains(BB) ? Inner : Outer)
+                 ->contains(cast<Instruction>(U)))
+          return nullptr;
+
+  PHINode *IV = &*Inner->getHeader()->phis().begin();
+  InductionDescriptor ID;
+  if (!InductionDescriptor::isInductionPHI(IV, Inner, SE, ID) ||
+      ID.getKind() != InductionDescriptor::IK_IntInduction)
+    return nullptr;
+  ConstantInt *Step = ID.getConstIntStepValue();
+  if (!Step || !Step->isOne() || !Outer->isLoopInvariant(ID.getStartValue()))
+    return nullptr;
+  if (!isa<Instruction>(IV->getIncomingValueForBlock(Inner->getLoopLatch())))
+    return nullptr;
+
+  // Each run of the inner loop runs the same, computable, number of
+  // iterations, which are split into tiles.
+  const SCEV *BTC = SE->getBackedgeTakenCount(Inner);
+  if (isa<SCEVCouldNotCompute>(BTC) || BTC->getType() != IV->getType() ||
+      !SE->isLoopInvariant(BTC, Outer) || !isSafeToExpand(BTC, *SE)) {
+    LLVM_DEBUG(dbgs() << "Inner trip count varies or can't be computed\n");
+    return nullptr;
+  }
+  return IV;
+}
+
+/// Check that running the iterations of \p Inner tile by tile across
+/// \p Outer preserves the dependences of the nest.
+bool LoopTile::isLegal(Loop *Outer, Loop *Inner) {
+  SmallVector<Instruction *, 16> MemInstrs;
+  for (BasicBlock *BB : Inner->blocks())
+    for (Instruction &I : *BB) {
+      if (!I.mayReadOrWriteMemory())
+        continue;
+      if (auto *LI = dyn_cast<LoadInst>(&I)) {
+        if (!LI->isSimple())
+          return false;
+      } else if (auto *SI = dyn_cast<StoreInst>(&I)) {
+        if (!SI->isSimple())
+          return false;
+      } else {
+        return false;
+      }
+      MemInstrs.push_back(&I);
+    }
+
+  // Tiling runs iteration (i + 1, j) before (i, j + T). It is illegal if a
+  // dependence goes from the latter to the former, i.e. has direction (<, >)
+  // or (>, <).
+  unsigned OuterLevel = Outer->getLoopDepth();
+  unsigned InnerLevel = Inner->getLoopDepth();
+  for (unsigned I = 0, E = MemInstrs.size(); I != E; ++I)
+    for (unsigned J = I; J != E; ++J) {
+      Instruction *Src = MemInstrs[I], *Dst = MemInstrs[J];
+      if (!Src->mayWriteToMemory() && !Dst->mayWriteToMemory())
+        continue;
+      std::unique_ptr<Dependence> D = DI->depends(Src, Dst, true);
+      if (!D)
+        continue;
+      if (D->isConfused())
+        return false;
+      unsigned OuterDir = D->getDirection(OuterLevel);
+      unsigned InnerDir = D->getDirection(InnerLevel);
+      if (((OuterDir & Dependence::DVEntry::LT) &&
+           (InnerDir & Dependence::DVEntry::GT)) ||
+          ((OuterDir & Dependence::DVEntry::GT) &&
+           (InnerDir & Dependence::DVEntry::LT))) {
+        LLVM_DEBUG(dbgs() << "Tiling would violate the dependence from "
+                          << *Src << " to " << *Dst << "\n");
+        return false;
+      }
+    }
+  return true;
+}
+
+/// Returns the number of iterations of \p Inner per tile, or 0 if the nest
+/// shouldn't be tiled.
+unsigned LoopTile::getTileSize(Loop *Outer, Loop *Inner) {
+  bool Forced = isTilingForced(Inner);
+  if (unsigned Size = getTileSizeMetadata(Inner))
+    return Size;
+  if (LoopTileSize.getNumOccurrences() > 0)
+    return LoopTileSize;
+
+  std::unique_ptr<CacheCost> CC = CacheCost::get(*Outer, *SE, *TTI);
+  if (!CC)
+    return Forced ? DefaultTileSize : 0;
+
+  uint64_t CacheSize = LoopTileCacheSize;
+  if (!CacheSize)
+    CacheSize = TTI->getCacheSize(TargetTransformInfo::CacheLevel::L1D)
+                    .getValueOr(32 * 1024);
+  uint64_t Footprint = SaturatingMultiply(CC->getFootprint(*Inner),
+                                          (uint64_t)CC->getCacheLineSize());
+  uint64_t TripCount = CC->getTripCount(*Inner);
+
+  ORE->emit([&]() {
+    return OptimizationRemarkAnalysis(DEBUG_TYPE, "CacheCost",
+                                      Inner->getStartLoc(), Inner->getHeader())
+           << "cache cost with the outer loop innermost: "
+           << ore::NV("OuterCost", CC->getLoopCost(*Outer))
+           << ", with the inner loop innermost: "
+           << ore::NV("InnerCost", CC->getLoopCost(*Inner))
+           << ", inner loop footprint: " << ore::NV("Footprint", Footprint)
+           << " bytes";
+  });
+
+  bool Profitable =
+      CC->hasReuseAcross(*Outer, *Inner) && Footprint > CacheSize;
+  if (!Profitable && !Forced)
+    return 0;
+
+  // Make a tile use half of the cache, leaving room for the other data.
+  uint64_t Size = Footprint ? TripCount * (CacheSize / 2) / Footprint
+                            : TripCount;
+  Size = PowerOf2Floor(std::max<uint64_t>(Size, 1));
+  if (Size >= TripCount && !Forced)
+    return 0;
+  return std::min<uint64_t>(Size, UINT_MAX);
+}
+
+void LoopTile::tile(const TileCandidate &C) {
+  Loop *Outer = C.Outer, *Inner = C.Inner;
+  PHINode *IV = C.InnerIV;
+  Type *IVTy = IV->getType();
+  BasicBlock *OuterPH = Outer->getLoopPreheader();
+  BasicBlock *OuterLatch = Outer->getLoopLatch();
+  BasicBlock *OuterExit = Outer->getExitBlock();
+  BasicBlock *InnerPH = Inner->getLoopPreheader();
+  BasicBlock *InnerLatch = Inner->getLoopLatch();
+  Value *Start = IV->getIncomingValueForBlock(InnerPH);
+  Value *IVNext = IV->getIncomingValueForBlock(InnerLatch);
+  LLVMContext &Ctx = IV->getContext();
+
+  // The inner loop runs BTC + 1 iterations, from Start to Start + BTC.
+  SCEVExpander Expander(*SE, OuterPH->getModule()->getDataLayout(), "tile");
+  Value *BTC = Expander.expandCodeFor(SE->getBackedgeTakenCount(Inner), IVTy,
+                                      OuterPH->getTerminator());
+
+  // Insert the loop over the tiles around the outer loop.
+  BasicBlock *TileHeader = SplitBlock(OuterPH, OuterPH->getTerminator());
+  TileHeader->setName("tile.header");
+  BasicBlock *NewOuterPH = SplitBlock(TileHeader, TileHeader->getTerminator());
+  NewOuterPH->setName(Outer->getHeader()->getName() + ".ph");
+  BasicBlock *TileLatch = BasicBlock::Create(Ctx, "tile.latch",
+                                             OuterExit->getParent(), OuterExit);
+  OuterLatch->getTerminator()->replaceUsesOfWith(OuterExit, TileLatch);
+  for (PHINode &PN : OuterExit->phis())
+    PN.setIncomingBlock(PN.getBasicBlockIndex(OuterLatch), TileLatch);
+
+  // The tile starting at iteration TileIV runs min(T, BTC - TileIV + 1)
+  // iterations, and is the last one if BTC - TileIV < T. This can't overflow
+  // since TileIV <= BTC.
+  PHINode *TileIV =
+      PHINode::Create(IVTy, 2, "tile.iv", &TileHeader->front());
+  IRBuilder<> Builder(TileHeader->getTerminator());
+  Value *Remaining = Builder.CreateSub(BTC, TileIV, "tile.remaining");
+  Value *IsLast = Builder.CreateICmpULT(
+      Remaining, ConstantInt::get(IVTy, C.TileSize), "tile.last");
+  Value *LastOffset = Builder.CreateSelect(
+      IsLast, Remaining, ConstantInt::get(IVTy, C.TileSize - 1));
+  Value *TileStart = Builder.CreateAdd(Start, TileIV, "tile.start");
+  Value *TileEnd = Builder.CreateAdd(Builder.CreateAdd(TileStart, LastOffset),
+                                     ConstantInt::get(IVTy, 1), "tile.end");
+
+  Builder.SetInsertPoint(TileLatch);
+  Value *TileIVNext = Builder.CreateAdd(
+      TileIV, ConstantInt::get(IVTy, C.TileSize), "tile.iv.next");
+  Builder.CreateCondBr(IsLast, OuterExit, TileHeader);
+  TileIV->addIncoming(ConstantInt::get(IVTy, 0), OuterPH);
+  TileIV->addIncoming(TileIVNext, TileLatch);
+
+  // Make the inner loop run over the current tile.
+  IV->setIncomingValue(IV->getBasicBlockIndex(InnerPH), TileStart);
+  auto *LatchBr = cast<BranchInst>(InnerLatch->getTerminator());
+  bool ExitOnTrue = !Inner->contains(LatchBr->getSuccessor(0));
+  Builder.SetInsertPoint(LatchBr);
+  Value *ExitCond =
+      ExitOnTrue ? Builder.CreateICmpEQ(IVNext, TileEnd, "tile.exitcond")
+                 : Builder.CreateICmpNE(IVNext, TileEnd, "tile.exitcond");
+  Value *OldCond = LatchBr->getCondition();
+  LatchBr->setCondition(ExitCond);
+  RecursivelyDeleteTriviallyDeadInstructions(OldCond);
+
+  SE->forgetLoop(Outer);
+}
+
+bool LoopTile::runOnFunction(Function &F) {
+  if (skipFunction(F))
+    return false;
+
+  SE = &getAnalysis<ScalarEvolutionWrapperPass>().getSE();
+  LoopInfo *LI = &getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
+  DI = &getAnalysis<DependenceAnalysisWrapperPass>().getDI();
+  TTI = &getAnalysis<TargetTransformInfoWrapperPass>().getTTI(F);
+  ORE = &getAnalysis<OptimizationRemarkEmitterWrapperPass>().getORE();
+
+  // Decide on all nests first: tiling one nest leaves LoopInfo stale, but
+  // doesn't touch the blocks of the others.
+  SmallVector<TileCandidate, 4> Candidates;
+  SmallVector<Loop *, 8> Worklist(LI->begin(), LI->end());
+  while (!Worklist.empty()) {
+    Loop *Inner = Worklist.pop_back_val();
+    Worklist.append(Inner->begin(), Inner->end());
+    Loop *Outer = Inner->getParentLoop();
+    if (!Inner->empty() || !Outer || Outer->getSubLoops().size() != 1)
+      continue;
+    if (!getTileEnable(Inner).getValueOr(true))
+      continue;
+
+    PHINode *IV = getTileableIV(Outer, Inner);
+    bool Legal = IV && isLegal(Outer, Inner);
+    if (!Legal) {
+      if (isTilingForced(Inner))
+        ORE->emit([&]() {
+          return OptimizationRemarkMissed(DEBUG_TYPE, "NotTiled",
+                                          Inner->getStartLoc(),
+                                          Inner->getHeader())
+                 << "loop not tiled: the loop nest is not perfect or its "
+                    "dependences prevent tiling";
+        });
+      continue;
+    }
+
+    if (unsigned TileSize = getTileSize(Outer, Inner))
+      Candidates.push_back({Outer, Inner, IV, TileSize});
+  }
+
+  for (const TileCandidate &C : Candidates) {
+    LLVM_DEBUG(dbgs() << "Tiling loop " << C.Inner->getHeader()->getName()
+                      << " with tile size " << C.TileSize << "\n");
+    ORE->emit([&]() {
+      return OptimizationRemark(DEBUG_TYPE, "Tiled", C.Inner->getStartLoc(),
+                                C.Inner->getHeader())
+             << "tiled loop with tile size "
+             << ore::NV("TileSize", C.TileSize);
+    });
+    tile(C);
+    ++LoopsTiled;
+  }
+  return !Candidates.empty();
+}
+
+char LoopTile::ID = 0;
+
+INITIALIZE_PASS_BEGIN(LoopTile, "loop-tile", "Tile loops for cache reuse",
+                      false, false)
+INITIALIZE_PASS_DEPENDENCY(DependenceAnalysisWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(ScalarEvolutionWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(LoopSimplify)
+INITIALIZE_PASS_DEPENDENCY(LCSSAWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(LoopInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(TargetTransformInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(OptimizationRemarkEmitterWrapperPass)
+INITIALIZE_PASS_END(LoopTile, "loop-tile", "Tile loops for cache reuse",
+                    false, false)
+
+Pass *llvm::createLoopTilePass() { return new LoopTile(); }
@@ -29,6 +29,7 @@
 #include "llvm/IR/CFG.h"
 #include "llvm/IR/Constant.h"
 #include "llvm/IR/Constants.h"
+#include "llvm/IR/DataLayout.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Instruction.h"
@@ -41,6 +42,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/Scalar.h"
 #include "llvm/Transforms/Scalar/LoopPassManager.h"
@@ -69,6 +71,11 @@ static cl::opt<unsigned> UnrollAndJamThreshold(
     "unroll-and-jam-threshold", cl::init(60), cl::Hidden,
     cl::desc("Threshold to use for inner loop when doing unroll and jam."));
 
+static cl::opt<bool> UnrollAndJamRegisterPressure(
+    "unroll-and-jam-register-pressure", cl::init(true), cl::Hidden,
+    cl::desc("Limit the unroll and jam count so that the inner loop doesn't "
+             "need more registers than the target has."));
+
 static cl::opt<unsigned> PragmaUnrollAndJamThreshold(
     "pragma-unroll-and-jam-threshold", cl::init(1024), cl::Hidden,
     cl::desc("Unrolled size limit for loops with an unroll_and_jam(full) or "
@@ -140,6 +147,159 @@ getUnrollAndJammedLoopSize(unsigned LoopSize,
   return static_cast<uint64_t>(LoopSize - UP.BEInsns) * UP.Count + UP.BEInsns;
 }
 
+namespace {
+
+// Estimates the register pressure of the inner loop after unroll and jam, in
+// the manner of LoopVectorizationCostModel::calculateRegisterUsage. The values
+// that depend on the outer loop are replicated by unroll and jam; the others,
+// like the addresses and results of loads that are invariant in the outer
+// loop, are shared by the jammed copies once these are CSE'd. Vector and
+// floating point values use the vector registers of the target, if it has any,
+// and the other values its scalar registers. Unroll and jam runs after the
+// loop vectorizer, so the vector values of a vectorized inner loop are counted
+// at their actual width.
+class InnerLoopRegisterUsage {
+public:
+  InnerLoopRegisterUsage(Loop *L, Loop *SubLoop,
+                         const TargetTransformInfo &TTI);
+
+  // Returns true if the inner loop needs more registers of some class than
+  // the target has, once unroll and jammed by Count.
+  bool exceedsRegisters(unsigned Count) const;
+
+private:
+  enum RegClass { ScalarRC, VectorRC, NumRegClasses };
+
+  // Registers used by the shared and by the replicated values.
+  struct LiveRegs {
+    unsigned Shared[NumRegClasses] = {};
+    unsigned Replicated[NumRegClasses] = {};
+
+    void add(RegClass RC, unsigned NumRegs, bool IsReplicated) {
+      (IsReplicated ? Replicated : Shared)[RC] += NumRegs;
+    }
+  };
+
+  RegClass getRegClass(Type *Ty) const;
+  unsigned getNumRegs(Type *Ty, RegClass RC) const;
+
+  const TargetTransformInfo &TTI;
+  const DataLayout &DL;
+
+  // Values defined outside of the inner loop and used in it.
+  LiveRegs LiveIns;
+  // Values defined in the inner loop and live after each of its instructions.
+  SmallVector<LiveRegs, 32> Live;
+};
+
+} // end anonymous namespace
+
+InnerLoopRegisterUsage::InnerLoopRegisterUsage(Loop *L, Loop *SubLoop,
+                                               const TargetTransformInfo &TTI)
+    : TTI(TTI), DL(L->getHeader()->getModule()->getDataLayout()) {
+  assert(SubLoop->getNumBlocks() == 1 && "Expected a single block subloop");
+  BasicBlock *BB = SubLoop->getHeader();
+
+  // Find the values of the inner loop that depend on the outer loop.
+  SmallPtrSet<const Value *, 16> Replicated;
+  auto IsReplicated = [&](const Value *V) {
+    auto *I = dyn_cast<Instruction>(V);
+    return I && L->contains(I) &&
+           (!SubLoop->contains(I) || Replicated.count(I));
+  };
+  for (bool Changed = true; Changed;) {
+    Changed = false;
+    for (Instruction &I : *BB)
+      if (!Replicated.count(&I) && any_of(I.operands(), IsReplicated)) {
+        Replicated.insert(&I);
+        Changed = true;
+      }
+  }
+
+  // Conditions are usually folded into the branches and selects using them.
+  auto NeedsReg = [](const Value *V) {
+    return V->getType()->isSized() && !V->getType()->isIntegerTy(1);
+  };
+
+  // The incoming values of the phis share the registers of the phis.
+  SmallPtrSet<const Value *, 16> SeenLiveIns;
+  for (Instruction &I : BB->instructionsWithoutDebug()) {
+    if (isa<PHINode>(I))
+      continue;
+    for (const Value *Op : I.operands()) {
+      if (!isa<Instruction>(Op) && !isa<Argument>(Op))
+        continue;
+      auto *OpI = dyn_cast<Instruction>(Op);
+      if ((OpI && SubLoop->contains(OpI)) || !NeedsReg(Op) ||
+          !SeenLiveIns.insert(Op).second)
+        continue;
+      RegClass RC = getRegClass(Op->getType());
+      LiveIns.add(RC, getNumRegs(Op->getType(), RC), IsReplicated(Op));
+    }
+  }
+
+  // Number the instructions of the inner loop and find where the live range
+  // of each value ends. Values used by the phis or outside of the inner loop
+  // live until its end.
+  DenseMap<const Instruction *, unsigned> Idx;
+  unsigned End = 0;
+  for (Instruction &I : BB->instructionsWithoutDebug())
+    Idx[&I] = End++;
+  SmallVector<std::pair<unsigned, unsigned>, 32> Ranges;
+  SmallVector<const Instruction *, 32> Defs;
+  for (Instruction &I : BB->instructionsWithoutDebug()) {
+    if (!NeedsReg(&I))
+      continue;
+    unsigned LastUse = Idx[&I];
+    for (const User *U : I.users()) {
+      auto *UI = cast<Instruction>(U);
+      if (isa<PHINode>(UI) || UI->getParent() != BB)
+        LastUse = End;
+      else
+        LastUse = std::max(LastUse, Idx[UI]);
+    }
+    Ranges.push_back(std::make_pair(Idx[&I], LastUse));
+    Defs.push_back(&I);
+  }
+
+  Live.resize(End);
+  for (unsigned I = 0, E = Defs.size(); I != E; ++I) {
+    RegClass RC = getRegClass(Defs[I]->getType());
+    unsigned NumRegs = getNumRegs(Defs[I]->getType(), RC);
+    bool IsRepl = Replicated.count(Defs[I]);
+    for (unsigned Pos = Ranges[I].first; Pos < Ranges[I].second; ++Pos)
+      Live[Pos].add(RC, NumRegs, IsRepl);
+  }
+}
+
+InnerLoopRegisterUsage::RegClass
+InnerLoopRegisterUsage::getRegClass(Type *Ty) const {
+  if ((Ty->isVectorTy() || Ty->isFloatingPointTy()) &&
+      TTI.getNumberOfRegisters(true) != 0)
+    return VectorRC;
+  return ScalarRC;
+}
+
+unsigned InnerLoopRegisterUsage::getNumRegs(Type *Ty, RegClass RC) const {
+  unsigned Width = TTI.getRegisterBitWidth(RC == VectorRC);
+  if (!Width)
+    return 1;
+  return std::max<uint64_t>(1, divideCeil(DL.getTypeSizeInBits(Ty), Width));
+}
+
+bool InnerLoopRegisterUsage::exceedsRegisters(unsigned Count) const {
+  for (unsigned RC = 0; RC != NumRegClasses; ++RC) {
+    unsigned NumRegs = TTI.getNumberOfRegisters(RC == VectorRC);
+    if (!NumRegs)
+      continue;
+    unsigned Base = LiveIns.Shared[RC] + Count * LiveIns.Replicated[RC];
+    for (const LiveRegs &Regs : Live)
+      if (Base + Regs.Shared[RC] + Count * Regs.Replicated[RC] > NumRegs)
+        return true;
+  }
+  return false;
+}
+
 // Calculates unroll and jam count and writes it to UP.Count. Returns true if
 // unroll count was set explicitly.
 static bool computeUnrollAndJamCount(
@@ -245,6 +405,22 @@ static bool computeUnrollAndJamCount(
       UP.Count = 0;
       return false;
     }
+
+    // The loads shared by the jammed copies don't pay for spilling in the
+    // inner loop, so limit the count to what fits in the registers.
+    if (UnrollAndJamRegisterPressure && UP.Count > 1) {
+      InnerLoopRegisterUsage RU(L, SubLoop, TTI);
+      while (UP.Count > 1 &&
+             (RU.exceedsRegisters(UP.Count) ||
+              (!UP.AllowRemainder && OuterTripMultiple % UP.Count != 0)))
+        UP.Count--;
+      if (UP.Count <= 1) {
+        LLVM_DEBUG(dbgs() << "  Not unroll and jamming due to register "
+                             "pressure.\n");
+        UP.Count = 0;
+        return false;
+      }
+    }
   }
 
   return ExplicitUnroll;
@@ -9,6 +9,7 @@
 
 #include "llvm/Transforms/Scalar/SimpleLoopUnswitch.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/PostOrderIterator.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Sequence.h"
 #include "llvm/ADT/SetVector.h"
@@ -19,11 +20,13 @@
 #include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/CFG.h"
 #include "llvm/Analysis/CodeMetrics.h"
+#include "llvm/Analysis/DivergenceAnalysis.h"
 #include "llvm/Analysis/InstructionSimplify.h"
 #include "llvm/Analysis/LoopAnalysisManager.h"
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/LoopIterator.h"
 #include "llvm/Analysis/LoopPass.h"
+#include "llvm/Analysis/PostDominators.h"
 #include "llvm/Analysis/Utils/Local.h"
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/Constant.h"
@@ -60,6 +63,8 @@ using namespace llvm;
 STATISTIC(NumBranches, "Number of branches unswitched");
 STATISTIC(NumSwitches, "Number of switches unswitched");
 STATISTIC(NumTrivial, "Number of unswitches that are trivial");
+STATISTIC(NumDivergentInvariants,
+          "Number of divergent invariants not unswitched");
 
 static cl::opt<bool> EnableNonTrivialUnswitch(
     "enable-nontrivial-unswitch", cl::init(false), cl::Hidden,
@@ -2171,6 +2176,39 @@ computeDomSubtreeCost(DomTreeNode &N,
   return Cost;
 }
 
+/// Remove the divergent invariants from the unswitch candidates, and the
+/// candidates left without any invariant. A partial unswitch candidate keeps
+/// its uniform invariants, since the `and` or `or` tree can be unswitched on
+/// any subset of its invariant leaves.
+///
+/// Returns false if no candidate is left.
+static bool removeDivergentInvariants(
+    Loop &L, DominatorTree &DT, LoopInfo &LI, TargetTransformInfo &TTI,
+    SmallVectorImpl<std::pair<TerminatorInst *, TinyPtrVector<Value *>>>
+        &UnswitchCandidates) {
+  Function &F = *L.getHeader()->getParent();
+
+  // The IR changes after every unswitch, so this can't be cached across
+  // loops.
+  PostDominatorTree PDT(F);
+  GPUDivergenceAnalysis DA(F, DT, PDT, LI, TTI);
+  for (auto &TerminatorAndInvariants : UnswitchCandidates)
+    llvm::erase_if(TerminatorAndInvariants.second, [&](Value *Invariant) {
+      if (!DA.isDivergent(*Invariant))
+        return false;
+      LLVM_DEBUG(dbgs() << "  Not unswitching divergent invariant: "
+                        << *Invariant << "\n");
+      ++NumDivergentInvariants;
+      return true;
+    });
+  llvm::erase_if(UnswitchCandidates,
+                 [](const std::pair<TerminatorInst *, TinyPtrVector<Value *>>
+                        &TerminatorAndInvariants) {
+                   return TerminatorAndInvariants.second.empty();
+                 });
+  return !UnswitchCandidates.empty();
+}
+
 static bool
 unswitchBestCondition(Loop &L, DominatorTree &DT, LoopInfo &LI,
                       AssumptionCache &AC, TargetTransformInfo &TTI,
@@ -2231,6 +2269,14 @@ unswitchBestCondition(Loop &L, DominatorTree &DT, LoopInfo &LI,
   if (containsIrreducibleCFG<const BasicBlock *>(RPOT, LI))
     return false;
 
+  // On targets with divergent branches, unswitching a divergent condition
+  // doesn't remove any control flow: each thread group ends up running both
+  // copies of the loop with a partial mask. Only unswitch uniform invariants
+  // there.
+  if (TTI.hasBranchDivergence() &&
+      !removeDivergentInvariants(L, DT, LI, TTI, UnswitchCandidates))
+    return false;
+
   LLVM_DEBUG(
       dbgs() << "Considering " << UnswitchCandidates.size()
              << " non-trivial loop invariant conditions for unswitching.\n");
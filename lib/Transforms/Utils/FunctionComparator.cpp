@@ -947,3 +947,82 @@ FunctionComparator::FunctionHash FunctionComparator::functionHash(Function &F) {
   }
   return H.getHash();
 }
+
+// Hash a type the way cmpTypes() compares it: pointers in address space 0 are
+// equivalent to the integer of the same size, and other pointers only differ
+// by address space. Aggregate types are only hashed by kind.
+static uint64_t hashType(Type *Ty, const DataLayout &DL) {
+  if (auto *PTy = dyn_cast<PointerType>(Ty)) {
+    if (PTy->getAddressSpace() == 0)
+      return hash_combine(Type::IntegerTyID, DL.getPointerSizeInBits(0));
+    return hash_combine(Type::PointerTyID, PTy->getAddressSpace());
+  }
+  if (auto *ITy = dyn_cast<IntegerType>(Ty))
+    return hash_combine(Type::IntegerTyID, ITy->getBitWidth());
+  return Ty->getTypeID();
+}
+
+// Hash the properties of an instruction that cmpOperations() and
+// cmpBasicBlocks() compare. GEPs with different indices may compare equal if
+// they add the same offset, so only their address space is hashed.
+static uint64_t hashInstruction(const Instruction &Inst, const DataLayout &DL) {
+  if (auto *GEP = dyn_cast<GetElementPtrInst>(&Inst))
+    return hash_combine(Inst.getOpcode(), GEP->getPointerAddressSpace());
+
+  hash_code H = hash_combine(Inst.getOpcode(), Inst.getNumOperands(),
+                             hashType(Inst.getType(), DL),
+                             Inst.getRawSubclassOptionalData());
+  if (auto *CI = dyn_cast<CmpInst>(&Inst))
+    H = hash_combine(H, CI->getPredicate());
+  else if (auto *LI = dyn_cast<LoadInst>(&Inst))
+    H = hash_combine(H, LI->isVolatile(), LI->getAlignment());
+  else if (auto *SI = dyn_cast<StoreInst>(&Inst))
+    H = hash_combine(H, SI->isVolatile(), SI->getAlignment());
+
+  for (const Value *Op : Inst.operand_values()) {
+    H = hash_combine(H, hashType(Op->getType(), DL));
+    // Non-null constants of the same type only compare equal to constants of
+    // the same kind, but global values may be replaced by bitcasts when
+    // functions are merged. Only hash the value of simple constants. Null
+    // values of types that compare equal, such as i64 and i8*, are equal.
+    auto *C = dyn_cast<Constant>(Op);
+    if (!C || C->isNullValue())
+      continue;
+    if (auto *CI = dyn_cast<ConstantInt>(C))
+      H = hash_combine(H, CI->getValue());
+    else if (auto *CFP = dyn_cast<ConstantFP>(C))
+      H = hash_combine(H, CFP->getValueAPF().bitcastToAPInt());
+  }
+  return H;
+}
+
+FunctionComparator::FunctionHash
+FunctionComparator::functionFingerprint(Function &F) {
+  const DataLayout &DL = F.getParent()->getDataLayout();
+  HashAccumulator64 H;
+  H.add(F.isVarArg());
+  H.add(F.arg_size());
+  H.add(F.getCallingConv());
+  H.add(hashType(F.getReturnType(), DL));
+  for (const Argument &Arg : F.args())
+    H.add(hashType(Arg.getType(), DL));
+
+  // Walk the blocks in the same order as functionHash().
+  SmallVector<const BasicBlock *, 8> BBs;
+  SmallPtrSet<const BasicBlock *, 16> VisitedBBs;
+  BBs.push_back(&F.getEntryBlock());
+  VisitedBBs.insert(BBs[0]);
+  while (!BBs.empty()) {
+    const BasicBlock *BB = BBs.pop_back_val();
+    H.add(45798);
+    for (auto &Inst : *BB)
+      H.add(hashInstruction(Inst, DL));
+    const TerminatorInst *Term = BB->getTerminator();
+    for (unsigned i = 0, e = Term->getNumSuccessors(); i != e; ++i) {
+      if (!VisitedBBs.insert(Term->getSuccessor(i)).second)
+        continue;
+      BBs.push_back(Term->getSuccessor(i));
+    }
+  }
+  return H.getHash();
+}
@@ -1413,8 +1413,14 @@ public:
 
   /// Returns true if \p I is an instruction that will be scalarized with
   /// predication. Such instructions include conditional stores and
-  /// instructions that may divide by zero.
-  bool isScalarWithPredication(Instruction *I);
+  /// instructions that may divide by zero. If \p VF is greater than one, the
+  /// widening decision taken for the conditional stores at \p VF is used.
+  bool isScalarWithPredication(Instruction *I, unsigned VF = 1);
+
+  /// Returns true if \p I is a conditional store to consecutive addresses that
+  /// the target can mask. The cost model widens it into a masked store or
+  /// scalarizes it with predication, whichever is cheaper.
+  bool isMaskableConditionalStore(Instruction *I);
 
   /// Returns true if \p I is a memory instruction with consecutive memory
   /// access that can be widened.
@@ -1491,8 +1497,8 @@ private:
   bool isConsecutiveLoadOrStore(Instruction *I);
 
   /// Returns true if an artificially high cost for emulated masked memrefs
-  /// should be used.
-  bool useEmulatedMaskMemRefHack(Instruction *I);
+  /// should be used. \p VF is as for isScalarWithPredication.
+  bool useEmulatedMaskMemRefHack(Instruction *I, unsigned VF = 1);
 
   /// Create an analysis remark that explains why vectorization failed
   ///
@@ -1513,9 +1519,10 @@ private:
   /// pairs.
   using ScalarCostsTy = DenseMap<Instruction *, unsigned>;
 
-  /// A set containing all BasicBlocks that are known to present after
-  /// vectorization as a predicated block.
-  SmallPtrSet<BasicBlock *, 4> PredicatedBBsAfterVectorization;
+  /// A map holding, for each vectorization factor, the set of BasicBlocks that
+  /// are known to present after vectorization as a predicated block.
+  DenseMap<unsigned, SmallPtrSet<BasicBlock *, 4>>
+      PredicatedBBsAfterVectorization;
 
   /// A map holding scalar costs for different vectorization factors. The
   /// presence of a cost for an instruction in the mapping indicates that the
@@ -4348,7 +4355,8 @@ void LoopVectorizationCostModel::collectLoopScalars(unsigned VF) {
   Scalars[VF].insert(Worklist.begin(), Worklist.end());
 }
 
-bool LoopVectorizationCostModel::isScalarWithPredication(Instruction *I) {
+bool LoopVectorizationCostModel::isScalarWithPredication(Instruction *I,
+                                                         unsigned VF) {
   if (!Legal->blockNeedsPredication(I->getParent()))
     return false;
   switch(I->getOpcode()) {
@@ -4358,6 +4366,9 @@ bool LoopVectorizationCostModel::isScalarWithPredication(Instruction *I) {
   case Instruction::Store: {
     if (!Legal->isMaskRequired(I))
       return false;
+    if (VF > 1 && isa<StoreInst>(I) &&
+        getWideningDecision(I, VF) == CM_Scalarize)
+      return true;
     auto *Ptr = getLoadStorePointerOperand(I);
     auto *Ty = getMemInstValueType(I);
     return isa<LoadInst>(I) ?
@@ -4373,6 +4384,14 @@ bool LoopVectorizationCostModel::isScalarWithPredication(Instruction *I) {
   return false;
 }
 
+bool LoopVectorizationCostModel::isMaskableConditionalStore(Instruction *I) {
+  if (!isa<StoreInst>(I) || !Legal->blockNeedsPredication(I->getParent()) ||
+      !Legal->isMaskRequired(I))
+    return false;
+  return isLegalMaskedStore(getMemInstValueType(I),
+                            getLoadStorePointerOperand(I));
+}
+
 bool LoopVectorizationCostModel::memoryInstructionCanBeWidened(Instruction *I,
                                                                unsigned VF) {
   // Get and ensure we have a valid memory instruction.
@@ -5437,7 +5456,8 @@ LoopVectorizationCostModel::calculateRegisterUsage(ArrayRef<unsigned> VFs) {
   return RUs;
 }
 
-bool LoopVectorizationCostModel::useEmulatedMaskMemRefHack(Instruction *I){
+bool LoopVectorizationCostModel::useEmulatedMaskMemRefHack(Instruction *I,
+                                                            unsigned VF) {
   // TODO: Cost model for emulated masked load/store is completely
   // broken. This hack guides the cost model to use an artificially
   // high enough value to practically disable vectorization with such
@@ -5446,10 +5466,12 @@ bool LoopVectorizationCostModel::useEmulatedMaskMemRefHack(Instruction *I){
   // from moving "masked load/store" check from legality to cost model.
   // Masked Load/Gather emulation was previously never allowed.
   // Limited number of Masked Store/Scatter emulation was allowed.
-  assert(isScalarWithPredication(I) &&
+  // Conditional stores that could be masked are not emulated, their cost is
+  // compared to the cost of the masked store.
+  assert((isScalarWithPredication(I, VF) || isMaskableConditionalStore(I)) &&
          "Expecting a scalar emulated instruction");
   return isa<LoadInst>(I) ||
-         (isa<StoreInst>(I) &&
+         (isa<StoreInst>(I) && !isMaskableConditionalStore(I) &&
           NumPredStores > NumberOfStoresToPredicate);
 }
 
@@ -5473,15 +5495,15 @@ void LoopVectorizationCostModel::collectInstsToScalarize(unsigned VF) {
     if (!Legal->blockNeedsPredication(BB))
       continue;
     for (Instruction &I : *BB)
-      if (isScalarWithPredication(&I)) {
+      if (isScalarWithPredication(&I, VF)) {
         ScalarCostsTy ScalarCosts;
         // Do not apply discount logic if hacked cost is needed
         // for emulated masked memrefs.
-        if (!useEmulatedMaskMemRefHack(&I) &&
+        if (!useEmulatedMaskMemRefHack(&I, VF) &&
             computePredInstDiscount(&I, ScalarCosts, VF) >= 0)
           ScalarCostsVF.insert(ScalarCosts.begin(), ScalarCosts.end());
         // Remember that BB will remain after vectorization.
-        PredicatedBBsAfterVectorization.insert(BB);
+        PredicatedBBsAfterVectorization[VF].insert(BB);
       }
   }
 }
@@ -5514,7 +5536,7 @@ int LoopVectorizationCostModel::computePredInstDiscount(
 
     // If the instruction is scalar with predication, it will be analyzed
     // separately. We ignore it within the context of PredInst.
-    if (isScalarWithPredication(I))
+    if (isScalarWithPredication(I, VF))
       return false;
 
     // If any of the instruction's operands are uniform after vectorization,
@@ -5568,7 +5590,7 @@ int LoopVectorizationCostModel::computePredInstDiscount(
 
     // Compute the scalarization overhead of needed insertelement instructions
     // and phi nodes.
-    if (isScalarWithPredication(I) && !I->getType()->isVoidTy()) {
+    if (isScalarWithPredication(I, VF) && !I->getType()->isVoidTy()) {
       ScalarCost += TTI.getScalarizationOverhead(ToVectorTy(I->getType(), VF),
                                                  true, false);
       ScalarCost += VF * TTI.getCFInstrCost(Instruction::PHI);
@@ -5708,7 +5730,7 @@ unsigned LoopVectorizationCostModel::getMemInstScalarizationCost(Instruction *I,
   // If we have a predicated store, it may not be executed for each vector
   // lane. Scale the cost by the probability of executing the predicated
   // block.
-  if (isScalarWithPredication(I)) {
+  if (isScalarWithPredication(I) || isMaskableConditionalStore(I)) {
     Cost /= getReciprocalPredBlockProb();
 
     if (useEmulatedMaskMemRefHack(I))
@@ -5867,6 +5889,17 @@ void LoopVectorizationCostModel::setCostBasedWideningDecision(unsigned VF) {
                "Expected consecutive stride.");
         InstWidening Decision =
             ConsecutiveStride == 1 ? CM_Widen : CM_Widen_Reverse;
+
+        // A masked store isn't always cheaper than branching around the
+        // scalar stores, e.g. if the target splits it or the mask is rarely
+        // set. Take the cheapest of both.
+        if (isMaskableConditionalStore(&I)) {
+          unsigned ScalarizationCost = getMemInstScalarizationCost(&I, VF);
+          if (ScalarizationCost < Cost) {
+            Decision = CM_Scalarize;
+            Cost = ScalarizationCost;
+          }
+        }
         setWideningDecision(&I, VF, Decision, Cost);
         continue;
       }
@@ -6000,9 +6033,10 @@ unsigned LoopVectorizationCostModel::getInstructionCost(Instruction *I,
     // blocks requires also an extract of its vector compare i1 element.
     bool ScalarPredicatedBB = false;
     BranchInst *BI = cast<BranchInst>(I);
+    const auto &PredBBs = PredicatedBBsAfterVectorization[VF];
     if (VF > 1 && BI->isConditional() &&
-        (PredicatedBBsAfterVectorization.count(BI->getSuccessor(0)) ||
-         PredicatedBBsAfterVectorization.count(BI->getSuccessor(1))))
+        (PredBBs.count(BI->getSuccessor(0)) ||
+         PredBBs.count(BI->getSuccessor(1))))
       ScalarPredicatedBB = true;
 
     if (ScalarPredicatedBB) {
@@ -6795,7 +6829,8 @@ VPBasicBlock *VPRecipeBuilder::handleReplication(
       [&](unsigned VF) { return CM.isUniformAfterVectorization(I, VF); },
       Range);
 
-  bool IsPredicated = CM.isScalarWithPredication(I);
+  bool IsPredicated = LoopVectorizationPlanner::getDecisionAndClampRange(
+      [&](unsigned VF) { return CM.isScalarWithPredication(I, VF); }, Range);
   auto *Recipe = new VPReplicateRecipe(I, IsUniform, IsPredicated);
 
   // Find if I uses a predicated instruction. If so, it will use its scalar
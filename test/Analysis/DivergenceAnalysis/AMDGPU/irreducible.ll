@@ -0,0 +1,63 @@
+; RUN: opt -mtriple amdgcn-unknown-amdhsa -analyze -divergence -use-rv-da %s | FileCheck %s
+
+; The cycle {A, B} has two entries. The divergent branch of %entry enters it
+; through both, so the threads run it out of sync.
+define amdgpu_kernel void @divergent_entry(i32 %n) {
+; CHECK-LABEL: Printing analysis 'Kernel Divergence Analysis' for function 'divergent_entry'
+entry:
+  %tid = call i32 @llvm.amdgcn.workitem.id.x()
+  %cond.div = icmp slt i32 %tid, 0
+  br i1 %cond.div, label %A, label %B
+
+A:
+  %a = phi i32 [ 0, %entry ], [ %b.inc, %B ]
+; CHECK: DIVERGENT: %a = phi i32
+  %a.inc = add i32 %a, 1
+  %a.cond = icmp slt i32 %a.inc, %n
+  br i1 %a.cond, label %B, label %exit
+
+B:
+  %b = phi i32 [ 0, %entry ], [ %a.inc, %A ]
+; CHECK: DIVERGENT: %b = phi i32
+  %b.inc = add i32 %b, 2
+  %b.cond = icmp slt i32 %b.inc, %n
+  br i1 %b.cond, label %A, label %exit
+
+exit:
+  %x = phi i32 [ %a.inc, %A ], [ %b.inc, %B ]
+; CHECK: DIVERGENT: %x = phi i32
+  ret void
+}
+
+; The cycle is entered uniformly and left on a divergent branch. The values of
+; the cycle are uniform in it, but not after it.
+define amdgpu_kernel void @divergent_exit(i32 %n, i1 %c) {
+; CHECK-LABEL: Printing analysis 'Kernel Divergence Analysis' for function 'divergent_exit'
+entry:
+  %tid = call i32 @llvm.amdgcn.workitem.id.x()
+  br i1 %c, label %A, label %B
+
+A:
+  %a = phi i32 [ 0, %entry ], [ %b.inc, %B ]
+; CHECK-NOT: DIVERGENT: %a = phi i32
+  %a.inc = add i32 %a, 1
+  br label %B
+
+B:
+  %b = phi i32 [ %n, %entry ], [ %a.inc, %A ]
+; CHECK-NOT: DIVERGENT: %b = phi i32
+  %b.inc = add i32 %b, 2
+; CHECK-NOT: DIVERGENT: %b.inc = add i32
+  %b.cond = icmp slt i32 %b.inc, %tid
+; CHECK: DIVERGENT: %b.cond = icmp
+  br i1 %b.cond, label %A, label %exit
+
+exit:
+  %use = add i32 %b.inc, 1
+; CHECK: DIVERGENT: %use = add i32
+  ret void
+}
+
+declare i32 @llvm.amdgcn.workitem.id.x() #0
+
+attributes #0 = { nounwind readnone }
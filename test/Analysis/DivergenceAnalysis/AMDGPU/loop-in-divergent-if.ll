@@ -0,0 +1,27 @@
+; RUN: opt -mtriple amdgcn-unknown-amdhsa -analyze -divergence -use-rv-da %s | FileCheck %s
+
+; The loop is only entered through one target of the divergent branch, and
+; its exit condition is uniform, so the threads that run it stay in sync.
+define amdgpu_kernel void @loop_in_divergent_if(i32 %n) #0 {
+; CHECK-LABEL: Printing analysis 'Kernel Divergence Analysis' for function 'loop_in_divergent_if'
+entry:
+  %tid = call i32 @llvm.amdgcn.workitem.id.x()
+  %cond.var = icmp eq i32 %tid, 0
+  br i1 %cond.var, label %loop, label %end
+; CHECK: DIVERGENT: br i1 %cond.var,
+loop:
+  %i = phi i32 [ %i.inc, %loop ], [ 0, %entry ]
+  %i.inc = add i32 %i, 1
+  %cond.uni = icmp ne i32 %i.inc, %n
+  br i1 %cond.uni, label %loop, label %end
+; CHECK-NOT: DIVERGENT: %i = phi i32
+; CHECK-NOT: DIVERGENT: br i1 %cond.uni,
+end:
+  %phi.var = phi i32 [ %i.inc, %loop ], [ 0, %entry ]
+; CHECK: DIVERGENT: %phi.var = phi i32
+  ret void
+}
+
+declare i32 @llvm.amdgcn.workitem.id.x() #0
+
+attributes #0 = { nounwind readnone }
@@ -0,0 +1,30 @@
+; RUN: opt -mtriple amdgcn-unknown-amdhsa -analyze -divergence -divergence-compare %s | FileCheck %s
+; RUN: opt -mtriple amdgcn-unknown-amdhsa -analyze -divergence -divergence-compare -use-rv-da=false %s | FileCheck %s
+
+; The DivergencePropagator only looks for sync dependence at the immediate
+; post-dominator of a divergent branch, and misses the join at %C.
+
+define amdgpu_kernel void @hidden_diverge(i32 %n, i32 %a, i32 %b) #0 {
+; CHECK-LABEL: Printing analysis 'Kernel Divergence Analysis' for function 'hidden_diverge'
+; CHECK-NOT: PROPAGATOR-ONLY:
+; CHECK: GPUDA-ONLY: %phi.var.hidden = phi i32
+; CHECK-NOT: PROPAGATOR-ONLY:
+; CHECK-NOT: GPUDA-ONLY:
+entry:
+  %tid = call i32 @llvm.amdgcn.workitem.id.x()
+  %cond.var = icmp slt i32 %tid, 0
+  br i1 %cond.var, label %B, label %C
+B:
+  %cond.uni = icmp slt i32 %n, 0
+  br i1 %cond.uni, label %C, label %merge
+C:
+  %phi.var.hidden = phi i32 [ 1, %entry ], [ 2, %B  ]
+  br label %merge
+merge:
+  %phi.ipd = phi i32 [ %a, %B ], [ %b, %C ]
+  ret void
+}
+
+declare i32 @llvm.amdgcn.workitem.id.x() #0
+
+attributes #0 = { nounwind readnone }
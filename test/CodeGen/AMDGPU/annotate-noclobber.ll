@@ -0,0 +1,32 @@
+; RUN: opt -S -mtriple=amdgcn-- -amdgpu-annotate-uniform < %s | FileCheck %s
+
+; %in is never written by the kernel, so both of its loads are not clobbered,
+; including the one after the store to %out.
+; CHECK-LABEL: @readonly_object(
+; CHECK: getelementptr i32, i32 addrspace(1)* %in, i64 0, !amdgpu.uniform !0, !amdgpu.noclobber !0
+; CHECK: %gep = getelementptr i32, i32 addrspace(1)* %in, i64 1, !amdgpu.uniform !0, !amdgpu.noclobber !0
+define amdgpu_kernel void @readonly_object(i32 addrspace(1)* noalias %in, i32 addrspace(1)* noalias %out) {
+  %a = load i32, i32 addrspace(1)* %in
+  store i32 %a, i32 addrspace(1)* %out
+  %gep = getelementptr i32, i32 addrspace(1)* %in, i64 1
+  %b = load i32, i32 addrspace(1)* %gep
+  %gep.out = getelementptr i32, i32 addrspace(1)* %out, i64 1
+  store i32 %b, i32 addrspace(1)* %gep.out
+  ret void
+}
+
+; %p is written, but only the load of the element that is stored to is
+; clobbered.
+; CHECK-LABEL: @written_object(
+; CHECK: %gep.1 = getelementptr i32, i32 addrspace(1)* %p, i64 1, !amdgpu.uniform !0, !amdgpu.noclobber !0
+; CHECK: %gep.2 = getelementptr i32, i32 addrspace(1)* %p, i64 2, !amdgpu.uniform !0{{$}}
+define amdgpu_kernel void @written_object(i32 addrspace(1)* %p) {
+  %gep.1 = getelementptr i32, i32 addrspace(1)* %p, i64 1
+  %gep.2 = getelementptr i32, i32 addrspace(1)* %p, i64 2
+  store i32 0, i32 addrspace(1)* %gep.2
+  %a = load i32, i32 addrspace(1)* %gep.1
+  %b = load i32, i32 addrspace(1)* %gep.2
+  %sum = add i32 %a, %b
+  store i32 %sum, i32 addrspace(1)* %p
+  ret void
+}
@@ -0,0 +1,66 @@
+; RUN: opt -S -mtriple=amdgcn-- -amdgpu-insert-readfirstlane < %s | FileCheck %s
+
+@lds = internal addrspace(3) global i32 undef, align 4
+
+; The uniform LDS load is moved to an SGPR for the integer arithmetic using it.
+; CHECK-LABEL: @uniform_lds_load(
+; CHECK: %v = load i32, i32 addrspace(3)* @lds, align 4
+; CHECK-NEXT: %v.readfirstlane = call i32 @llvm.amdgcn.readfirstlane(i32 %v)
+; CHECK-NEXT: %a = add i32 %v.readfirstlane, 1
+define amdgpu_kernel void @uniform_lds_load(i32 addrspace(1)* %out) {
+  %v = load i32, i32 addrspace(3)* @lds, align 4
+  %a = add i32 %v, 1
+  %b = mul i32 %a, 3
+  store i32 %b, i32 addrspace(1)* %out
+  ret void
+}
+
+; A single SALU instruction doesn't pay for the readfirstlane.
+; CHECK-LABEL: @single_user(
+; CHECK-NOT: readfirstlane
+; CHECK: ret void
+define amdgpu_kernel void @single_user(i32 addrspace(1)* %out) {
+  %v = load i32, i32 addrspace(3)* @lds, align 4
+  %a = add i32 %v, 1
+  store i32 %a, i32 addrspace(1)* %out
+  ret void
+}
+
+; Loads from the constant address space are already scalar.
+; CHECK-LABEL: @scalar_load(
+; CHECK-NOT: readfirstlane
+; CHECK: ret void
+define amdgpu_kernel void @scalar_load(i32 addrspace(4)* %in, i32 addrspace(1)* %out) {
+  %v = load i32, i32 addrspace(4)* %in, align 4
+  %a = add i32 %v, 1
+  %b = mul i32 %a, 3
+  store i32 %b, i32 addrspace(1)* %out
+  ret void
+}
+
+; The use of the value after the loop keeps the VGPR, as threads may leave the
+; loop in different iterations.
+; CHECK-LABEL: @loop(
+; CHECK: %v.readfirstlane = call i32 @llvm.amdgcn.readfirstlane(i32 %v)
+; CHECK-NEXT: %a = add i32 %v.readfirstlane, %i
+; CHECK: exit:
+; CHECK-NEXT: %r = add i32 %v, 1
+define amdgpu_kernel void @loop(i32 addrspace(1)* %out, i32 %n) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  %v = load i32, i32 addrspace(3)* @lds, align 4
+  %a = add i32 %v, %i
+  %b = shl i32 %a, 2
+  store i32 %b, i32 addrspace(3)* @lds, align 4
+  %i.next = add i32 %i, 1
+  %c = icmp ult i32 %i.next, %n
+  br i1 %c, label %loop, label %exit
+
+exit:
+  %r = add i32 %v, 1
+  store i32 %r, i32 addrspace(1)* %out
+  ret void
+}
@@ -0,0 +1,32 @@
+; RUN: lli -jit-kind=orc-lazy -compile-threads=1 %s | FileCheck %s
+; RUN: lli -jit-kind=orc-lazy -compile-threads=2 %s | FileCheck %s
+;
+; Check that lazily compiled functions that call one another can be
+; materialized on a pool of compile threads.
+;
+; CHECK: Hello
+; CHECK-NEXT: Goodbye
+
+@str = private unnamed_addr constant [6 x i8] c"Hello\00"
+@str2 = private unnamed_addr constant [8 x i8] c"Goodbye\00"
+
+define void @hello() {
+entry:
+  %0 = tail call i32 @puts(i8* getelementptr inbounds ([6 x i8], [6 x i8]* @str, i64 0, i64 0))
+  ret void
+}
+
+define void @goodbye() {
+entry:
+  %0 = tail call i32 @puts(i8* getelementptr inbounds ([8 x i8], [8 x i8]* @str2, i64 0, i64 0))
+  ret void
+}
+
+define i32 @main(i32 %argc, i8** nocapture readnone %argv) {
+entry:
+  tail call void @hello()
+  tail call void @goodbye()
+  ret i32 0
+}
+
+declare i32 @puts(i8* nocapture readonly)
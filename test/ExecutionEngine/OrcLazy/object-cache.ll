@@ -0,0 +1,31 @@
+; RUN: rm -rf %t.cache
+; RUN: lli -jit-kind=orc-lazy -enable-cache-manager -object-cache-dir=%t.cache \
+; RUN:   %s | FileCheck %s
+; RUN: ls %t.cache | FileCheck --check-prefix=ENTRIES %s
+; RUN: ls %t.cache > %t.first
+; RUN: lli -jit-kind=orc-lazy -enable-cache-manager -object-cache-dir=%t.cache \
+; RUN:   %s | FileCheck %s
+; RUN: ls %t.cache > %t.second
+; RUN: diff %t.first %t.second
+;
+; Check that compiled objects are written to the cache directory, and that a
+; second run loads them rather than adding new entries.
+;
+; CHECK: Hello
+; ENTRIES: llvmcache-
+
+@str = private unnamed_addr constant [6 x i8] c"Hello\00"
+
+define void @hello() {
+entry:
+  %0 = tail call i32 @puts(i8* getelementptr inbounds ([6 x i8], [6 x i8]* @str, i64 0, i64 0))
+  ret void
+}
+
+define i32 @main(i32 %argc, i8** nocapture readnone %argv) {
+entry:
+  tail call void @hello()
+  ret i32 0
+}
+
+declare i32 @puts(i8* nocapture readonly)
@@ -0,0 +1,38 @@
+; REQUIRES: asserts
+; RUN: lli -jit-kind=orc-lazy -tier-up-threshold=2 -stats %s 2>&1 >/dev/null \
+; RUN:   | FileCheck %s
+; RUN: lli -jit-kind=orc-lazy -stats %s 2>&1 >/dev/null \
+; RUN:   | FileCheck %s --check-prefix=UNTIERED
+;
+; Check that the baseline tier is compiled without optimization, i.e. with
+; FastISel on x86, and that untiered code still goes through SelectionDAG.
+;
+; CHECK: isel - Number of instructions fast isel selected
+;
+; UNTIERED: Statistics Collected
+; UNTIERED-NOT: fast isel selected
+
+@str = private unnamed_addr constant [6 x i8] c"Hello\00"
+
+define void @hello() {
+entry:
+  %0 = tail call i32 @puts(i8* getelementptr inbounds ([6 x i8], [6 x i8]* @str, i64 0, i64 0))
+  ret void
+}
+
+define i32 @main(i32 %argc, i8** nocapture readnone %argv) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  tail call void @hello()
+  %i.next = add i32 %i, 1
+  %done = icmp eq i32 %i.next, 4
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret i32 0
+}
+
+declare i32 @puts(i8* nocapture readonly)
@@ -0,0 +1,45 @@
+; RUN: %lli -force-interpreter=true %s
+
+; Intrinsics without an interpreter implementation are lowered to IR the first
+; time they are executed. @llvm.bswap is first executed by the innermost call
+; to @f, while the other calls are suspended in %rec. The suspended frames, and
+; the loop whose phis use the lowered values, must keep executing the current
+; IR.
+
+declare i32 @llvm.ctpop.i32(i32)
+declare i32 @llvm.bswap.i32(i32)
+
+define i32 @f(i32 %n) {
+entry:
+  %z = icmp eq i32 %n, 0
+  br i1 %z, label %exit, label %rec
+
+rec:
+  %p = call i32 @llvm.ctpop.i32(i32 %n)
+  %m = sub i32 %n, 1
+  %r = call i32 @f(i32 %m)
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %rec ], [ %i.next, %loop ]
+  %acc = phi i32 [ %r, %rec ], [ %acc.next, %loop ]
+  %b = call i32 @llvm.bswap.i32(i32 %i)
+  %s = lshr i32 %b, 24
+  %acc1 = add i32 %acc, %s
+  %acc.next = add i32 %acc1, %p
+  %i.next = add i32 %i, 1
+  %c = icmp ult i32 %i.next, 4
+  br i1 %c, label %loop, label %exit
+
+exit:
+  %res = phi i32 [ 0, %entry ], [ %acc.next, %loop ]
+  ret i32 %res
+}
+
+define i32 @main() {
+  ; 4 * (ctpop(1) + ... + ctpop(5)) + 5 * (0 + 1 + 2 + 3)
+  %v = call i32 @f(i32 5)
+  %ok = icmp eq i32 %v, 58
+  %ret = select i1 %ok, i32 0, i32 1
+  ret i32 %ret
+}
@@ -0,0 +1,131 @@
+; RUN: opt -gvn-memoryssa < %s -gvn -gvn-memoryssa -S | FileCheck %s
+; RUN: opt -gvn-memoryssa < %s -aa-pipeline=basic-aa -passes=gvn -gvn-memoryssa -S | FileCheck %s
+
+; Load elimination and load PRE with the dependencies found by MemorySSA.
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+declare void @clobber()
+
+; CHECK-LABEL: @store_forward(
+; CHECK-NOT: load
+; CHECK: ret i32 42
+define i32 @store_forward(i32* noalias %p, i32* noalias %q) {
+  store i32 42, i32* %p
+  store i32 0, i32* %q
+  %v = load i32, i32* %p
+  ret i32 %v
+}
+
+; CHECK-LABEL: @load_load(
+; CHECK: %a = load i32, i32* %p
+; CHECK-NOT: load
+; CHECK: add i32 %a, %a
+define i32 @load_load(i32* noalias %p, i32* noalias %q) {
+  %a = load i32, i32* %p
+  store i32 0, i32* %q
+  %b = load i32, i32* %p
+  %r = add i32 %a, %b
+  ret i32 %r
+}
+
+; CHECK-LABEL: @clobbered(
+; CHECK: call void @clobber()
+; CHECK-NEXT: %b = load i32, i32* %p
+define i32 @clobbered(i32* %p) {
+  %a = load i32, i32* %p
+  call void @clobber()
+  %b = load i32, i32* %p
+  %r = add i32 %a, %b
+  ret i32 %r
+}
+
+; CHECK-LABEL: @fully_redundant(
+; CHECK: join:
+; CHECK-NEXT: %v = phi i32 [ 2, %else ], [ 1, %then ]
+; CHECK-NEXT: ret i32 %v
+define i32 @fully_redundant(i1 %c, i32* %p) {
+entry:
+  br i1 %c, label %then, label %else
+
+then:
+  store i32 1, i32* %p
+  br label %join
+
+else:
+  store i32 2, i32* %p
+  br label %join
+
+join:
+  %v = load i32, i32* %p
+  ret i32 %v
+}
+
+; The load is available in %then and is inserted in %else, after the call
+; that clobbers it.
+; CHECK-LABEL: @partially_redundant(
+; CHECK: else:
+; CHECK-NEXT: call void @clobber()
+; CHECK-NEXT: %v.pre = load i32, i32* %p
+; CHECK: join:
+; CHECK-NEXT: [[V:%.*]] = phi i32 [ %a, %then ], [ %v.pre, %else ]
+; CHECK: %s = add i32 [[V]], [[V]]
+define i32 @partially_redundant(i1 %c, i32* %p) {
+entry:
+  br i1 %c, label %then, label %else
+
+then:
+  %a = load i32, i32* %p
+  br label %join
+
+else:
+  call void @clobber()
+  br label %join
+
+join:
+  %x = phi i32 [ %a, %then ], [ 0, %else ]
+  %v = load i32, i32* %p
+  %w = load i32, i32* %p
+  %s = add i32 %v, %w
+  %r = add i32 %s, %x
+  ret i32 %r
+}
+
+; Predecessors that are unreachable from the entry are skipped, as MemorySSA
+; has no accesses for them (PR2503 with -gvn-memoryssa).
+@g = external global i8
+
+; CHECK-LABEL: @unreachable_pred(
+; CHECK: afterfor:
+; CHECK-NOT: load
+; CHECK: ret i8 %v1
+define i8 @unreachable_pred(i32 %x, i32 %y) {
+entry:
+  %a = alloca i8
+  %cmp = icmp eq i32 %x, %y
+  br i1 %cmp, label %ifelse, label %ifthen
+
+ifthen:
+  br label %ifend
+
+ifelse:
+  %v1 = load i8, i8* @g
+  store i8 %v1, i8* %a
+  br label %afterfor
+
+forcond:
+  br i1 false, label %afterfor, label %forbody
+
+forbody:
+  br label %forinc
+
+forinc:
+  br label %forcond
+
+afterfor:
+  %v2 = load i8, i8* @g
+  ret i8 %v2
+
+ifend:
+  ret i8 0
+}
@@ -0,0 +1,78 @@
+; RUN: opt < %s -inline -inline-threshold=20 -stats -S 2>&1 | FileCheck %s
+; RUN: opt < %s -passes=inline -inline-threshold=20 -stats -S 2>&1 | FileCheck %s
+; RUN: opt < %s -inline -inline-threshold=20 -inline-cost-callee-summaries=false -S | FileCheck %s --check-prefix=CHECK-IR
+; REQUIRES: asserts
+
+; The body of @callee is only analyzed once for the call sites that don't pass
+; any constant. The call site passing a constant is analyzed on its own, and
+; the constant makes the large block of @callee dead.
+
+; CHECK-LABEL: define i32 @caller1(
+; CHECK: call i32 @callee(
+; CHECK-LABEL: define i32 @caller2(
+; CHECK: call i32 @callee(
+; CHECK-LABEL: define i32 @caller3(
+; CHECK: call i32 @callee(
+; CHECK-LABEL: define i32 @caller4(
+; CHECK-NOT: call
+; CHECK: ret i32 1
+
+; CHECK: 1 inline-cost - Number of callee summaries computed
+; CHECK: 2 inline-cost - Number of call sites analyzed with a cached callee summary
+; CHECK: 1 inline-cost - Number of call sites whose arguments prevent using a summary
+
+; The decisions are the same without summaries.
+; CHECK-IR-LABEL: define i32 @caller1(
+; CHECK-IR: call i32 @callee(
+; CHECK-IR-LABEL: define i32 @caller4(
+; CHECK-IR-NOT: call
+; CHECK-IR: ret i32 1
+
+define i32 @callee(i32 %x, i32* %p) {
+entry:
+  %c = icmp eq i32 %x, 0
+  br i1 %c, label %small, label %big
+
+small:
+  ret i32 1
+
+big:
+  %a = load i32, i32* %p
+  %v0 = mul i32 %a, %x
+  %v1 = add i32 %v0, %x
+  %v2 = mul i32 %v1, %x
+  %v3 = add i32 %v2, %x
+  %v4 = mul i32 %v3, %x
+  %v5 = add i32 %v4, %x
+  %v6 = mul i32 %v5, %x
+  %v7 = add i32 %v6, %x
+  %v8 = mul i32 %v7, %x
+  %v9 = add i32 %v8, %x
+  %v10 = mul i32 %v9, %x
+  %v11 = add i32 %v10, %x
+  %v12 = mul i32 %v11, %x
+  %v13 = add i32 %v12, %x
+  %v14 = mul i32 %v13, %x
+  %v15 = add i32 %v14, %x
+  ret i32 %v15
+}
+
+define i32 @caller1(i32 %x, i32* %p) {
+  %r = call i32 @callee(i32 %x, i32* %p)
+  ret i32 %r
+}
+
+define i32 @caller2(i32 %x, i32* %p) {
+  %r = call i32 @callee(i32 %x, i32* %p)
+  ret i32 %r
+}
+
+define i32 @caller3(i32 %y, i32* %q) {
+  %r = call i32 @callee(i32 %y, i32* %q)
+  ret i32 %r
+}
+
+define i32 @caller4(i32* %p) {
+  %r = call i32 @callee(i32 0, i32* %p)
+  ret i32 %r
+}
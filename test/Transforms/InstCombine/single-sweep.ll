@@ -0,0 +1,33 @@
+; RUN: opt < %s -instcombine -instcombine-single-sweep -S | FileCheck %s
+; RUN: opt < %s -instcombine -instcombine-single-sweep -instcombine-verify-fixpoint -stats -disable-output 2>&1 | FileCheck %s --check-prefix=SINGLE
+; RUN: opt < %s -instcombine -stats -disable-output 2>&1 | FileCheck %s --check-prefix=DEFAULT
+; REQUIRES: asserts
+
+; Each fold re-queues the users of the combined instruction, so the whole
+; chain is folded without another iteration over the function.
+
+define i32 @chain(i32 %x) {
+; CHECK-LABEL: @chain(
+; CHECK-NEXT:    [[C:%.*]] = add i32 [[X:%.*]], 6
+; CHECK-NEXT:    ret i32 [[C]]
+;
+  %a = add i32 %x, 1
+  %b = add i32 %a, 2
+  %c = add i32 %b, 3
+  ret i32 %c
+}
+
+define i32 @dead_operands(i32 %x) {
+; CHECK-LABEL: @dead_operands(
+; CHECK-NEXT:    ret i32 [[X:%.*]]
+;
+  %a = mul i32 %x, 3
+  %b = and i32 %a, 0
+  %c = or i32 %b, %x
+  ret i32 %c
+}
+
+; SINGLE: 2 instcombine - Number of functions with one iteration
+; SINGLE-NOT: Number of functions with two iterations
+
+; DEFAULT: 2 instcombine - Number of functions with two iterations
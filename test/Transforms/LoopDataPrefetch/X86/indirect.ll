@@ -0,0 +1,101 @@
+; RUN: opt -mtriple=x86_64-unknown-linux-gnu -loop-data-prefetch -S < %s | FileCheck %s
+; RUN: opt -mtriple=x86_64-unknown-linux-gnu -passes=loop-data-prefetch -S < %s | FileCheck %s
+; RUN: opt -mtriple=x86_64-unknown-linux-gnu -loop-data-prefetch -loop-prefetch-indirect=false -S < %s | FileCheck %s --check-prefix=NOINDIRECT
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+; The load of a[idx[i]] is prefetched through idx[min(i + d, n - 1)]. The
+; strided load of idx[i] is left to the hardware prefetcher.
+
+; CHECK-LABEL: @gather(
+; NOINDIRECT-LABEL: @gather(
+; NOINDIRECT-NOT: call void @llvm.prefetch
+define i32 @gather(i32* nocapture readonly %a, i32* nocapture readonly %idx, i64 %n) {
+entry:
+  br label %for.body
+
+; CHECK: for.body:
+for.body:
+  %iv = phi i64 [ 0, %entry ], [ %iv.next, %for.body ]
+  %sum = phi i32 [ 0, %entry ], [ %add, %for.body ]
+  %arrayidx = getelementptr inbounds i32, i32* %idx, i64 %iv
+; CHECK-NOT: call void @llvm.prefetch
+; CHECK: select
+; CHECK-NOT: call void @llvm.prefetch
+; CHECK: load i32, i32* %arrayidx,
+  %0 = load i32, i32* %arrayidx, align 4
+  %idxprom = sext i32 %0 to i64
+  %arrayidx2 = getelementptr inbounds i32, i32* %a, i64 %idxprom
+; CHECK: %prefidx = load i32, i32* %{{.*}}, align 4
+; CHECK: sext i32 %prefidx to i64
+; CHECK: call void @llvm.prefetch(i8* %{{.*}}, i32 0, i32 3, i32 1)
+; CHECK-NEXT: load i32, i32* %arrayidx2
+  %1 = load i32, i32* %arrayidx2, align 4
+  %add = add nsw i32 %1, %sum
+  %iv.next = add nuw i64 %iv, 1
+  %exitcond = icmp eq i64 %iv.next, %n
+  br i1 %exitcond, label %for.end, label %for.body
+
+for.end:
+  ret i32 %add
+}
+
+; idx[i + d] may be past the end of idx if the loop can exit early.
+
+; CHECK-LABEL: @gather_early_exit(
+; CHECK-NOT: call void @llvm.prefetch
+; CHECK: ret i32
+define i32 @gather_early_exit(i32* nocapture readonly %a, i32* nocapture readonly %idx, i64 %n) {
+entry:
+  br label %for.body
+
+for.body:
+  %iv = phi i64 [ 0, %entry ], [ %iv.next, %for.inc ]
+  %sum = phi i32 [ 0, %entry ], [ %add, %for.inc ]
+  %arrayidx = getelementptr inbounds i32, i32* %idx, i64 %iv
+  %0 = load i32, i32* %arrayidx, align 4
+  %cmp = icmp slt i32 %0, 0
+  br i1 %cmp, label %for.end, label %for.inc
+
+for.inc:
+  %idxprom = sext i32 %0 to i64
+  %arrayidx2 = getelementptr inbounds i32, i32* %a, i64 %idxprom
+  %1 = load i32, i32* %arrayidx2, align 4
+  %add = add nsw i32 %1, %sum
+  %iv.next = add nuw i64 %iv, 1
+  %exitcond = icmp eq i64 %iv.next, %n
+  br i1 %exitcond, label %for.end, label %for.body
+
+for.end:
+  %res = phi i32 [ %sum, %for.body ], [ %add, %for.inc ]
+  ret i32 %res
+}
+
+; Nor if the loop contains a call that may not return.
+
+; CHECK-LABEL: @gather_call(
+; CHECK-NOT: call void @llvm.prefetch
+; CHECK: ret i32
+define i32 @gather_call(i32* nocapture readonly %a, i32* nocapture readonly %idx, i64 %n) {
+entry:
+  br label %for.body
+
+for.body:
+  %iv = phi i64 [ 0, %entry ], [ %iv.next, %for.body ]
+  %sum = phi i32 [ 0, %entry ], [ %add, %for.body ]
+  %arrayidx = getelementptr inbounds i32, i32* %idx, i64 %iv
+  %0 = load i32, i32* %arrayidx, align 4
+  %idxprom = sext i32 %0 to i64
+  %arrayidx2 = getelementptr inbounds i32, i32* %a, i64 %idxprom
+  %1 = load i32, i32* %arrayidx2, align 4
+  call void @may_exit(i32 %1)
+  %add = add nsw i32 %1, %sum
+  %iv.next = add nuw i64 %iv, 1
+  %exitcond = icmp eq i64 %iv.next, %n
+  br i1 %exitcond, label %for.end, label %for.body
+
+for.end:
+  ret i32 %add
+}
+
+declare void @may_exit(i32)
@@ -0,0 +1,179 @@
+; RUN: opt < %s -loop-tile -loop-tile-cache-size=32768 -S | FileCheck %s
+; RUN: opt < %s -loop-tile -loop-tile-cache-size=32768 -disable-output \
+; RUN:   -pass-remarks=loop-tile -pass-remarks-missed=loop-tile \
+; RUN:   -pass-remarks-analysis=loop-tile 2>&1 | FileCheck %s --check-prefix=REMARK
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+@A = common global [65536 x float] zeroinitializer
+@B = common global [64 x [65536 x float]] zeroinitializer
+@C = common global [64 x [64 x float]] zeroinitializer
+
+; for (i = 0; i < 64; ++i)
+;   for (j = 0; j < 65536; ++j)
+;     B[i][j] = A[j];
+;
+; A doesn't fit in the cache, but is reused by each iteration of i. The tiles
+; of 2048 iterations of j touch 16 KB.
+
+; REMARK: remark: <unknown>:0:0: cache cost with the outer loop innermost: 4259840, with the inner loop innermost: 524288, inner loop footprint: 524288 bytes
+; REMARK-NEXT: remark: <unknown>:0:0: tiled loop with tile size 2048
+; REMARK-NEXT: remark: <unknown>:0:0: cache cost with the outer loop innermost: 1040, with the inner loop innermost: 128, inner loop footprint: 128 bytes
+; REMARK-NEXT: remark: <unknown>:0:0: loop not tiled: the loop nest is not perfect or its dependences prevent tiling
+; REMARK-NEXT: remark: <unknown>:0:0: tiled loop with tile size 16
+; REMARK-NOT: remark
+
+; CHECK-LABEL: @tile_reuse(
+; CHECK: tile.header:
+; CHECK-NEXT: %tile.iv = phi i64 [ 0, %entry ], [ %tile.iv.next, %tile.latch ]
+; CHECK-NEXT: %tile.remaining = sub i64 65535, %tile.iv
+; CHECK-NEXT: %tile.last = icmp ult i64 %tile.remaining, 2048
+; CHECK-NEXT: [[OFFSET:%.*]] = select i1 %tile.last, i64 %tile.remaining, i64 2047
+; CHECK-NEXT: %tile.start = add i64 0, %tile.iv
+; CHECK-NEXT: [[LAST:%.*]] = add i64 %tile.start, [[OFFSET]]
+; CHECK-NEXT: %tile.end = add i64 [[LAST]], 1
+; CHECK-NEXT: br label %outer.header.ph
+; CHECK: outer.header:
+; CHECK-NEXT: %i = phi i64 [ 0, %outer.header.ph ], [ %i.next, %outer.latch ]
+; CHECK: inner.header:
+; CHECK-NEXT: %j = phi i64 [ %tile.start, %outer.header ], [ %j.next, %inner.header ]
+; CHECK: %tile.exitcond = icmp eq i64 %j.next, %tile.end
+; CHECK-NEXT: br i1 %tile.exitcond, label %outer.latch, label %inner.header
+; CHECK: outer.latch:
+; CHECK: br i1 %outer.cond, label %tile.latch, label %outer.header
+; CHECK: tile.latch:
+; CHECK-NEXT: %tile.iv.next = add i64 %tile.iv, 2048
+; CHECK-NEXT: br i1 %tile.last, label %exit, label %tile.header
+define void @tile_reuse() {
+entry:
+  br label %outer.header
+
+outer.header:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %outer.latch ]
+  br label %inner.header
+
+inner.header:
+  %j = phi i64 [ 0, %outer.header ], [ %j.next, %inner.header ]
+  %a.addr = getelementptr inbounds [65536 x float], [65536 x float]* @A, i64 0, i64 %j
+  %a = load float, float* %a.addr
+  %b.addr = getelementptr inbounds [64 x [65536 x float]], [64 x [65536 x float]]* @B, i64 0, i64 %i, i64 %j
+  store float %a, float* %b.addr
+  %j.next = add nuw nsw i64 %j, 1
+  %inner.cond = icmp eq i64 %j.next, 65536
+  br i1 %inner.cond, label %outer.latch, label %inner.header
+
+outer.latch:
+  %i.next = add nuw nsw i64 %i, 1
+  %outer.cond = icmp eq i64 %i.next, 64
+  br i1 %outer.cond, label %exit, label %outer.header
+
+exit:
+  ret void
+}
+
+; The 16 iterations of j fit in the cache.
+
+; CHECK-LABEL: @small_inner(
+; CHECK-NOT: tile.header
+; CHECK: ret void
+define void @small_inner() {
+entry:
+  br label %outer.header
+
+outer.header:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %outer.latch ]
+  br label %inner.header
+
+inner.header:
+  %j = phi i64 [ 0, %outer.header ], [ %j.next, %inner.header ]
+  %a.addr = getelementptr inbounds [65536 x float], [65536 x float]* @A, i64 0, i64 %j
+  %a = load float, float* %a.addr
+  %b.addr = getelementptr inbounds [64 x [65536 x float]], [64 x [65536 x float]]* @B, i64 0, i64 %i, i64 %j
+  store float %a, float* %b.addr
+  %j.next = add nuw nsw i64 %j, 1
+  %inner.cond = icmp eq i64 %j.next, 16
+  br i1 %inner.cond, label %outer.latch, label %inner.header
+
+outer.latch:
+  %i.next = add nuw nsw i64 %i, 1
+  %outer.cond = icmp eq i64 %i.next, 64
+  br i1 %outer.cond, label %exit, label %outer.header
+
+exit:
+  ret void
+}
+
+; C[i + 1][j] = C[i][j + 1] reads, in iteration (i + 1, j - 1), the value
+; stored in iteration (i, j), which tiling would run later.
+
+; CHECK-LABEL: @illegal(
+; CHECK-NOT: tile.header
+; CHECK: ret void
+define void @illegal() {
+entry:
+  br label %outer.header
+
+outer.header:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %outer.latch ]
+  %i.next = add nuw nsw i64 %i, 1
+  br label %inner.header
+
+inner.header:
+  %j = phi i64 [ 0, %outer.header ], [ %j.next, %inner.header ]
+  %j.next = add nuw nsw i64 %j, 1
+  %ld.addr = getelementptr inbounds [64 x [64 x float]], [64 x [64 x float]]* @C, i64 0, i64 %i, i64 %j.next
+  %v = load float, float* %ld.addr
+  %st.addr = getelementptr inbounds [64 x [64 x float]], [64 x [64 x float]]* @C, i64 0, i64 %i.next, i64 %j
+  store float %v, float* %st.addr
+  %inner.cond = icmp eq i64 %j.next, 63
+  br i1 %inner.cond, label %outer.latch, label %inner.header, !llvm.loop !0
+
+outer.latch:
+  %outer.cond = icmp eq i64 %i.next, 63
+  br i1 %outer.cond, label %exit, label %outer.header
+
+exit:
+  ret void
+}
+
+; Tiling is forced by metadata, with the tile size it gives.
+
+; CHECK-LABEL: @forced(
+; CHECK: entry:
+; CHECK-NEXT: [[BTC:%.*]] = add i64 %m, -1
+; CHECK: tile.header:
+; CHECK: %tile.remaining = sub i64 [[BTC]], %tile.iv
+; CHECK-NEXT: %tile.last = icmp ult i64 %tile.remaining, 16
+; CHECK: tile.latch:
+; CHECK-NEXT: %tile.iv.next = add i64 %tile.iv, 16
+define void @forced(i64 %m) {
+entry:
+  br label %outer.header
+
+outer.header:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %outer.latch ]
+  br label %inner.header
+
+inner.header:
+  %j = phi i64 [ 0, %outer.header ], [ %j.next, %inner.header ]
+  %b.addr = getelementptr inbounds [64 x [65536 x float]], [64 x [65536 x float]]* @B, i64 0, i64 %i, i64 %j
+  %b = load float, float* %b.addr
+  %a.addr = getelementptr inbounds [65536 x float], [65536 x float]* @A, i64 0, i64 %j
+  store float %b, float* %a.addr
+  %j.next = add nuw nsw i64 %j, 1
+  %inner.cond = icmp eq i64 %j.next, %m
+  br i1 %inner.cond, label %outer.latch, label %inner.header, !llvm.loop !2
+
+outer.latch:
+  %i.next = add nuw nsw i64 %i, 1
+  %outer.cond = icmp eq i64 %i.next, 64
+  br i1 %outer.cond, label %exit, label %outer.header
+
+exit:
+  ret void
+}
+
+!0 = distinct !{!0, !1}
+!1 = !{!"llvm.loop.tile.enable", i1 true}
+!2 = distinct !{!2, !3}
+!3 = !{!"llvm.loop.tile.size", i32 16}
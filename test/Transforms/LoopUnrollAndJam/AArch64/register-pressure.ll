@@ -0,0 +1,163 @@
+; RUN: opt -mcpu=thunderx2t99 -loop-unroll-and-jam -allow-unroll-and-jam -pass-remarks=loop-unroll-and-jam < %s -S 2>&1 | FileCheck %s
+; RUN: opt -mcpu=thunderx2t99 -loop-unroll-and-jam -allow-unroll-and-jam -unroll-and-jam-register-pressure=false -pass-remarks=loop-unroll-and-jam < %s -S 2>&1 | FileCheck %s --check-prefix=NOPRESSURE
+
+target datalayout = "e-m:e-i8:8:32-i16:16:32-i64:64-i128:128-n32:64-S128"
+target triple = "aarch64-unknown-linux-gnu"
+
+; The load of B[j] and the inner induction are shared by the jammed copies,
+; the four accumulators are replicated. Eight copies would need more than the
+; 31 general purpose registers, six copies fit.
+; CHECK: remark: {{.*}} unroll and jammed loop by a factor of 6 with run-time trip count
+; NOPRESSURE: remark: {{.*}} unroll and jammed loop by a factor of 8 with run-time trip count
+define void @pressure(i32 %I, i32 %J, i32* noalias nocapture %A, i32* noalias nocapture readonly %B) {
+entry:
+  %cmp = icmp ne i32 %J, 0
+  %cmp122 = icmp ne i32 %I, 0
+  %or.cond = and i1 %cmp, %cmp122
+  br i1 %or.cond, label %for.outer.preheader, label %for.end
+
+for.outer.preheader:
+  br label %for.outer
+
+for.outer:
+  %i = phi i32 [ %addinc, %for.latch ], [ 0, %for.outer.preheader ]
+  br label %for.inner
+
+for.inner:
+  %j = phi i32 [ 0, %for.outer ], [ %inc, %for.inner ]
+  %acc0 = phi i32 [ %i, %for.outer ], [ %add0, %for.inner ]
+  %acc1 = phi i32 [ %i, %for.outer ], [ %add1, %for.inner ]
+  %acc2 = phi i32 [ %i, %for.outer ], [ %add2, %for.inner ]
+  %acc3 = phi i32 [ %i, %for.outer ], [ %add3, %for.inner ]
+  %arrayidx = getelementptr inbounds i32, i32* %B, i32 %j
+  %0 = load i32, i32* %arrayidx, align 4
+  %add0 = add i32 %0, %acc0
+  %add1 = xor i32 %0, %acc1
+  %add2 = sub i32 %0, %acc2
+  %add3 = mul i32 %0, %acc3
+  %inc = add nuw i32 %j, 1
+  %exitcond = icmp eq i32 %inc, %J
+  br i1 %exitcond, label %for.latch, label %for.inner
+
+for.latch:
+  %add0.lcssa = phi i32 [ %add0, %for.inner ]
+  %add1.lcssa = phi i32 [ %add1, %for.inner ]
+  %add2.lcssa = phi i32 [ %add2, %for.inner ]
+  %add3.lcssa = phi i32 [ %add3, %for.inner ]
+  %s01 = add i32 %add0.lcssa, %add1.lcssa
+  %s23 = add i32 %add2.lcssa, %add3.lcssa
+  %s = add i32 %s01, %s23
+  %arrayidx6 = getelementptr inbounds i32, i32* %A, i32 %i
+  store i32 %s, i32* %arrayidx6, align 4
+  %addinc = add nuw i32 %i, 1
+  %exitcond25 = icmp eq i32 %addinc, %I
+  br i1 %exitcond25, label %for.end.loopexit, label %for.outer
+
+for.end.loopexit:
+  br label %for.end
+
+for.end:
+  ret void
+}
+
+; Vector values use the 32 Q registers. Each <8 x i32> accumulator takes two,
+; so five copies of three of them and the shared load fit.
+; CHECK: remark: {{.*}} unroll and jammed loop by a factor of 5 with run-time trip count
+; NOPRESSURE: remark: {{.*}} unroll and jammed loop by a factor of 8 with run-time trip count
+define void @pressure_vector(i32 %I, i32 %J, <8 x i32>* noalias nocapture %A, <8 x i32>* noalias nocapture readonly %B) {
+entry:
+  %cmp = icmp ne i32 %J, 0
+  %cmp122 = icmp ne i32 %I, 0
+  %or.cond = and i1 %cmp, %cmp122
+  br i1 %or.cond, label %for.outer.preheader, label %for.end
+
+for.outer.preheader:
+  br label %for.outer
+
+for.outer:
+  %i = phi i32 [ %addinc, %for.latch ], [ 0, %for.outer.preheader ]
+  %ins = insertelement <8 x i32> undef, i32 %i, i32 0
+  %iv = shufflevector <8 x i32> %ins, <8 x i32> undef, <8 x i32> zeroinitializer
+  br label %for.inner
+
+for.inner:
+  %j = phi i32 [ 0, %for.outer ], [ %inc, %for.inner ]
+  %acc0 = phi <8 x i32> [ %iv, %for.outer ], [ %add0, %for.inner ]
+  %acc1 = phi <8 x i32> [ %iv, %for.outer ], [ %add1, %for.inner ]
+  %acc2 = phi <8 x i32> [ %iv, %for.outer ], [ %add2, %for.inner ]
+  %arrayidx = getelementptr inbounds <8 x i32>, <8 x i32>* %B, i32 %j
+  %0 = load <8 x i32>, <8 x i32>* %arrayidx, align 4
+  %add0 = add <8 x i32> %0, %acc0
+  %add1 = xor <8 x i32> %0, %acc1
+  %add2 = sub <8 x i32> %0, %acc2
+  %inc = add nuw i32 %j, 1
+  %exitcond = icmp eq i32 %inc, %J
+  br i1 %exitcond, label %for.latch, label %for.inner
+
+for.latch:
+  %add0.lcssa = phi <8 x i32> [ %add0, %for.inner ]
+  %add1.lcssa = phi <8 x i32> [ %add1, %for.inner ]
+  %add2.lcssa = phi <8 x i32> [ %add2, %for.inner ]
+  %s01 = add <8 x i32> %add0.lcssa, %add1.lcssa
+  %s = add <8 x i32> %s01, %add2.lcssa
+  %arrayidx6 = getelementptr inbounds <8 x i32>, <8 x i32>* %A, i32 %i
+  store <8 x i32> %s, <8 x i32>* %arrayidx6, align 4
+  %addinc = add nuw i32 %i, 1
+  %exitcond25 = icmp eq i32 %addinc, %I
+  br i1 %exitcond25, label %for.end.loopexit, label %for.outer
+
+for.end.loopexit:
+  br label %for.end
+
+for.end:
+  ret void
+}
+
+; Each <32 x i32> accumulator takes eight Q registers, even two copies of two
+; of them don't fit.
+; CHECK-NOT: remark: {{.*}} unroll and jammed
+; NOPRESSURE: remark: {{.*}} unroll and jammed loop by a factor of 8 with run-time trip count
+define void @pressure_prevents(i32 %I, i32 %J, <32 x i32>* noalias nocapture %A, <32 x i32>* noalias nocapture readonly %B) {
+entry:
+  %cmp = icmp ne i32 %J, 0
+  %cmp122 = icmp ne i32 %I, 0
+  %or.cond = and i1 %cmp, %cmp122
+  br i1 %or.cond, label %for.outer.preheader, label %for.end
+
+for.outer.preheader:
+  br label %for.outer
+
+for.outer:
+  %i = phi i32 [ %addinc, %for.latch ], [ 0, %for.outer.preheader ]
+  %ins = insertelement <32 x i32> undef, i32 %i, i32 0
+  %iv = shufflevector <32 x i32> %ins, <32 x i32> undef, <32 x i32> zeroinitializer
+  br label %for.inner
+
+for.inner:
+  %j = phi i32 [ 0, %for.outer ], [ %inc, %for.inner ]
+  %acc0 = phi <32 x i32> [ %iv, %for.outer ], [ %add0, %for.inner ]
+  %acc1 = phi <32 x i32> [ %iv, %for.outer ], [ %add1, %for.inner ]
+  %arrayidx = getelementptr inbounds <32 x i32>, <32 x i32>* %B, i32 %j
+  %0 = load <32 x i32>, <32 x i32>* %arrayidx, align 4
+  %add0 = add <32 x i32> %0, %acc0
+  %add1 = xor <32 x i32> %0, %acc1
+  %inc = add nuw i32 %j, 1
+  %exitcond = icmp eq i32 %inc, %J
+  br i1 %exitcond, label %for.latch, label %for.inner
+
+for.latch:
+  %add0.lcssa = phi <32 x i32> [ %add0, %for.inner ]
+  %add1.lcssa = phi <32 x i32> [ %add1, %for.inner ]
+  %s = add <32 x i32> %add0.lcssa, %add1.lcssa
+  %arrayidx6 = getelementptr inbounds <32 x i32>, <32 x i32>* %A, i32 %i
+  store <32 x i32> %s, <32 x i32>* %arrayidx6, align 4
+  %addinc = add nuw i32 %i, 1
+  %exitcond25 = icmp eq i32 %addinc, %I
+  br i1 %exitcond25, label %for.end.loopexit, label %for.outer
+
+for.end.loopexit:
+  br label %for.end
+
+for.end:
+  ret void
+}
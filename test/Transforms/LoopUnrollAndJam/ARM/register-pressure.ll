@@ -0,0 +1,123 @@
+; RUN: opt -loop-unroll-and-jam -allow-unroll-and-jam -pass-remarks=loop-unroll-and-jam < %s -S 2>&1 | FileCheck %s
+; RUN: opt -loop-unroll-and-jam -allow-unroll-and-jam -unroll-and-jam-register-pressure=false -pass-remarks=loop-unroll-and-jam < %s -S 2>&1 | FileCheck %s --check-prefix=NOPRESSURE
+
+target datalayout = "e-m:e-p:32:32-i64:64-v128:64:128-a:0:32-n32-S64"
+target triple = "thumbv8m.main-arm-none-eabi"
+
+; The load of B[j] and the inner induction are shared by the jammed copies,
+; the four accumulators are replicated. Four copies would need 20 of the 13
+; registers, two copies need 12.
+; CHECK: remark: {{.*}} unroll and jammed loop by a factor of 2 with run-time trip count
+; NOPRESSURE: remark: {{.*}} unroll and jammed loop by a factor of 4 with run-time trip count
+define void @pressure(i32 %I, i32 %J, i32* noalias nocapture %A, i32* noalias nocapture readonly %B) {
+entry:
+  %cmp = icmp ne i32 %J, 0
+  %cmp122 = icmp ne i32 %I, 0
+  %or.cond = and i1 %cmp, %cmp122
+  br i1 %or.cond, label %for.outer.preheader, label %for.end
+
+for.outer.preheader:
+  br label %for.outer
+
+for.outer:
+  %i = phi i32 [ %addinc, %for.latch ], [ 0, %for.outer.preheader ]
+  br label %for.inner
+
+for.inner:
+  %j = phi i32 [ 0, %for.outer ], [ %inc, %for.inner ]
+  %acc0 = phi i32 [ %i, %for.outer ], [ %add0, %for.inner ]
+  %acc1 = phi i32 [ %i, %for.outer ], [ %add1, %for.inner ]
+  %acc2 = phi i32 [ %i, %for.outer ], [ %add2, %for.inner ]
+  %acc3 = phi i32 [ %i, %for.outer ], [ %add3, %for.inner ]
+  %arrayidx = getelementptr inbounds i32, i32* %B, i32 %j
+  %0 = load i32, i32* %arrayidx, align 4
+  %add0 = add i32 %0, %acc0
+  %add1 = xor i32 %0, %acc1
+  %add2 = sub i32 %acc2, %0
+  %add3 = mul i32 %0, %acc3
+  %inc = add nuw i32 %j, 1
+  %exitcond = icmp eq i32 %inc, %J
+  br i1 %exitcond, label %for.latch, label %for.inner
+
+for.latch:
+  %add0.lcssa = phi i32 [ %add0, %for.inner ]
+  %add1.lcssa = phi i32 [ %add1, %for.inner ]
+  %add2.lcssa = phi i32 [ %add2, %for.inner ]
+  %add3.lcssa = phi i32 [ %add3, %for.inner ]
+  %s01 = add i32 %add0.lcssa, %add1.lcssa
+  %s23 = add i32 %add2.lcssa, %add3.lcssa
+  %s = add i32 %s01, %s23
+  %arrayidx6 = getelementptr inbounds i32, i32* %A, i32 %i
+  store i32 %s, i32* %arrayidx6, align 4
+  %addinc = add nuw i32 %i, 1
+  %exitcond25 = icmp eq i32 %addinc, %I
+  br i1 %exitcond25, label %for.end.loopexit, label %for.outer
+
+for.end.loopexit:
+  br label %for.end
+
+for.end:
+  ret void
+}
+
+; With six accumulators, even two copies need more registers than there are.
+; CHECK-NOT: remark: {{.*}} unroll and jammed
+; NOPRESSURE: remark: {{.*}} unroll and jammed loop by a factor of 4 with run-time trip count
+define void @pressure_prevents(i32 %I, i32 %J, i32* noalias nocapture %A, i32* noalias nocapture readonly %B) {
+entry:
+  %cmp = icmp ne i32 %J, 0
+  %cmp122 = icmp ne i32 %I, 0
+  %or.cond = and i1 %cmp, %cmp122
+  br i1 %or.cond, label %for.outer.preheader, label %for.end
+
+for.outer.preheader:
+  br label %for.outer
+
+for.outer:
+  %i = phi i32 [ %addinc, %for.latch ], [ 0, %for.outer.preheader ]
+  br label %for.inner
+
+for.inner:
+  %j = phi i32 [ 0, %for.outer ], [ %inc, %for.inner ]
+  %acc0 = phi i32 [ %i, %for.outer ], [ %add0, %for.inner ]
+  %acc1 = phi i32 [ %i, %for.outer ], [ %add1, %for.inner ]
+  %acc2 = phi i32 [ %i, %for.outer ], [ %add2, %for.inner ]
+  %acc3 = phi i32 [ %i, %for.outer ], [ %add3, %for.inner ]
+  %acc4 = phi i32 [ %i, %for.outer ], [ %add4, %for.inner ]
+  %acc5 = phi i32 [ %i, %for.outer ], [ %add5, %for.inner ]
+  %arrayidx = getelementptr inbounds i32, i32* %B, i32 %j
+  %0 = load i32, i32* %arrayidx, align 4
+  %add0 = add i32 %0, %acc0
+  %add1 = xor i32 %0, %acc1
+  %add2 = sub i32 %acc2, %0
+  %add3 = mul i32 %0, %acc3
+  %add4 = and i32 %0, %acc4
+  %add5 = or i32 %0, %acc5
+  %inc = add nuw i32 %j, 1
+  %exitcond = icmp eq i32 %inc, %J
+  br i1 %exitcond, label %for.latch, label %for.inner
+
+for.latch:
+  %add0.lcssa = phi i32 [ %add0, %for.inner ]
+  %add1.lcssa = phi i32 [ %add1, %for.inner ]
+  %add2.lcssa = phi i32 [ %add2, %for.inner ]
+  %add3.lcssa = phi i32 [ %add3, %for.inner ]
+  %add4.lcssa = phi i32 [ %add4, %for.inner ]
+  %add5.lcssa = phi i32 [ %add5, %for.inner ]
+  %s01 = add i32 %add0.lcssa, %add1.lcssa
+  %s23 = add i32 %add2.lcssa, %add3.lcssa
+  %s45 = add i32 %add4.lcssa, %add5.lcssa
+  %s03 = add i32 %s01, %s23
+  %s = add i32 %s03, %s45
+  %arrayidx6 = getelementptr inbounds i32, i32* %A, i32 %i
+  store i32 %s, i32* %arrayidx6, align 4
+  %addinc = add nuw i32 %i, 1
+  %exitcond25 = icmp eq i32 %addinc, %I
+  br i1 %exitcond25, label %for.end.loopexit, label %for.outer
+
+for.end.loopexit:
+  br label %for.end
+
+for.end:
+  ret void
+}
@@ -0,0 +1,56 @@
+; RUN: opt < %s -mattr=avx2 -force-vector-width=2 -force-vector-interleave=1 -loop-vectorize -S | FileCheck %s --check-prefix=AVX2-VF2
+; RUN: opt < %s -mattr=avx2 -force-vector-width=4 -force-vector-interleave=1 -loop-vectorize -S | FileCheck %s --check-prefix=AVX2-VF4
+; RUN: opt < %s -mattr=avx512f -force-vector-width=2 -force-vector-interleave=1 -loop-vectorize -S | FileCheck %s --check-prefix=AVX512-VF2
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+; The conditional store can be masked on both targets. The cost model picks
+; the cheaper of the masked store and the scalar stores under a branch:
+; with AVX2, a <2 x i32> masked store is promoted and costs more than two
+; predicated scalar stores, a <4 x i32> one doesn't. AVX-512 masked stores
+; are cheap.
+
+; AVX2-VF2-LABEL: @cond_store(
+; AVX2-VF2:       vector.body:
+; AVX2-VF2-NOT:     @llvm.masked.store
+; AVX2-VF2:       pred.store.if:
+; AVX2-VF2:         store i32
+; AVX2-VF2:       pred.store.if{{[0-9]+}}:
+; AVX2-VF2:         store i32
+
+; AVX2-VF4-LABEL: @cond_store(
+; AVX2-VF4:       vector.body:
+; AVX2-VF4:         call void @llvm.masked.store.v4i32.p0v4i32(
+; AVX2-VF4-NOT:   pred.store.if:
+
+; AVX512-VF2-LABEL: @cond_store(
+; AVX512-VF2:     vector.body:
+; AVX512-VF2:       call void @llvm.masked.store.v2i32.p0v2i32(
+; AVX512-VF2-NOT: pred.store.if:
+
+define void @cond_store(i32* noalias nocapture %A, i32* noalias nocapture readonly %B, i64 %n) {
+entry:
+  br label %for.body
+
+for.body:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %for.inc ]
+  %b.addr = getelementptr inbounds i32, i32* %B, i64 %i
+  %b = load i32, i32* %b.addr, align 4
+  %cmp = icmp sgt i32 %b, 0
+  br i1 %cmp, label %if.then, label %for.inc
+
+if.then:
+  %a.addr = getelementptr inbounds i32, i32* %A, i64 %i
+  %add = add nsw i32 %b, 1
+  store i32 %add, i32* %a.addr, align 4
+  br label %for.inc
+
+for.inc:
+  %i.next = add nuw nsw i64 %i, 1
+  %exitcond = icmp eq i64 %i.next, %n
+  br i1 %exitcond, label %for.end, label %for.body
+
+for.end:
+  ret void
+}
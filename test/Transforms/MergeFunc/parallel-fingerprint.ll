@@ -0,0 +1,73 @@
+; RUN: opt -mergefunc -S < %s | FileCheck %s
+; RUN: opt -mergefunc -mergefunc-parallel-threshold=1 -S < %s | FileCheck %s
+
+; The functions are fingerprinted and compared on several threads when the
+; module has at least -mergefunc-parallel-threshold functions. The result must
+; be the same as with a single thread.
+
+declare void @ext1(i32)
+declare void @ext2(i32)
+
+; The merged functions are replaced by thunks at the end of the module. @d1
+; and @d2 are merged before @c1 and @c2, which call them.
+; CHECK-LABEL: define i32 @a1(i32 %x)
+; CHECK-LABEL: define i32 @b(i32 %x)
+; CHECK-NEXT: add i32 %x, 8
+; CHECK-LABEL: define void @c1(i32 %x)
+; CHECK-NEXT: call void @d1(i32 %x)
+; CHECK-LABEL: define void @d1(i32 %x)
+; CHECK-LABEL: define void @d2(i32)
+; CHECK-NEXT: tail call void @d1(i32 %0)
+; CHECK-NEXT: ret void
+; CHECK-LABEL: define i32 @a2(i32)
+; CHECK-NEXT: tail call i32 @a1(i32 %0)
+; CHECK-NEXT: ret i32
+; CHECK-LABEL: define void @c2(i32)
+; CHECK-NEXT: tail call void @c1(i32 %0)
+; CHECK-NEXT: ret void
+
+; @a1 and @a2 are equal.
+define i32 @a1(i32 %x) {
+  %y = add i32 %x, 7
+  %z = mul i32 %y, 3
+  ret i32 %z
+}
+
+define i32 @a2(i32 %x) {
+  %y = add i32 %x, 7
+  %z = mul i32 %y, 3
+  ret i32 %z
+}
+
+; @b only differs from @a1 in a constant, and is not merged.
+define i32 @b(i32 %x) {
+  %y = add i32 %x, 8
+  %z = mul i32 %y, 3
+  ret i32 %z
+}
+
+; @c1 and @c2 call different functions, which are merged first. Afterwards,
+; @c1 and @c2 are equal.
+define void @c1(i32 %x) {
+  call void @d1(i32 %x)
+  call void @ext1(i32 %x)
+  ret void
+}
+
+define void @c2(i32 %x) {
+  call void @d2(i32 %x)
+  call void @ext1(i32 %x)
+  ret void
+}
+
+define void @d1(i32 %x) {
+  call void @ext1(i32 %x)
+  call void @ext2(i32 %x)
+  ret void
+}
+
+define void @d2(i32 %x) {
+  call void @ext1(i32 %x)
+  call void @ext2(i32 %x)
+  ret void
+}
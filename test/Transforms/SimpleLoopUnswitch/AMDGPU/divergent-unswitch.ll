@@ -0,0 +1,110 @@
+; RUN: opt -mtriple=amdgcn-- -passes='loop(unswitch),verify<loops>' -enable-nontrivial-unswitch -S < %s | FileCheck %s
+; RUN: opt -mtriple=amdgcn-- -simple-loop-unswitch -enable-nontrivial-unswitch -S < %s | FileCheck %s
+
+declare i32 @a()
+declare i32 @b()
+
+declare i32 @llvm.amdgcn.workitem.id.x() #0
+
+; Kernel arguments are uniform, so the loop is unswitched.
+define amdgpu_kernel void @uniform_unswitch(i1 addrspace(1)* %ptr, i1 %cond) {
+; CHECK-LABEL: @uniform_unswitch(
+entry:
+  br label %loop_begin
+; CHECK-NEXT:  entry:
+; CHECK-NEXT:    br i1 %cond, label %entry.split.us, label %entry.split
+
+loop_begin:
+  br i1 %cond, label %loop_a, label %loop_b
+
+loop_a:
+  call i32 @a()
+  br label %latch
+
+loop_b:
+  call i32 @b()
+  br label %latch
+
+latch:
+  %v = load i1, i1 addrspace(1)* %ptr
+  br i1 %v, label %loop_begin, label %loop_exit
+
+loop_exit:
+  ret void
+}
+
+; A condition depending on the workitem id is divergent, and unswitching it
+; would only make every wave run both copies of the loop.
+define amdgpu_kernel void @divergent_unswitch(i1 addrspace(1)* %ptr) {
+; CHECK-LABEL: @divergent_unswitch(
+entry:
+  %tid = call i32 @llvm.amdgcn.workitem.id.x()
+  %cond = icmp eq i32 %tid, 0
+  br label %loop_begin
+; CHECK-NEXT:  entry:
+; CHECK-NEXT:    %tid = call i32 @llvm.amdgcn.workitem.id.x()
+; CHECK-NEXT:    %cond = icmp eq i32 %tid, 0
+; CHECK-NEXT:    br label %loop_begin
+;
+; CHECK-NOT:     br i1 %cond, label %entry.split
+
+loop_begin:
+  br i1 %cond, label %loop_a, label %loop_b
+; CHECK:       loop_begin:
+; CHECK-NEXT:    br i1 %cond, label %loop_a, label %loop_b
+
+loop_a:
+  call i32 @a()
+  br label %latch
+
+loop_b:
+  call i32 @b()
+  br label %latch
+
+latch:
+  %v = load i1, i1 addrspace(1)* %ptr
+  br i1 %v, label %loop_begin, label %loop_exit
+
+loop_exit:
+  ret void
+}
+
+; Only the uniform input of the `and` chain is unswitched.
+define amdgpu_kernel void @partial_unswitch(i1 addrspace(1)* %ptr, i1 %cond.uni) {
+; CHECK-LABEL: @partial_unswitch(
+entry:
+  %tid = call i32 @llvm.amdgcn.workitem.id.x()
+  %cond.div = icmp eq i32 %tid, 0
+  br label %loop_begin
+; CHECK-NEXT:  entry:
+; CHECK-NEXT:    %tid = call i32 @llvm.amdgcn.workitem.id.x()
+; CHECK-NEXT:    %cond.div = icmp eq i32 %tid, 0
+; CHECK-NEXT:    br i1 %cond.uni, label %entry.split, label %entry.split.us
+
+loop_begin:
+  %v1 = load i1, i1 addrspace(1)* %ptr
+  %cond.and1 = and i1 %v1, %cond.div
+  %cond.and2 = and i1 %cond.and1, %cond.uni
+  br i1 %cond.and2, label %loop_a, label %loop_b
+; CHECK:       loop_begin.us:
+; CHECK-NEXT:    %[[V1_US:.*]] = load i1, i1 addrspace(1)* %ptr
+; CHECK-NEXT:    %[[AND1_US:.*]] = and i1 %[[V1_US]], %cond.div
+; CHECK-NEXT:    %[[AND2_US:.*]] = and i1 %[[AND1_US]], false
+
+loop_a:
+  call i32 @a()
+  br label %latch
+
+loop_b:
+  call i32 @b()
+  br label %latch
+
+latch:
+  %v2 = load i1, i1 addrspace(1)* %ptr
+  br i1 %v2, label %loop_begin, label %loop_exit
+
+loop_exit:
+  ret void
+}
+
+attributes #0 = { nounwind readnone }
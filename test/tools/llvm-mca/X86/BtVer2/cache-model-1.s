@@ -0,0 +1,29 @@
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=10 -resource-pressure=false -instruction-info=false -cache-model -l2-size=0 -l3-size=0 < %s | FileCheck %s
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=10 -resource-pressure=false -instruction-info=false -cache-model -memory-view=false < %s | FileCheck --check-prefix=NOVIEW %s
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=10 -resource-pressure=false -instruction-info=false < %s | FileCheck --check-prefix=NOVIEW %s
+
+# The first load walks a new cache line on every iteration, and always misses.
+# The second load always reads the same line, and only misses once. Stores and
+# instructions that don't access memory are not stalled.
+
+# LLVM-MCA-ADDRESS 0x1000 64
+  movl (%rdi), %eax
+  addl %eax, %ecx
+# LLVM-MCA-ADDRESS 0x8000
+  movl (%rsi), %edx
+# LLVM-MCA-ADDRESS 0x10000 4
+  movl %ecx, (%rdx)
+
+# CHECK:      Memory Access View:
+# CHECK-NEXT: [0]: Accesses
+# CHECK-NEXT: [1]: L1 hits
+# CHECK-NEXT: [2]: Memory accesses
+# CHECK-NEXT: [3]: Average stall cycles per load
+
+# CHECK:            [0]    [1]    [2]    [3]
+# CHECK-NEXT: 0.     10     0      10     196.0     movl	(%rdi), %eax
+# CHECK-NEXT: 1.     -      -      -      -         addl	%eax, %ecx
+# CHECK-NEXT: 2.     10     9      1      19.6      movl	(%rsi), %edx
+# CHECK-NEXT: 3.     10     9      1      -         movl	%ecx, (%rdx)
+
+# NOVIEW-NOT: Memory Access View
@@ -0,0 +1,25 @@
+# RUN: echo "0 0x1000" > %t.trace
+# RUN: echo "# Comment" >> %t.trace
+# RUN: echo "0 0x1000" >> %t.trace
+# RUN: echo "0 0x2000" >> %t.trace
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=6 -resource-pressure=false -instruction-info=false -cache-model -l2-size=0 -l3-size=0 -memory-trace=%t.trace < %s 2>&1 | FileCheck %s
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=1 -resource-pressure=false -instruction-info=false -cache-model -l2-size=0 -l3-size=0 -l1d-latency=4 -memory-latency=8 -timeline < %s | FileCheck --check-prefix=TIMELINE %s
+# RUN: echo "x 0x1000" > %t.bad
+# RUN: not llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -cache-model -memory-trace=%t.bad < %s 2>&1 | FileCheck --check-prefix=BADTRACE %s
+
+# Addresses from the memory trace take precedence over the annotations, and
+# are used in turn on successive iterations.
+
+# LLVM-MCA-ADDRESS 0x4000 64
+  vmovaps (%rsi), %xmm0
+# LLVM-MCA-ADDRESS foo
+  vaddps %xmm0, %xmm1, %xmm1
+
+# CHECK:      {{.*}}:[[@LINE-3]]:2: warning: Ignoring invalid address annotation
+
+# CHECK:            [0]    [1]    [2]    [3]
+# CHECK-NEXT: 0.     6      4      2      65.3      vmovaps	(%rsi), %xmm0
+
+# TIMELINE:   [0,0]     DeeeeemmmmER
+
+# BADTRACE: error: {{.*}}.bad:1: invalid memory trace entry 'x 0x1000'
@@ -0,0 +1,27 @@
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=1 -resource-pressure=false -instruction-info=false -j=1 < %s > %t.serial
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=1 -resource-pressure=false -instruction-info=false -j=3 < %s > %t.parallel
+# RUN: diff %t.serial %t.parallel
+# RUN: FileCheck %s < %t.parallel
+
+# Check that regions simulated in parallel are reported in program order, and
+# that the report matches the one produced by a serial run.
+
+# LLVM-MCA-BEGIN foo
+  add %edi, %esi
+# LLVM-MCA-END
+
+# LLVM-MCA-BEGIN bar
+  add %esi, %eax
+  imul %eax, %ecx
+# LLVM-MCA-END
+
+# LLVM-MCA-BEGIN baz
+  divl %ecx
+# LLVM-MCA-END
+
+# CHECK:      [0] Code Region - foo
+# CHECK:      Instructions:      1
+# CHECK:      [1] Code Region - bar
+# CHECK:      Instructions:      2
+# CHECK:      [2] Code Region - baz
+# CHECK:      Instructions:      1
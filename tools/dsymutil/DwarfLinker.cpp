@@ -2386,13 +2386,15 @@ bool DwarfLinker::link(const DebugMap &Map) {
 
     startDebugObject(LinkContext);
 
-    // In a first phase, just read in the debug info and load all clang modules.
-    LinkContext.CompileUnits.reserve(
+    // In a first phase, just read in the unit DIEs and load all clang modules.
+    // The rest of the debug info is parsed later, shortly before the object is
+    // cloned, so that only a few objects are fully in memory at once.
+    LinkContext.UnitsToLoad.reserve(
         LinkContext.DwarfContext->getNumCompileUnits());
 
     for (const auto &CU : LinkContext.DwarfContext->compile_units()) {
       updateDwarfVersion(CU->getVersion());
-      auto CUDie = CU->getUnitDIE(false);
+      auto CUDie = CU->getUnitDIE();
       if (Options.Verbose) {
         outs() << "Input compilation unit:";
         DIDumpOptions DumpOpts;
@@ -2405,8 +2407,7 @@ bool DwarfLinker::link(const DebugMap &Map) {
           !registerModuleReference(CUDie, *CU, ModuleMap, LinkContext.DMO,
                                    LinkContext.Ranges, OffsetsStringPool,
                                    UniquingStringPool, ODRContexts, UnitID)) {
-        LinkContext.CompileUnits.push_back(llvm::make_unique<CompileUnit>(
-            *CU, UnitID++, !Options.NoODR && !Options.Update, ""));
+        LinkContext.UnitsToLoad.emplace_back(CU.get(), UnitID++);
       }
     }
   }
@@ -2415,24 +2416,42 @@ bool DwarfLinker::link(const DebugMap &Map) {
   if (MaxDwarfVersion == 0)
     MaxDwarfVersion = 3;
 
-  // These variables manage the list of processed object files.
+  // These variables manage the list of loaded and processed object files.
   // The mutex and condition variable are to ensure that this is thread safe.
   std::mutex ProcessedFilesMutex;
   std::condition_variable ProcessedFilesConditionVariable;
+  BitVector LoadedFiles(NumObjects, false);
   BitVector ProcessedFiles(NumObjects, false);
 
-  // Now do analyzeContextInfo in parallel as it is particularly expensive.
-  auto AnalyzeLambda = [&]() {
-    for (unsigned i = 0, e = NumObjects; i != e; ++i) {
-      auto &LinkContext = ObjectContexts[i];
+  // Parse all the DIEs of an object. This only touches the object's own
+  // DWARFContext, so it can run on worker threads.
+  auto LoadObject = [&](unsigned i) {
+    auto &LinkContext = ObjectContexts[i];
+    if (LinkContext.ObjectFile) {
+      LinkContext.CompileUnits.reserve(LinkContext.UnitsToLoad.size());
+      for (const auto &UnitAndID : LinkContext.UnitsToLoad)
+        LinkContext.CompileUnits.push_back(llvm::make_unique<CompileUnit>(
+            *UnitAndID.first, UnitAndID.second,
+            !Options.NoODR && !Options.Update, ""));
+    }
 
-      if (!LinkContext.ObjectFile) {
-        std::unique_lock<std::mutex> LockGuard(ProcessedFilesMutex);
-        ProcessedFiles.set(i);
-        ProcessedFilesConditionVariable.notify_one();
-        continue;
-      }
+    std::unique_lock<std::mutex> LockGuard(ProcessedFilesMutex);
+    LoadedFiles.set(i);
+    ProcessedFilesConditionVariable.notify_all();
+  };
+
+  auto WaitFor = [&](const BitVector &Files, unsigned i) {
+    std::unique_lock<std::mutex> LockGuard(ProcessedFilesMutex);
+    if (!Files[i])
+      ProcessedFilesConditionVariable.wait(LockGuard,
+                                           [&]() { return Files[i]; });
+  };
 
+  // Now do analyzeContextInfo, which is particularly expensive. It updates
+  // the ODR contexts, so the objects have to be analyzed in order.
+  auto AnalyzeObject = [&](unsigned i) {
+    auto &LinkContext = ObjectContexts[i];
+    if (LinkContext.ObjectFile) {
       // Now build the DIE parent links that we will use during the next phase.
       for (auto &CurrentUnit : LinkContext.CompileUnits) {
         auto CUDie = CurrentUnit->getOrigUnit().getUnitDIE();
@@ -2442,86 +2461,78 @@ bool DwarfLinker::link(const DebugMap &Map) {
                            *CurrentUnit, &ODRContexts.getRoot(),
                            UniquingStringPool, ODRContexts);
       }
-
-      std::unique_lock<std::mutex> LockGuard(ProcessedFilesMutex);
-      ProcessedFiles.set(i);
-      ProcessedFilesConditionVariable.notify_one();
     }
+
+    std::unique_lock<std::mutex> LockGuard(ProcessedFilesMutex);
+    ProcessedFiles.set(i);
+    ProcessedFilesConditionVariable.notify_all();
   };
 
   // And then the remaining work in serial again.
-  // Note, although this loop runs in serial, it can run in parallel with
-  // the analyzeContextInfo loop so long as we process files with indices >=
-  // than those processed by analyzeContextInfo.
-  auto CloneLambda = [&]() {
-    for (unsigned i = 0, e = NumObjects; i != e; ++i) {
-      {
-        std::unique_lock<std::mutex> LockGuard(ProcessedFilesMutex);
-        if (!ProcessedFiles[i]) {
-          ProcessedFilesConditionVariable.wait(
-              LockGuard, [&]() { return ProcessedFiles[i]; });
-        }
-      }
-
-      auto &LinkContext = ObjectContexts[i];
-      if (!LinkContext.ObjectFile)
-        continue;
-
-      // Then mark all the DIEs that need to be present in the linked output
-      // and collect some information about them.
-      // Note that this loop can not be merged with the previous one because
-      // cross-cu references require the ParentIdx to be setup for every CU in
-      // the object file before calling this.
-      if (LLVM_UNLIKELY(Options.Update)) {
-        for (auto &CurrentUnit : LinkContext.CompileUnits)
-          CurrentUnit->markEverythingAsKept();
-        Streamer->copyInvariantDebugSection(*LinkContext.ObjectFile);
-      } else {
-        for (auto &CurrentUnit : LinkContext.CompileUnits)
-          lookForDIEsToKeep(LinkContext.RelocMgr, LinkContext.Ranges,
-                            LinkContext.CompileUnits,
-                            CurrentUnit->getOrigUnit().getUnitDIE(),
-                            LinkContext.DMO, *CurrentUnit, 0);
-      }
+  // Note, although this runs in serial, it can run in parallel with
+  // analyzeContextInfo so long as we process files with indices >= than those
+  // processed by analyzeContextInfo.
+  auto CloneObject = [&](unsigned i) {
+    auto &LinkContext = ObjectContexts[i];
+    if (!LinkContext.ObjectFile)
+      return;
 
-      // The calls to applyValidRelocs inside cloneDIE will walk the reloc
-      // array again (in the same way findValidRelocsInDebugInfo() did). We
-      // need to reset the NextValidReloc index to the beginning.
-      LinkContext.RelocMgr.resetValidRelocs();
-      if (LinkContext.RelocMgr.hasValidRelocs() ||
-          LLVM_UNLIKELY(Options.Update))
-        DIECloner(*this, LinkContext.RelocMgr, DIEAlloc,
-                  LinkContext.CompileUnits, Options)
-            .cloneAllCompileUnits(*LinkContext.DwarfContext, LinkContext.DMO,
-                                  LinkContext.Ranges, OffsetsStringPool);
-      if (!Options.NoOutput && !LinkContext.CompileUnits.empty() &&
-          LLVM_LIKELY(!Options.Update))
-        patchFrameInfoForObject(
-            LinkContext.DMO, LinkContext.Ranges, *LinkContext.DwarfContext,
-            LinkContext.CompileUnits[0]->getOrigUnit().getAddressByteSize());
-
-      // Clean-up before starting working on the next object.
-      endDebugObject(LinkContext);
+    // Then mark all the DIEs that need to be present in the linked output
+    // and collect some information about them.
+    // Note that this loop can not be merged with the previous one because
+    // cross-cu references require the ParentIdx to be setup for every CU in
+    // the object file before calling this.
+    if (LLVM_UNLIKELY(Options.Update)) {
+      for (auto &CurrentUnit : LinkContext.CompileUnits)
+        CurrentUnit->markEverythingAsKept();
+      Streamer->copyInvariantDebugSection(*LinkContext.ObjectFile);
+    } else {
+      for (auto &CurrentUnit : LinkContext.CompileUnits)
+        lookForDIEsToKeep(LinkContext.RelocMgr, LinkContext.Ranges,
+                          LinkContext.CompileUnits,
+                          CurrentUnit->getOrigUnit().getUnitDIE(),
+                          LinkContext.DMO, *CurrentUnit, 0);
     }
 
-    // Emit everything that's global.
-    if (!Options.NoOutput) {
-      Streamer->emitAbbrevs(Abbreviations, MaxDwarfVersion);
-      Streamer->emitStrings(OffsetsStringPool);
-      switch (Options.TheAccelTableKind) {
-      case AccelTableKind::Apple:
-        Streamer->emitAppleNames(AppleNames);
-        Streamer->emitAppleNamespaces(AppleNamespaces);
-        Streamer->emitAppleTypes(AppleTypes);
-        Streamer->emitAppleObjc(AppleObjc);
-        break;
-      case AccelTableKind::Dwarf:
-        Streamer->emitDebugNames(DebugNames);
-        break;
-      case AccelTableKind::Default:
-        llvm_unreachable("Default should have already been resolved.");
-        break;
-      }
+    // The calls to applyValidRelocs inside cloneDIE will walk the reloc
+    // array again (in the same way findValidRelocsInDebugInfo() did). We
+    // need to reset the NextValidReloc index to the beginning.
+    LinkContext.RelocMgr.resetValidRelocs();
+    if (LinkContext.RelocMgr.hasValidRelocs() || LLVM_UNLIKELY(Options.Update))
+      DIECloner(*this, LinkContext.RelocMgr, DIEAlloc, LinkContext.CompileUnits,
+                Options)
+          .cloneAllCompileUnits(*LinkContext.DwarfContext, LinkContext.DMO,
+                                LinkContext.Ranges, OffsetsStringPool);
+    if (!Options.NoOutput && !LinkContext.CompileUnits.empty() &&
+        LLVM_LIKELY(!Options.Update))
+      patchFrameInfoForObject(
+          LinkContext.DMO, LinkContext.Ranges, *LinkContext.DwarfContext,
+          LinkContext.CompileUnits[0]->getOrigUnit().getAddressByteSize());
+
+    // Clean-up before starting working on the next object. This releases the
+    // object's DWARFContext and all the DIEs parsed from it.
+    endDebugObject(LinkContext);
+  };
+
+  // Emit everything that's global.
+  auto EmitGlobals = [&]() {
+    if (Options.NoOutput)
+      return;
+    Streamer->emitAbbrevs(Abbreviations, MaxDwarfVersion);
+    Streamer->emitStrings(OffsetsStringPool);
+    switch (Options.TheAccelTableKind) {
+    case AccelTableKind::Apple:
+      Streamer->emitAppleNames(AppleNames);
+      Streamer->emitAppleNamespaces(AppleNamespaces);
+      Streamer->emitAppleTypes(AppleTypes);
+      Streamer->emitAppleObjc(AppleObjc);
+      break;
+    case AccelTableKind::Dwarf:
+      Streamer->emitDebugNames(DebugNames);
+      break;
+    case AccelTableKind::Default:
+      llvm_unreachable("Default should have already been resolved.");
+      break;
     }
   };
 
@@ -2529,13 +2540,40 @@ bool DwarfLinker::link(const DebugMap &Map) {
   // out the (significantly smaller) stack when using threads. We don't
   // want this limitation when we only have a single thread.
   if (Options.Threads == 1) {
-    AnalyzeLambda();
-    CloneLambda();
+    for (unsigned i = 0, e = NumObjects; i != e; ++i) {
+      LoadObject(i);
+      AnalyzeObject(i);
+      CloneObject(i);
+    }
+    EmitGlobals();
   } else {
+    // Objects are loaded by a pool of workers, at most LoadAhead objects
+    // ahead of the one being cloned. This bounds the number of objects whose
+    // DIEs are in memory at any given time.
+    const unsigned NumLoaders = Options.Threads > 2 ? Options.Threads - 2 : 1;
+    const unsigned LoadAhead = std::min(NumObjects, 2 * NumLoaders);
+    ThreadPool LoadPool(NumLoaders);
+    for (unsigned i = 0; i != LoadAhead; ++i)
+      LoadPool.async(LoadObject, i);
+
     ThreadPool pool(2);
-    pool.async(AnalyzeLambda);
-    pool.async(CloneLambda);
+    pool.async([&]() {
+      for (unsigned i = 0, e = NumObjects; i != e; ++i) {
+        WaitFor(LoadedFiles, i);
+        AnalyzeObject(i);
+      }
+    });
+    pool.async([&]() {
+      for (unsigned i = 0, e = NumObjects; i != e; ++i) {
+        WaitFor(ProcessedFiles, i);
+        CloneObject(i);
+        if (i + LoadAhead < NumObjects)
+          LoadPool.async(LoadObject, i + LoadAhead);
+      }
+      EmitGlobals();
+    });
     pool.wait();
+    LoadPool.wait();
   }
 
   return Options.NoOutput ? true : Streamer->finish(Map);
@@ -148,6 +148,9 @@ private:
     std::unique_ptr<DWARFContext> DwarfContext;
     RangesTy Ranges;
     UnitListTy CompileUnits;
+    /// Units that need to be linked, along with their unique ID. Only their
+    /// unit DIE is parsed until the object is loaded for cloning.
+    std::vector<std::pair<DWARFUnit *, unsigned>> UnitsToLoad;
 
     LinkContext(const DebugMap &Map, DwarfLinker &Linker, DebugMapObject &DMO)
         : DMO(DMO), RelocMgr(Linker) {
@@ -166,6 +169,7 @@ private:
     void Clear() {
       DwarfContext.reset(nullptr);
       CompileUnits.clear();
+      UnitsToLoad.clear();
       Ranges.clear();
     }
   };
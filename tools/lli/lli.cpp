@@ -27,11 +27,13 @@
 #include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/ExecutionEngine/Orc/OnDiskObjectCache.h"
 #include "llvm/ExecutionEngine/Orc/OrcRemoteTargetClient.h"
 #include "llvm/ExecutionEngine/OrcMCJITReplacement.h"
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
 #include "llvm/IR/TypeBuilder.h"
@@ -56,6 +58,7 @@
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/IPO/PassManagerBuilder.h"
 #include "llvm/Transforms/Instrumentation.h"
 #include <cerrno>
 
@@ -97,6 +100,19 @@ namespace {
                                            "orc-lazy",
                                            "Orc-based lazy JIT.")));
 
+  cl::opt<unsigned>
+  LazyJITCompileThreads("compile-threads",
+                        cl::desc("Choose the number of compile threads "
+                                 "(jit-kind=orc-lazy only)"),
+                        cl::init(0));
+
+  cl::opt<unsigned>
+  TierUpThreshold("tier-up-threshold",
+                  cl::desc("Recompile functions at -O3 once they have been "
+                           "called this many times (jit-kind=orc-lazy only, "
+                           "0 disables tiered compilation)"),
+                  cl::init(0));
+
   // The MCJIT supports building for a target address space separate from
   // the JIT compilation process. Use a forked process and a copying
   // memory manager with IPC to execute using this functionality.
@@ -337,8 +353,7 @@ static void reportError(SMDiagnostic Err, const char *ProgName) {
   exit(1);
 }
 
-int runOrcLazyJIT(LLVMContext &Ctx, std::vector<std::unique_ptr<Module>> Ms,
-                  const std::vector<std::string> &Args);
+int runOrcLazyJIT(const char *ProgName);
 
 //===----------------------------------------------------------------------===//
 // main Driver function
@@ -362,6 +377,9 @@ int main(int argc, char **argv, char * const *envp) {
   if (DisableCoreFiles)
     sys::Process::PreventCoreFiles();
 
+  if (UseJITKind == JITKind::OrcLazy)
+    return runOrcLazyJIT(argv[0]);
+
   LLVMContext Context;
 
   // Load the bitcode...
@@ -371,21 +389,6 @@ int main(int argc, char **argv, char * const *envp) {
   if (!Mod)
     reportError(Err, argv[0]);
 
-  if (UseJITKind == JITKind::OrcLazy) {
-    std::vector<std::unique_ptr<Module>> Ms;
-    Ms.push_back(std::move(Owner));
-    for (auto &ExtraMod : ExtraModules) {
-      Ms.push_back(parseIRFile(ExtraMod, Err, Context));
-      if (!Ms.back())
-        reportError(Err, argv[0]);
-    }
-    std::vector<std::string> Args;
-    Args.push_back(InputFile);
-    for (auto &Arg : InputArgv)
-      Args.push_back(Arg);
-    return runOrcLazyJIT(Context, std::move(Ms), Args);
-  }
-
   if (EnableCacheManager) {
     std::string CacheName("file:");
     CacheName.append(InputFile);
@@ -691,13 +694,13 @@ int main(int argc, char **argv, char * const *envp) {
 static orc::IRTransformLayer2::TransformFunction createDebugDumper() {
   switch (OrcDumpKind) {
   case DumpKind::NoDump:
-    return [](std::unique_ptr<Module> M) { return M; };
+    return [](orc::ThreadSafeModule TSM) { return TSM; };
 
   case DumpKind::DumpFuncsToStdOut:
-    return [](std::unique_ptr<Module> M) {
+    return [](orc::ThreadSafeModule TSM) {
       printf("[ ");
 
-      for (const auto &F : *M) {
+      for (const auto &F : *TSM.getModule()) {
         if (F.isDeclaration())
           continue;
 
@@ -709,19 +712,20 @@ static orc::IRTransformLayer2::TransformFunction createDebugDumper() {
       }
 
       printf("]\n");
-      return M;
+      return TSM;
     };
 
   case DumpKind::DumpModsToStdOut:
-    return [](std::unique_ptr<Module> M) {
+    return [](orc::ThreadSafeModule TSM) {
       outs() << "----- Module Start -----\n"
-             << *M << "----- Module End -----\n";
+             << *TSM.getModule() << "----- Module End -----\n";
 
-      return M;
+      return TSM;
     };
 
   case DumpKind::DumpModsToDisk:
-    return [](std::unique_ptr<Module> M) {
+    return [](orc::ThreadSafeModule TSM) {
+      auto *M = TSM.getModule();
       std::error_code EC;
       raw_fd_ostream Out(M->getModuleIdentifier() + ".ll", EC, sys::fs::F_Text);
       if (EC) {
@@ -730,17 +734,32 @@ static orc::IRTransformLayer2::TransformFunction createDebugDumper() {
         exit(1);
       }
       Out << *M;
-      return M;
+      return TSM;
     };
   }
   llvm_unreachable("Unknown DumpKind");
 }
 
-int runOrcLazyJIT(LLVMContext &Ctx, std::vector<std::unique_ptr<Module>> Ms,
-                  const std::vector<std::string> &Args) {
-  // Bail out early if no modules loaded.
-  if (Ms.empty())
-    return 0;
+int runOrcLazyJIT(const char *ProgName) {
+  // All modules share one context. Lazily extracted functions are cloned into
+  // fresh contexts by the JIT, so they can still be compiled concurrently.
+  orc::ThreadSafeContext TSCtx(llvm::make_unique<LLVMContext>());
+
+  // Load the main and extra modules.
+  std::vector<orc::ThreadSafeModule> Ms;
+  {
+    std::vector<std::string> Files;
+    Files.push_back(InputFile);
+    Files.insert(Files.end(), ExtraModules.begin(), ExtraModules.end());
+
+    SMDiagnostic Err;
+    for (auto &File : Files) {
+      auto M = parseIRFile(File, Err, *TSCtx.getContext());
+      if (!M)
+        reportError(Err, ProgName);
+      Ms.push_back(orc::ThreadSafeModule(std::move(M), TSCtx));
+    }
+  }
 
   // Add lli's symbols into the JIT's search space.
   std::string ErrMsg;
@@ -751,7 +770,7 @@ int runOrcLazyJIT(LLVMContext &Ctx, std::vector<std::unique_ptr<Module>> Ms,
     return 1;
   }
 
-  const auto &TT = Ms.front()->getTargetTriple();
+  const auto &TT = Ms.front().getModule()->getTargetTriple();
   orc::JITTargetMachineBuilder TMD =
       TT.empty() ? ExitOnErr(orc::JITTargetMachineBuilder::detectHost())
                  : orc::JITTargetMachineBuilder(Triple(TT));
@@ -767,20 +786,42 @@ int runOrcLazyJIT(LLVMContext &Ctx, std::vector<std::unique_ptr<Module>> Ms,
                         : None);
   auto TM = ExitOnErr(TMD.createTargetMachine());
   auto DL = TM->createDataLayout();
+
+  // Cache compiled objects on disk, keyed by module content.
+  std::unique_ptr<orc::OnDiskObjectCache> ObjCache;
+  if (EnableCacheManager)
+    ObjCache = ExitOnErr(orc::OnDiskObjectCache::Create(
+        ObjectCacheDir.empty() ? StringRef(".") : StringRef(ObjectCacheDir),
+        *TM));
+
   auto ES = llvm::make_unique<orc::ExecutionSession>();
-  auto J =
-      ExitOnErr(orc::LLLazyJIT::Create(std::move(ES), std::move(TM), DL, Ctx));
+  auto J = ExitOnErr(orc::LLLazyJIT::Create(std::move(ES), std::move(TMD), DL,
+                                            LazyJITCompileThreads));
+
+  if (ObjCache)
+    J->setObjectCache(ObjCache.get());
 
   auto Dump = createDebugDumper();
 
   J->setLazyCompileTransform(
-    [&](std::unique_ptr<Module> M) {
-      if (verifyModule(*M, &dbgs())) {
-        dbgs() << "Bad module: " << *M << "\n";
+    [&](orc::ThreadSafeModule TSM) {
+      if (verifyModule(*TSM.getModule(), &dbgs())) {
+        dbgs() << "Bad module: " << *TSM.getModule() << "\n";
         exit(1);
       }
-      return Dump(std::move(M));
+      return Dump(std::move(TSM));
     });
+  if (TierUpThreshold)
+    J->setTierUpTransform(
+        [](orc::ThreadSafeModule TSM) -> Expected<orc::ThreadSafeModule> {
+          legacy::PassManager PM;
+          PassManagerBuilder Builder;
+          Builder.OptLevel = 3;
+          Builder.populateModulePassManager(PM);
+          PM.run(*TSM.getModule());
+          return std::move(TSM);
+        },
+        orc::TieredCompileLayer::callCountThreshold(TierUpThreshold));
   J->getMainVSO().setFallbackDefinitionGenerator(
       orc::DynamicLibraryFallbackGenerator(
           std::move(LibLLI), DL, [](orc::SymbolStringPtr) { return true; }));
@@ -790,7 +831,7 @@ int runOrcLazyJIT(LLVMContext &Ctx, std::vector<std::unique_ptr<Module>> Ms,
   ExitOnErr(CXXRuntimeOverrides.enable(J->getMainVSO(), Mangle));
 
   for (auto &M : Ms) {
-    orc::makeAllSymbolsExternallyAccessible(*M);
+    orc::makeAllSymbolsExternallyAccessible(*M.getModule());
     ExitOnErr(J->addLazyIRModule(std::move(M)));
   }
 
@@ -799,7 +840,8 @@ int runOrcLazyJIT(LLVMContext &Ctx, std::vector<std::unique_ptr<Module>> Ms,
   auto MainSym = ExitOnErr(J->lookup("main"));
   typedef int (*MainFnPtr)(int, const char *[]);
   std::vector<const char *> ArgV;
-  for (auto &Arg : Args)
+  ArgV.push_back(InputFile.c_str());
+  for (auto &Arg : InputArgv)
     ArgV.push_back(Arg.c_str());
   auto Main =
       reinterpret_cast<MainFnPtr>(static_cast<uintptr_t>(MainSym.getAddress()));
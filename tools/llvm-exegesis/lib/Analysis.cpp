@@ -210,6 +210,27 @@ Analysis::makePointsPerSchedClass() const {
   return PointsPerSchedClass;
 }
 
+std::vector<Analysis::SchedClassCluster> Analysis::makeSchedClassClusters(
+    const std::vector<size_t> &SchedClassPoints) const {
+  std::vector<SchedClassCluster> SchedClassClusters;
+  for (const size_t PointId : SchedClassPoints) {
+    const auto &ClusterId = Clustering_.getClusterIdForPoint(PointId);
+    if (!ClusterId.isValid())
+      continue; // Ignore noise and errors. FIXME: take noise into account ?
+    auto SchedClassClusterIt =
+        std::find_if(SchedClassClusters.begin(), SchedClassClusters.end(),
+                     [ClusterId](const SchedClassCluster &C) {
+                       return C.id() == ClusterId;
+                     });
+    if (SchedClassClusterIt == SchedClassClusters.end()) {
+      SchedClassClusters.emplace_back();
+      SchedClassClusterIt = std::prev(SchedClassClusters.end());
+    }
+    SchedClassClusterIt->addPoint(PointId, Clustering_);
+  }
+  return SchedClassClusters;
+}
+
 // Uops repeat the same opcode over again. Just show this opcode and show the
 // whole snippet only on hover.
 static void writeUopsSnippetHtml(llvm::raw_ostream &OS,
@@ -589,24 +610,8 @@ llvm::Error Analysis::run<Analysis::PrintSchedClassInconsistencies>(
     if (!SCDesc)
       continue;
     const SchedClass SC(*SCDesc, *SubtargetInfo_);
-
-    // Bucket sched class points into sched class clusters.
-    std::vector<SchedClassCluster> SchedClassClusters;
-    for (const size_t PointId : SchedClassPoints) {
-      const auto &ClusterId = Clustering_.getClusterIdForPoint(PointId);
-      if (!ClusterId.isValid())
-        continue; // Ignore noise and errors. FIXME: take noise into account ?
-      auto SchedClassClusterIt =
-          std::find_if(SchedClassClusters.begin(), SchedClassClusters.end(),
-                       [ClusterId](const SchedClassCluster &C) {
-                         return C.id() == ClusterId;
-                       });
-      if (SchedClassClusterIt == SchedClassClusters.end()) {
-        SchedClassClusters.emplace_back();
-        SchedClassClusterIt = std::prev(SchedClassClusters.end());
-      }
-      SchedClassClusterIt->addPoint(PointId, Clustering_);
-    }
+    const std::vector<SchedClassCluster> SchedClassClusters =
+        makeSchedClassClusters(SchedClassPoints);
 
     // Print any scheduling class that has at least one cluster that does not
     // match the checked-in data.
@@ -636,6 +641,145 @@ llvm::Error Analysis::run<Analysis::PrintSchedClassInconsistencies>(
   return llvm::Error::success();
 }
 
+static uint16_t roundToCycles(float Value) {
+  return static_cast<uint16_t>(std::max(1.0f, std::round(Value)));
+}
+
+static unsigned getMaxLatency(const llvm::MCSubtargetInfo &STI,
+                              const llvm::MCSchedClassDesc &SCDesc) {
+  unsigned Latency = 0;
+  for (unsigned I = 0; I < SCDesc.NumWriteLatencyEntries; ++I)
+    Latency = std::max<unsigned>(Latency,
+                                 STI.getWriteLatencyEntry(&SCDesc, I)->Cycles);
+  return Latency;
+}
+
+static bool sameWriteProcRes(llvm::ArrayRef<llvm::MCWriteProcResEntry> A,
+                             llvm::ArrayRef<llvm::MCWriteProcResEntry> B) {
+  return A.size() == B.size() &&
+         std::equal(A.begin(), A.end(), B.begin(),
+                    [](const llvm::MCWriteProcResEntry &X,
+                       const llvm::MCWriteProcResEntry &Y) {
+                      return X.ProcResourceIdx == Y.ProcResourceIdx &&
+                             X.Cycles == Y.Cycles;
+                    });
+}
+
+bool Analysis::printSchedWriteResTd(const SchedClassCluster &Cluster,
+                                    const SchedClass &SC, unsigned WriteResId,
+                                    llvm::raw_ostream &OS) const {
+  const auto &SM = SubtargetInfo_->getSchedModel();
+  const auto &Points = Clustering_.getPoints();
+  const unsigned ModelLatency = getMaxLatency(*SubtargetInfo_, *SC.SCDesc);
+  unsigned Latency = ModelLatency;
+  llvm::SmallVector<llvm::MCWriteProcResEntry, 8> WriteProcRes(
+      SC.NonRedundantWriteProcRes.begin(), SC.NonRedundantWriteProcRes.end());
+
+  // Only the measured dimension is updated, the rest comes from the model.
+  switch (Points[Cluster.getPointIds()[0]].Mode) {
+  case InstructionBenchmark::Latency:
+    Latency = std::round(Cluster.getRepresentative()[0].avg());
+    if (Latency == ModelLatency)
+      return false;
+    break;
+  case InstructionBenchmark::Uops: {
+    std::vector<std::pair<uint16_t, float>> UnitPressure;
+    for (const auto &Stats : Cluster.getRepresentative()) {
+      uint16_t ProcResIdx = 0;
+      if (!llvm::to_integer(Stats.key(), ProcResIdx, 10))
+        return false;
+      UnitPressure.emplace_back(ProcResIdx, Stats.avg());
+    }
+    WriteProcRes = inferWriteProcRes(SM, UnitPressure);
+    if (sameWriteProcRes(WriteProcRes, SC.NonRedundantWriteProcRes))
+      return false;
+    break;
+  }
+  default:
+    llvm_unreachable("invalid mode");
+  }
+
+  // Several configurations of the same opcode can end up in the cluster.
+  std::set<llvm::StringRef> Opcodes;
+  for (const size_t PointId : Cluster.getPointIds())
+    Opcodes.insert(
+        InstrInfo_->getName(Points[PointId].Key.Instructions[0].getOpcode()));
+
+  const std::string Name = llvm::formatv("ExegesisWriteResGroup{0}",
+                                         WriteResId);
+  OS << "def " << Name << " : SchedWriteRes<[";
+  for (size_t I = 0, E = WriteProcRes.size(); I < E; ++I)
+    OS << (I ? ", " : "")
+       << SM.getProcResource(WriteProcRes[I].ProcResourceIdx)->Name;
+  OS << "]> {\n";
+  OS << "  let Latency = " << Latency << ";\n";
+  OS << "  let NumMicroOps = " << SC.SCDesc->NumMicroOps << ";\n";
+  OS << "  let ResourceCycles = [";
+  for (size_t I = 0, E = WriteProcRes.size(); I < E; ++I)
+    OS << (I ? ", " : "") << WriteProcRes[I].Cycles;
+  OS << "];\n}\n";
+  OS << "def : InstRW<[" << Name << "], (instrs ";
+  bool First = true;
+  for (const llvm::StringRef Opcode : Opcodes) {
+    OS << (First ? "" : ",\n" + std::string(Name.size() + 25, ' ')) << Opcode;
+    First = false;
+  }
+  OS << ")>;\n\n";
+  return true;
+}
+
+template <>
+llvm::Error
+Analysis::run<Analysis::PrintSchedModelDiff>(llvm::raw_ostream &OS) const {
+  if (Clustering_.getPoints().empty())
+    return llvm::Error::success();
+
+  const auto &FirstPoint = Clustering_.getPoints()[0];
+  OS << "// Scheduling model overrides for " << FirstPoint.LLVMTriple
+     << ", cpu '" << FirstPoint.CpuName << "'.\n"
+     << "// Generated by llvm-exegesis from "
+     << (FirstPoint.Mode == InstructionBenchmark::Latency ? "latency" : "uops")
+     << " measurements. Add these definitions to the\n"
+     << "// SchedMachineModel of the cpu to override the existing entries.\n\n";
+
+  // Sort sched classes so that the output is stable.
+  const auto PointsPerSchedClass = makePointsPerSchedClass();
+  std::vector<unsigned> SchedClassIds;
+  for (const auto &SchedClassAndPoints : PointsPerSchedClass)
+    SchedClassIds.push_back(SchedClassAndPoints.first);
+  llvm::sort(SchedClassIds.begin(), SchedClassIds.end());
+
+  unsigned NumWriteRes = 0;
+  for (const unsigned SchedClassId : SchedClassIds) {
+    const auto &SchedModel = SubtargetInfo_->getSchedModel();
+    const llvm::MCSchedClassDesc *const SCDesc =
+        SchedModel.getSchedClassDesc(SchedClassId);
+    if (!SCDesc || !SCDesc->isValid() || SCDesc->isVariant())
+      continue;
+    const SchedClass SC(*SCDesc, *SubtargetInfo_);
+    for (const SchedClassCluster &Cluster :
+         makeSchedClassClusters(PointsPerSchedClass.at(SchedClassId))) {
+      if (Cluster.measurementsMatch(*SubtargetInfo_, SC, Clustering_))
+        continue;
+      std::string Def;
+      llvm::raw_string_ostream DefOS(Def);
+      if (!printSchedWriteResTd(Cluster, SC, NumWriteRes, DefOS))
+        continue;
+      ++NumWriteRes;
+      OS << "// Sched class ";
+#if !defined(NDEBUG) || defined(LLVM_ENABLE_DUMP)
+      OS << SCDesc->Name;
+#else
+      OS << SchedClassId;
+#endif
+      OS << ", cluster ";
+      writeClusterId<kEscapeCsv>(OS, Cluster.id());
+      OS << ".\n" << DefOS.str();
+    }
+  }
+  return llvm::Error::success();
+}
+
 // Distributes a pressure budget as evenly as possible on the provided subunits
 // given the already existing port pressure distribution.
 //
@@ -750,4 +894,47 @@ std::vector<std::pair<uint16_t, float>> computeIdealizedProcResPressure(
   return Pressure;
 }
 
+llvm::SmallVector<llvm::MCWriteProcResEntry, 8>
+inferWriteProcRes(const llvm::MCSchedModel &SM,
+                  llvm::ArrayRef<std::pair<uint16_t, float>> UnitPressure) {
+  // Pressure below this threshold is considered to be measurement noise.
+  constexpr const float kNegligiblePressure = 0.1f;
+  llvm::SmallVector<std::pair<uint16_t, float>, 8> UsedUnits;
+  float TotalPressure = 0.0f;
+  for (const auto &Pressure : UnitPressure) {
+    if (Pressure.second < kNegligiblePressure)
+      continue;
+    UsedUnits.push_back(Pressure);
+    TotalPressure += Pressure.second;
+  }
+  llvm::sort(UsedUnits.begin(), UsedUnits.end());
+
+  llvm::SmallVector<llvm::MCWriteProcResEntry, 8> Result;
+  if (UsedUnits.size() > 1) {
+    // Look for a group made of exactly the used units.
+    for (unsigned I = 1, E = SM.getNumProcResourceKinds(); I < E; ++I) {
+      const llvm::MCProcResourceDesc *const ProcResDesc = SM.getProcResource(I);
+      if (ProcResDesc->SubUnitsIdxBegin == nullptr ||
+          ProcResDesc->NumUnits != UsedUnits.size())
+        continue;
+      llvm::SmallVector<uint16_t, 8> Subunits(ProcResDesc->SubUnitsIdxBegin,
+                                              ProcResDesc->SubUnitsIdxBegin +
+                                                  ProcResDesc->NumUnits);
+      llvm::sort(Subunits.begin(), Subunits.end());
+      if (std::equal(Subunits.begin(), Subunits.end(), UsedUnits.begin(),
+                     [](uint16_t Subunit,
+                        const std::pair<uint16_t, float> &Pressure) {
+                       return Subunit == Pressure.first;
+                     })) {
+        Result.push_back({static_cast<uint16_t>(I),
+                          roundToCycles(TotalPressure)});
+        return Result;
+      }
+    }
+  }
+  for (const auto &Pressure : UsedUnits)
+    Result.push_back({Pressure.first, roundToCycles(Pressure.second)});
+  return Result;
+}
+
 } // namespace exegesis
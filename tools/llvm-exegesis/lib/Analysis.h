@@ -42,6 +42,9 @@ public:
   struct PrintClusters {};
   // Find potential errors in the scheduling information given measurements.
   struct PrintSchedClassInconsistencies {};
+  // Prints TableGen overrides (SchedWriteRes + InstRW) for the sched classes
+  // whose measurements do not match the scheduling model.
+  struct PrintSchedModelDiff {};
 
   template <typename Pass> llvm::Error run(llvm::raw_ostream &OS) const;
 
@@ -102,6 +105,18 @@ private:
   std::unordered_map<unsigned, std::vector<size_t>>
   makePointsPerSchedClass() const;
 
+  // Buckets the given points of a sched class into sched class clusters.
+  // Noise and errors are ignored.
+  std::vector<SchedClassCluster>
+  makeSchedClassClusters(const std::vector<size_t> &SchedClassPoints) const;
+
+  // Prints the SchedWriteRes and InstRW definitions that make the scheduling
+  // model match the measurements of `Cluster`. Returns false if the model
+  // already matches once measurements are rounded to whole cycles.
+  bool printSchedWriteResTd(const SchedClassCluster &Cluster,
+                            const SchedClass &SC, unsigned WriteResId,
+                            llvm::raw_ostream &OS) const;
+
   template <typename EscapeTag, EscapeTag Tag>
   void writeSnippet(llvm::raw_ostream &OS, llvm::ArrayRef<uint8_t> Bytes,
                     const char *Separator) const;
@@ -124,6 +139,14 @@ std::vector<std::pair<uint16_t, float>> computeIdealizedProcResPressure(
     const llvm::MCSchedModel &SM,
     llvm::SmallVector<llvm::MCWriteProcResEntry, 8> WPRS);
 
+// Computes the WriteProcRes entries that best describe a measured ProcRes Unit
+// pressure. Units with negligible pressure are ignored. If the remaining units
+// are exactly the subunits of a ProcResGroup, the pressure is assigned to that
+// group. Otherwise each unit gets its own entry.
+llvm::SmallVector<llvm::MCWriteProcResEntry, 8>
+inferWriteProcRes(const llvm::MCSchedModel &SM,
+                  llvm::ArrayRef<std::pair<uint16_t, float>> UnitPressure);
+
 } // namespace exegesis
 
 #endif // LLVM_TOOLS_LLVM_EXEGESIS_CLUSTERING_H
@@ -25,14 +25,22 @@
 #include "llvm/MC/MCRegisterInfo.h"
 #include "llvm/MC/MCSubtargetInfo.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Program.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ThreadPool.h"
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <random>
 #include <string>
 #include <unordered_map>
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 static llvm::cl::opt<unsigned>
     OpcodeIndex("opcode-index", llvm::cl::desc("opcode to measure, by index"),
@@ -82,6 +90,36 @@ static llvm::cl::opt<std::string>
 static llvm::cl::opt<std::string>
     AnalysisInconsistenciesOutputFile("analysis-inconsistencies-output-file",
                                       llvm::cl::desc(""), llvm::cl::init("-"));
+static llvm::cl::opt<std::string> AnalysisSchedModelDiffOutputFile(
+    "analysis-sched-model-diff-output-file",
+    llvm::cl::desc("where to print TableGen overrides for the sched classes "
+                   "that do not match the measurements"),
+    llvm::cl::init(""));
+
+static llvm::cl::opt<bool>
+    Sweep("sweep",
+          llvm::cl::desc("measure all the opcodes of the target, each in its "
+                         "own process, and store the results in "
+                         "--sweep-database"),
+          llvm::cl::init(false));
+
+static llvm::cl::opt<std::string> SweepDatabase(
+    "sweep-database",
+    llvm::cl::desc("directory holding one result file per opcode; opcodes "
+                   "that already have a result are not measured again, so an "
+                   "interrupted sweep can be resumed"),
+    llvm::cl::init(""));
+
+static llvm::cl::list<unsigned>
+    SweepCpus("sweep-cpus",
+              llvm::cl::desc("cpus to run the sweep on; one benchmark process "
+                             "is pinned to each of them at a time"),
+              llvm::cl::CommaSeparated);
+
+static llvm::cl::opt<int>
+    PinToCpu("pin-to-cpu",
+             llvm::cl::desc("pin the benchmark process to this cpu"),
+             llvm::cl::init(-1));
 
 namespace exegesis {
 
@@ -119,6 +157,19 @@ getBenchmarkResultContext(const LLVMState &State) {
   return Ctx;
 }
 
+static void pinToCpu(unsigned Cpu) {
+#ifdef __linux__
+  cpu_set_t CpuSet;
+  CPU_ZERO(&CpuSet);
+  CPU_SET(Cpu, &CpuSet);
+  if (sched_setaffinity(0, sizeof(CpuSet), &CpuSet) != 0)
+    llvm::report_fatal_error(llvm::Twine("cannot pin to cpu ") +
+                             llvm::Twine(Cpu));
+#else
+  llvm::report_fatal_error("--pin-to-cpu is not supported on this platform");
+#endif
+}
+
 void benchmarkMain() {
   if (exegesis::pfm::pfmInitialize())
     llvm::report_fatal_error("cannot initialize libpfm");
@@ -153,15 +204,143 @@ void benchmarkMain() {
   if (BenchmarkFile.empty())
     BenchmarkFile = "-";
 
+  if (PinToCpu >= 0)
+    pinToCpu(PinToCpu);
+
   const BenchmarkResultContext Context = getBenchmarkResultContext(State);
   std::vector<InstructionBenchmark> Results =
       ExitOnErr(Runner->run(Opcode, NumRepetitions));
+  // All the results go to the same file, one YAML document each.
+  std::error_code ErrorCode;
+  llvm::raw_fd_ostream OS(BenchmarkFile, ErrorCode, llvm::sys::fs::F_None);
+  if (ErrorCode)
+    llvm::report_fatal_error("cannot open out file: " + BenchmarkFile);
   for (InstructionBenchmark &Result : Results)
-    ExitOnErr(Result.writeYaml(Context, BenchmarkFile));
+    Result.writeYamlTo(Context, OS);
 
   exegesis::pfm::pfmTerminate();
 }
 
+// Returns the path of the database entry for `OpcodeName` with the given
+// extension: ".yaml" for results, ".failed" for opcodes that could not be
+// measured.
+static std::string getSweepEntryPath(llvm::StringRef OpcodeName,
+                                     llvm::StringRef Extension) {
+  llvm::SmallString<128> Path(SweepDatabase);
+  llvm::sys::path::append(
+      Path, llvm::Twine(OpcodeName) + "." +
+                (BenchmarkMode == InstructionBenchmark::Latency ? "latency"
+                                                                : "uops") +
+                Extension);
+  return Path.str();
+}
+
+// Measures one opcode in a child process, and records the outcome in the
+// database. Results are written to a temporary file and only renamed once
+// complete, so that a killed sweep never leaves partial entries behind.
+static void runSweepEntry(llvm::StringRef Executable, unsigned Opcode,
+                          llvm::StringRef OpcodeName, int Cpu,
+                          std::mutex &LogMutex) {
+  const std::string ResultPath = getSweepEntryPath(OpcodeName, ".yaml");
+  const std::string TempPath = ResultPath + ".tmp";
+  llvm::sys::fs::remove(TempPath);
+
+  const std::string ModeArg =
+      std::string("-mode=") +
+      (BenchmarkMode == InstructionBenchmark::Latency ? "latency" : "uops");
+  const std::string OpcodeArg = "-opcode-index=" + llvm::utostr(Opcode);
+  const std::string RepetitionsArg =
+      "-num-repetitions=" + llvm::utostr(NumRepetitions);
+  const std::string FileArg = "-benchmarks-file=" + TempPath;
+  const std::string CpuArg = "-pin-to-cpu=" + llvm::itostr(Cpu);
+  llvm::SmallVector<llvm::StringRef, 8> Args = {Executable, ModeArg, OpcodeArg,
+                                                RepetitionsArg, FileArg};
+  if (Cpu >= 0)
+    Args.push_back(CpuArg);
+  if (IgnoreInvalidSchedClass)
+    Args.push_back("-ignore-invalid-sched-class");
+
+  std::string ErrMsg;
+  const int RC = llvm::sys::ExecuteAndWait(Executable, Args, llvm::None, {},
+                                           /*SecondsToWait=*/0,
+                                           /*MemoryLimit=*/0, &ErrMsg);
+  std::error_code EC;
+  if (RC == 0) {
+    // Instructions that cannot be measured produce no output.
+    if (llvm::sys::fs::exists(TempPath))
+      EC = llvm::sys::fs::rename(TempPath, ResultPath);
+    else
+      llvm::raw_fd_ostream EmptyResult(ResultPath, EC, llvm::sys::fs::F_None);
+  } else {
+    llvm::sys::fs::remove(TempPath);
+    llvm::raw_fd_ostream OS(getSweepEntryPath(OpcodeName, ".failed"), EC,
+                            llvm::sys::fs::F_None);
+    OS << "exit code " << RC << (ErrMsg.empty() ? "" : ": ") << ErrMsg << "\n";
+  }
+
+  std::lock_guard<std::mutex> Lock(LogMutex);
+  llvm::errs() << OpcodeName << ": "
+               << (RC == 0 ? "done" : "failed (exit code " + llvm::itostr(RC) +
+                                          ")");
+  if (Cpu >= 0)
+    llvm::errs() << " on cpu " << Cpu;
+  llvm::errs() << "\n";
+  if (EC)
+    llvm::errs() << OpcodeName << ": cannot write database entry: "
+                 << EC.message() << "\n";
+}
+
+static void sweepMain(const char *Argv0) {
+  if (SweepDatabase.empty())
+    llvm::report_fatal_error("--sweep-database must be set.");
+  if (std::error_code EC = llvm::sys::fs::create_directories(SweepDatabase))
+    llvm::report_fatal_error("cannot create sweep database: " + EC.message());
+
+  llvm::InitializeNativeTarget();
+  llvm::InitializeNativeTargetAsmPrinter();
+  const LLVMState State;
+  const llvm::MCInstrInfo &InstrInfo = State.getInstrInfo();
+
+  // Collect the opcodes that are not in the database yet.
+  std::vector<unsigned> Opcodes;
+  unsigned NumDone = 0;
+  for (unsigned I = 1, E = InstrInfo.getNumOpcodes(); I < E; ++I) {
+    const llvm::MCInstrDesc &Desc = InstrInfo.get(I);
+    if (Desc.isPseudo())
+      continue;
+    if (IgnoreInvalidSchedClass && Desc.getSchedClass() == 0)
+      continue;
+    const llvm::StringRef Name = InstrInfo.getName(I);
+    if (llvm::sys::fs::exists(getSweepEntryPath(Name, ".yaml")) ||
+        llvm::sys::fs::exists(getSweepEntryPath(Name, ".failed"))) {
+      ++NumDone;
+      continue;
+    }
+    Opcodes.push_back(I);
+  }
+  llvm::errs() << "Sweeping " << Opcodes.size() << " opcodes (" << NumDone
+               << " already in the database)\n";
+
+  const std::string Executable =
+      llvm::sys::fs::getMainExecutable(Argv0, (void *)&sweepMain);
+  // Without explicit cpus, run a single unpinned process at a time.
+  std::vector<int> Cpus(SweepCpus.begin(), SweepCpus.end());
+  if (Cpus.empty())
+    Cpus.push_back(-1);
+
+  std::atomic<size_t> NextOpcode(0);
+  std::mutex LogMutex;
+  llvm::ThreadPool Pool(Cpus.size());
+  for (const int Cpu : Cpus) {
+    Pool.async([&, Cpu]() {
+      for (size_t I = NextOpcode++; I < Opcodes.size(); I = NextOpcode++)
+        runSweepEntry(Executable, Opcodes[I], InstrInfo.getName(Opcodes[I]),
+                      Cpu, LogMutex);
+    });
+  }
+  Pool.wait();
+}
+
 // Prints the results of running analysis pass `Pass` to file `OutputFilename`
 // if OutputFilename is non-empty.
 template <typename Pass>
@@ -190,11 +369,30 @@ static void analysisMain() {
   llvm::InitializeNativeTarget();
   llvm::InitializeNativeTargetAsmPrinter();
   llvm::InitializeNativeTargetDisassembler();
-  // Read benchmarks.
+  // Read benchmarks, either from a single file or from all the results of a
+  // sweep database.
   const LLVMState State;
-  const std::vector<InstructionBenchmark> Points =
-      ExitOnErr(InstructionBenchmark::readYamls(
-          getBenchmarkResultContext(State), BenchmarkFile));
+  const BenchmarkResultContext Context = getBenchmarkResultContext(State);
+  std::vector<InstructionBenchmark> Points;
+  if (llvm::sys::fs::is_directory(BenchmarkFile)) {
+    std::vector<std::string> Files;
+    std::error_code EC;
+    for (llvm::sys::fs::directory_iterator It(BenchmarkFile, EC), End;
+         It != End && !EC; It.increment(EC))
+      if (llvm::sys::path::extension(It->path()) == ".yaml")
+        Files.push_back(It->path());
+    if (EC)
+      llvm::report_fatal_error("cannot read directory: " + BenchmarkFile);
+    llvm::sort(Files.begin(), Files.end());
+    for (const std::string &File : Files) {
+      std::vector<InstructionBenchmark> FilePoints =
+          ExitOnErr(InstructionBenchmark::readYamls(Context, File));
+      std::move(FilePoints.begin(), FilePoints.end(),
+                std::back_inserter(Points));
+    }
+  } else {
+    Points = ExitOnErr(InstructionBenchmark::readYamls(Context, BenchmarkFile));
+  }
   llvm::outs() << "Parsed " << Points.size() << " benchmark points\n";
   if (Points.empty()) {
     llvm::errs() << "no benchmarks to analyze\n";
@@ -220,6 +418,8 @@ static void analysisMain() {
   maybeRunAnalysis<Analysis::PrintSchedClassInconsistencies>(
       Analyzer, "sched class consistency analysis",
       AnalysisInconsistenciesOutputFile);
+  maybeRunAnalysis<Analysis::PrintSchedModelDiff>(
+      Analyzer, "scheduling model diff", AnalysisSchedModelDiffOutputFile);
 }
 
 } // namespace exegesis
@@ -235,6 +435,8 @@ int main(int Argc, char **Argv) {
 
   if (BenchmarkMode == exegesis::InstructionBenchmark::Unknown) {
     exegesis::analysisMain();
+  } else if (Sweep) {
+    exegesis::sweepMain(Argv[0]);
   } else {
     exegesis::benchmarkMain();
   }
@@ -13,6 +13,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "CodeRegion.h"
+#include "llvm/ADT/StringExtras.h"
 
 using namespace llvm;
 
@@ -52,15 +53,51 @@ void CodeRegions::endRegion(SMLoc Loc) {
   CurrentRegion.setEndLocation(Loc);
 }
 
+void CodeRegions::addAddressStream(StringRef Operands, SMLoc Loc) {
+  SmallVector<StringRef, 2> Tokens;
+  SplitString(Operands, Tokens);
+
+  uint64_t Base;
+  int64_t Stride = 0;
+  if (Tokens.empty() || Tokens.size() > 2 ||
+      Tokens[0].getAsInteger(0, Base) ||
+      (Tokens.size() == 2 && Tokens[1].getAsInteger(0, Stride))) {
+    SM.PrintMessage(Loc, SourceMgr::DK_Warning,
+                    "Ignoring invalid address annotation");
+    return;
+  }
+
+  PendingAddressStreams.push_back({Loc, Base, Stride});
+}
+
 void CodeRegions::addInstruction(std::unique_ptr<const MCInst> Instruction) {
   const SMLoc &Loc = Instruction->getLoc();
+
+  // An address annotation only applies to the instruction that follows it.
+  const PendingAddressStream *Stream = nullptr;
+  unsigned NumBefore = 0;
+  for (const PendingAddressStream &S : PendingAddressStreams) {
+    if (S.Loc.getPointer() > Loc.getPointer())
+      break;
+    Stream = &S;
+    ++NumBefore;
+  }
+
   const auto It =
       std::find_if(Regions.rbegin(), Regions.rend(),
                    [Loc](const std::unique_ptr<CodeRegion> &Region) {
                      return Region->isLocInRange(Loc);
                    });
-  if (It != Regions.rend())
-    (*It)->addInstruction(std::move(Instruction));
+  if (It != Regions.rend()) {
+    CodeRegion &Region = **It;
+    Region.addInstruction(std::move(Instruction));
+    if (Stream)
+      Region.getAddressStreams().setLinearStream(
+          Region.getInstructions().size() - 1, Stream->Base, Stream->Stride);
+  }
+
+  PendingAddressStreams.erase(PendingAddressStreams.begin(),
+                              PendingAddressStreams.begin() + NumBefore);
 }
 
 } // namespace mca
@@ -28,14 +28,21 @@
 ///
 /// An instruction (a MCInst) is added to a region R only if its location is in
 /// range [R.RangeStart, R.RangeEnd].
+///
+/// A comment of the form "LLVM-MCA-ADDRESS <base> [<stride>]" gives the
+/// address accessed by the next instruction on the first iteration, and the
+/// amount it is advanced by on every following iteration. Addresses are only
+/// used by the cache model.
 //
 //===----------------------------------------------------------------------===//
 
 #ifndef LLVM_TOOLS_LLVM_MCA_CODEREGION_H
 #define LLVM_TOOLS_LLVM_MCA_CODEREGION_H
 
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/MC/MCInst.h"
+#include "llvm/MCA/CacheModel.h"
 #include "llvm/Support/SMLoc.h"
 #include "llvm/Support/SourceMgr.h"
 #include <vector>
@@ -53,6 +60,8 @@ class CodeRegion {
   // Source location range.
   llvm::SMLoc RangeStart;
   llvm::SMLoc RangeEnd;
+  // Addresses accessed by memory operations, from LLVM-MCA-ADDRESS comments.
+  AddressStreams Addresses;
 
   CodeRegion(const CodeRegion &) = delete;
   CodeRegion &operator=(const CodeRegion &) = delete;
@@ -78,6 +87,9 @@ public:
   }
 
   llvm::StringRef getDescription() const { return Description; }
+
+  AddressStreams &getAddressStreams() { return Addresses; }
+  const AddressStreams &getAddressStreams() const { return Addresses; }
 };
 
 class CodeRegions {
@@ -86,6 +98,18 @@ class CodeRegions {
 
   std::vector<std::unique_ptr<CodeRegion>> Regions;
 
+  // An address stream from an LLVM-MCA-ADDRESS comment, waiting for the
+  // instruction that follows it.
+  struct PendingAddressStream {
+    llvm::SMLoc Loc;
+    uint64_t Base;
+    int64_t Stride;
+  };
+
+  // The parser reads a comment before it emits the instruction that precedes
+  // it, so the streams are matched to the instructions by location.
+  llvm::SmallVector<PendingAddressStream, 2> PendingAddressStreams;
+
   // Construct a new region of code guarded by LLVM-MCA comments.
   void addRegion(llvm::StringRef Description, llvm::SMLoc Loc) {
     Regions.emplace_back(llvm::make_unique<CodeRegion>(Description, Loc));
@@ -106,6 +130,9 @@ public:
 
   void beginRegion(llvm::StringRef Description, llvm::SMLoc Loc);
   void endRegion(llvm::SMLoc Loc);
+  // Parse the operands of an LLVM-MCA-ADDRESS comment ("<base> [<stride>]"),
+  // and use them as the address stream of the next instruction.
+  void addAddressStream(llvm::StringRef Operands, llvm::SMLoc Loc);
   void addInstruction(std::unique_ptr<const llvm::MCInst> Instruction);
 
   CodeRegions(llvm::SourceMgr &S) : SM(S) {
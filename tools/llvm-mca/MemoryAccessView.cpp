@@ -0,0 +1,109 @@
+//===--------------------- MemoryAccessView.cpp -----------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file implements the MemoryAccessView API.
+///
+//===----------------------------------------------------------------------===//
+
+#include "MemoryAccessView.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/FormattedStream.h"
+
+namespace mca {
+
+using namespace llvm;
+
+MemoryAccessView::MemoryAccessView(const MCSubtargetInfo &sti,
+                                   MCInstPrinter &Printer, const SourceMgr &S,
+                                   unsigned NumLevels)
+    : STI(sti), MCIP(Printer), Source(S), NumCacheLevels(NumLevels) {
+  MemoryAccessEntry NullEntry = {0, 0, 0,
+                                 std::vector<unsigned>(NumLevels + 1, 0)};
+  Entries.assign(Source.size(), NullEntry);
+}
+
+void MemoryAccessView::onEvent(const HWInstructionEvent &Event) {
+  if (Event.Type != HWInstructionEvent::MemoryAccess)
+    return;
+
+  const CacheAccess &Access =
+      static_cast<const HWMemoryAccessEvent &>(Event).Access;
+  MemoryAccessEntry &Entry =
+      Entries[Event.IR.getSourceIndex() % Source.size()];
+  Entry.Accesses++;
+  Entry.ServicedBy[Access.Level]++;
+  if (!Access.IsStore) {
+    Entry.Loads++;
+    Entry.StallCycles += Access.StallCycles;
+  }
+}
+
+void MemoryAccessView::printView(raw_ostream &OS) const {
+  std::string Buffer;
+  raw_string_ostream TempStream(Buffer);
+  formatted_raw_ostream FOS(TempStream);
+
+  FOS << "\n\nMemory Access View:\n[0]: Accesses\n";
+  for (unsigned I = 0; I < NumCacheLevels; ++I)
+    FOS << '[' << I + 1 << "]: L" << I + 1 << " hits\n";
+  FOS << '[' << NumCacheLevels + 1 << "]: Memory accesses\n";
+  FOS << '[' << NumCacheLevels + 2 << "]: Average stall cycles per load\n\n";
+
+  const unsigned NumColumns = NumCacheLevels + 3;
+  for (unsigned I = 0; I < NumColumns; ++I) {
+    FOS.PadToColumn(6 + 7 * I);
+    FOS << '[' << I << ']';
+  }
+  FOS << '\n';
+
+  // Use a different string stream for the instruction.
+  std::string Instruction;
+  raw_string_ostream InstrStream(Instruction);
+
+  for (unsigned I = 0, E = Entries.size(); I < E; ++I) {
+    const MemoryAccessEntry &Entry = Entries[I];
+    FOS << I << '.';
+    FOS.PadToColumn(7);
+
+    if (!Entry.Accesses) {
+      for (unsigned Col = 0; Col < NumColumns; ++Col)
+        FOS << "-      ";
+    } else {
+      FOS << Entry.Accesses;
+      for (unsigned Col = 0; Col <= NumCacheLevels; ++Col) {
+        FOS.PadToColumn(14 + 7 * Col);
+        FOS << Entry.ServicedBy[Col];
+      }
+      FOS.PadToColumn(14 + 7 * (NumCacheLevels + 1));
+      if (Entry.Loads) {
+        double AverageStall = (double)Entry.StallCycles / Entry.Loads;
+        FOS << format("%.1f", floor((AverageStall * 10) + 0.5) / 10);
+      } else {
+        FOS << '-';
+      }
+      FOS.PadToColumn(14 + 7 * (NumCacheLevels + 2));
+    }
+
+    // Append the instruction info at the end of the line.
+    const MCInst &Inst = Source.getMCInstFromIndex(I);
+    MCIP.printInst(&Inst, InstrStream, "", STI);
+    InstrStream.flush();
+
+    // Consume any tabs or spaces at the beginning of the string.
+    StringRef Str(Instruction);
+    Str = Str.ltrim();
+    FOS << "   " << Str << '\n';
+    Instruction = "";
+  }
+
+  FOS.flush();
+  OS << TempStream.str();
+}
+} // namespace mca
@@ -0,0 +1,73 @@
+//===--------------------- MemoryAccessView.h -------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file implements the memory access view.
+///
+/// The memory access view reports, for every instruction in the input
+/// sequence, how many of its memory accesses were serviced by each level of
+/// the simulated cache hierarchy, and the average number of cycles that its
+/// loads were stalled on cache misses. It is only available when the cache
+/// model is enabled.
+///
+/// Example:
+///
+/// Memory Access View:
+/// [0]: Accesses
+/// [1]: L1 hits
+/// [2]: L2 hits
+/// [3]: Memory accesses
+/// [4]: Average stall cycles per load
+///
+///       [0]    [1]    [2]    [3]    [4]
+/// 0.     100    88     12     0      1.0       movl	(%rdi), %eax
+/// 1.     -      -      -      -      -         addl	%eax, %ecx
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TOOLS_LLVM_MCA_MEMORYACCESSVIEW_H
+#define LLVM_TOOLS_LLVM_MCA_MEMORYACCESSVIEW_H
+
+#include "View.h"
+#include "llvm/MC/MCInstPrinter.h"
+#include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/MCA/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+#include <vector>
+
+namespace mca {
+
+/// A view that collects and prints cache hit and miss statistics.
+class MemoryAccessView : public View {
+  const llvm::MCSubtargetInfo &STI;
+  llvm::MCInstPrinter &MCIP;
+  const SourceMgr &Source;
+  const unsigned NumCacheLevels;
+
+  struct MemoryAccessEntry {
+    unsigned Accesses;
+    unsigned Loads;
+    unsigned StallCycles;
+    // Number of accesses serviced by each cache level, followed by the
+    // number of accesses serviced by memory.
+    std::vector<unsigned> ServicedBy;
+  };
+  std::vector<MemoryAccessEntry> Entries;
+
+public:
+  MemoryAccessView(const llvm::MCSubtargetInfo &sti,
+                   llvm::MCInstPrinter &Printer, const SourceMgr &S,
+                   unsigned NumLevels);
+
+  void onEvent(const HWInstructionEvent &Event) override;
+  void printView(llvm::raw_ostream &OS) const override;
+};
+} // namespace mca
+
+#endif
@@ -14,8 +14,8 @@
 //===----------------------------------------------------------------------===//
 
 #include "SummaryView.h"
-#include "Support.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/MCA/Support.h"
 #include "llvm/Support/Format.h"
 
 namespace mca {
@@ -26,7 +26,7 @@ void TimelineView::initialize(unsigned MaxIterations) {
   unsigned NumEntries =
       std::min(NumInstructions, MaxIterations * AsmSequence.size());
   Timeline.resize(NumEntries);
-  TimelineViewEntry NullTVEntry = {0, 0, 0, 0, 0};
+  TimelineViewEntry NullTVEntry = {0, 0, 0, 0, 0, 0};
   std::fill(Timeline.begin(), Timeline.end(), NullTVEntry);
 
   WaitTime.resize(AsmSequence.size());
@@ -67,6 +67,10 @@ void TimelineView::onEvent(const HWInstructionEvent &Event) {
   case HWInstructionEvent::Dispatched:
     Timeline[Index].CycleDispatched = CurrentCycle;
     break;
+  case HWInstructionEvent::MemoryAccess:
+    Timeline[Index].MemoryStallCycles =
+        static_cast<const HWMemoryAccessEvent &>(Event).Access.StallCycles;
+    break;
   default:
     return;
   }
@@ -159,11 +163,17 @@ void TimelineView::printTimelineViewEntry(formatted_raw_ostream &OS,
     if (Entry.CycleIssued == Entry.CycleExecuted)
       OS << TimelineView::DisplayChar::DisplayChar::Executed;
     else {
+      // The cycles spent waiting for the cache hierarchy are displayed last.
+      unsigned FirstStallCycle =
+          Entry.CycleExecuted -
+          std::min(Entry.MemoryStallCycles,
+                   Entry.CycleExecuted - Entry.CycleIssued - 1);
       if (Entry.CycleDispatched != Entry.CycleIssued)
         OS << TimelineView::DisplayChar::Executing;
       for (unsigned I = Entry.CycleIssued + 1, E = Entry.CycleExecuted; I < E;
            ++I)
-        OS << TimelineView::DisplayChar::Executing;
+        OS << (I < FirstStallCycle ? TimelineView::DisplayChar::Executing
+                                   : TimelineView::DisplayChar::MemoryStall);
       OS << TimelineView::DisplayChar::Executed;
     }
   }
@@ -100,10 +100,10 @@
 #ifndef LLVM_TOOLS_LLVM_MCA_TIMELINEVIEW_H
 #define LLVM_TOOLS_LLVM_MCA_TIMELINEVIEW_H
 
-#include "SourceMgr.h"
 #include "View.h"
 #include "llvm/MC/MCInstPrinter.h"
 #include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/MCA/SourceMgr.h"
 #include "llvm/Support/FormattedStream.h"
 #include "llvm/Support/raw_ostream.h"
 #include <map>
@@ -132,6 +132,9 @@ class TimelineView : public View {
     unsigned CycleIssued;
     unsigned CycleExecuted;
     unsigned CycleRetired;
+    // Cycles spent waiting for the cache hierarchy (see CacheModel). These
+    // are the last cycles of execution.
+    unsigned MemoryStallCycles;
   };
   std::vector<TimelineViewEntry> Timeline;
 
@@ -160,6 +163,7 @@ class TimelineView : public View {
     static const char Retired = 'R';
     static const char Waiting = '='; // Instruction is waiting in the scheduler.
     static const char Executing = 'e';
+    static const char MemoryStall = 'm'; // Executing, but waiting for memory.
     static const char RetireLag = '-'; // The instruction is waiting to retire.
   };
 
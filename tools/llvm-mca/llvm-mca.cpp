@@ -22,12 +22,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "CodeRegion.h"
-#include "Context.h"
 #include "DispatchStatistics.h"
-#include "FetchStage.h"
 #include "InstructionInfoView.h"
-#include "InstructionTables.h"
-#include "Pipeline.h"
+#include "MemoryAccessView.h"
 #include "PipelinePrinter.h"
 #include "RegisterFileStatistics.h"
 #include "ResourcePressureView.h"
@@ -35,21 +32,28 @@
 #include "SchedulerStatistics.h"
 #include "SummaryView.h"
 #include "TimelineView.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/MC/MCAsmInfo.h"
 #include "llvm/MC/MCContext.h"
 #include "llvm/MC/MCObjectFileInfo.h"
 #include "llvm/MC/MCParser/MCTargetAsmParser.h"
 #include "llvm/MC/MCRegisterInfo.h"
 #include "llvm/MC/MCStreamer.h"
+#include "llvm/MCA/Context.h"
+#include "llvm/MCA/FetchStage.h"
+#include "llvm/MCA/InstructionTables.h"
+#include "llvm/MCA/Pipeline.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Host.h"
 #include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/WithColor.h"
 
@@ -57,6 +61,7 @@ using namespace llvm;
 
 static cl::OptionCategory ToolOptions("Tool Options");
 static cl::OptionCategory ViewOptions("View Options");
+static cl::OptionCategory CacheOptions("Cache Model Options");
 
 static cl::opt<std::string> InputFilename(cl::Positional,
                                           cl::desc("<input file>"),
@@ -90,6 +95,15 @@ static cl::opt<unsigned> Iterations("iterations",
                                     cl::desc("Number of iterations to run"),
                                     cl::cat(ToolOptions), cl::init(0));
 
+static cl::opt<unsigned>
+    NumThreads("num-threads",
+               cl::desc("Number of threads used to simulate code regions in "
+                        "parallel (0 = number of hardware threads)"),
+               cl::cat(ToolOptions), cl::init(0));
+
+static cl::alias NumThreadsA("j", cl::desc("Alias for --num-threads"),
+                             cl::aliasopt(NumThreads));
+
 static cl::opt<unsigned>
     DispatchWidth("dispatch", cl::desc("Override the processor dispatch width"),
                   cl::cat(ToolOptions), cl::init(0));
@@ -158,6 +172,85 @@ static cl::opt<unsigned>
                    cl::desc("Size of the store queue (unbound by default)"),
                    cl::cat(ToolOptions), cl::init(0));
 
+static cl::opt<bool>
+    EnableCacheModel("cache-model",
+                     cl::desc("Simulate the data cache hierarchy. Memory "
+                              "addresses are taken from LLVM-MCA-ADDRESS "
+                              "comments and from the memory trace"),
+                     cl::cat(CacheOptions), cl::init(false));
+
+static cl::opt<std::string>
+    MemoryTraceFilename("memory-trace",
+                        cl::desc("File with the addresses accessed by memory "
+                                 "operations, one '<index> <address>' pair "
+                                 "per line"),
+                        cl::value_desc("filename"), cl::cat(CacheOptions));
+
+static cl::opt<unsigned> L1DSize("l1d-size",
+                                 cl::desc("Size of the L1 data cache in bytes "
+                                          "(default 32KB)"),
+                                 cl::cat(CacheOptions), cl::init(32 * 1024));
+
+static cl::opt<unsigned> L1DAssoc("l1d-assoc",
+                                  cl::desc("Associativity of the L1 data cache "
+                                           "(default 8)"),
+                                  cl::cat(CacheOptions), cl::init(8));
+
+static cl::opt<unsigned>
+    L1DLatency("l1d-latency",
+               cl::desc("Load-to-use latency of the L1 data cache (default 4). "
+                        "Latencies from the scheduling model are assumed to "
+                        "be L1 hits"),
+               cl::cat(CacheOptions), cl::init(4));
+
+static cl::opt<unsigned> L2Size("l2-size",
+                                cl::desc("Size of the L2 cache in bytes "
+                                         "(default 256KB, 0 = no L2 cache)"),
+                                cl::cat(CacheOptions), cl::init(256 * 1024));
+
+static cl::opt<unsigned> L2Assoc("l2-assoc",
+                                 cl::desc("Associativity of the L2 cache "
+                                          "(default 8)"),
+                                 cl::cat(CacheOptions), cl::init(8));
+
+static cl::opt<unsigned>
+    L2Latency("l2-latency",
+              cl::desc("Load-to-use latency of the L2 cache (default 12)"),
+              cl::cat(CacheOptions), cl::init(12));
+
+static cl::opt<unsigned> L3Size("l3-size",
+                                cl::desc("Size of the L3 cache in bytes "
+                                         "(default 8MB, 0 = no L3 cache)"),
+                                cl::cat(CacheOptions),
+                                cl::init(8 * 1024 * 1024));
+
+static cl::opt<unsigned> L3Assoc("l3-assoc",
+                                 cl::desc("Associativity of the L3 cache "
+                                          "(default 16)"),
+                                 cl::cat(CacheOptions), cl::init(16));
+
+static cl::opt<unsigned>
+    L3Latency("l3-latency",
+              cl::desc("Load-to-use latency of the L3 cache (default 40)"),
+              cl::cat(CacheOptions), cl::init(40));
+
+static cl::opt<unsigned>
+    CacheLineSize("cache-line-size",
+                  cl::desc("Size of a cache line in bytes (default 64)"),
+                  cl::cat(CacheOptions), cl::init(64));
+
+static cl::opt<unsigned>
+    MemoryLatency("memory-latency",
+                  cl::desc("Load-to-use latency of a load that misses every "
+                           "cache level (default 200)"),
+                  cl::cat(CacheOptions), cl::init(200));
+
+static cl::opt<unsigned>
+    PrefetchDegree("prefetch-degree",
+                   cl::desc("Number of lines fetched by the next-line "
+                            "prefetcher on an L1 miss (0 = no prefetcher)"),
+                   cl::cat(CacheOptions), cl::init(0));
+
 static cl::opt<bool>
     PrintInstructionTables("instruction-tables",
                            cl::desc("Print instruction tables"),
@@ -168,6 +261,12 @@ static cl::opt<bool> PrintInstructionInfoView(
     cl::desc("Print the instruction info view (enabled by default)"),
     cl::cat(ViewOptions), cl::init(true));
 
+static cl::opt<bool> PrintMemoryAccessView(
+    "memory-view",
+    cl::desc("Print the memory access view (enabled by default with "
+             "-cache-model)"),
+    cl::cat(ViewOptions), cl::init(true));
+
 static cl::opt<bool> EnableAllStats("all-stats",
                                     cl::desc("Print all hardware statistics"),
                                     cl::cat(ViewOptions), cl::init(false));
@@ -218,6 +317,11 @@ public:
       return;
 
     Comment = Comment.drop_front(Position);
+    if (Comment.consume_front("LLVM-MCA-ADDRESS")) {
+      Regions.addAddressStream(Comment, Loc);
+      return;
+    }
+
     if (Comment.consume_front("LLVM-MCA-END")) {
       Regions.endRegion(Loc);
       return;
@@ -262,6 +366,41 @@ ErrorOr<std::unique_ptr<ToolOutputFile>> getOutputStream() {
   return EC;
 }
 
+// Parse the memory trace in Filename. Each line is made of the index of an
+// instruction in its code region, followed by an address accessed by that
+// instruction. Addresses listed for the same instruction are used on
+// successive iterations. Empty lines and lines starting with '#' are ignored.
+int ParseMemoryTrace(StringRef Filename,
+                     std::vector<std::pair<unsigned, uint64_t>> &Trace) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufferPtr =
+      MemoryBuffer::getFileOrSTDIN(Filename);
+  if (std::error_code EC = BufferPtr.getError()) {
+    WithColor::error() << Filename << ": " << EC.message() << '\n';
+    return 1;
+  }
+
+  SmallVector<StringRef, 16> Lines;
+  (*BufferPtr)->getBuffer().split(Lines, '\n');
+  for (unsigned LineNo = 0, E = Lines.size(); LineNo < E; ++LineNo) {
+    StringRef Line = Lines[LineNo].trim();
+    if (Line.empty() || Line.startswith("#"))
+      continue;
+
+    SmallVector<StringRef, 2> Tokens;
+    SplitString(Line, Tokens);
+    unsigned Index;
+    uint64_t Address;
+    if (Tokens.size() != 2 || Tokens[0].getAsInteger(10, Index) ||
+        Tokens[1].getAsInteger(0, Address)) {
+      WithColor::error() << Filename << ':' << LineNo + 1
+                         << ": invalid memory trace entry '" << Line << "'\n";
+      return 1;
+    }
+    Trace.emplace_back(Index, Address);
+  }
+  return 0;
+}
+
 class MCStreamerWrapper final : public MCStreamer {
   mca::CodeRegions &Regions;
 
@@ -336,7 +475,7 @@ int main(int argc, char **argv) {
   // Enable printing of available targets when flag --version is specified.
   cl::AddExtraVersionPrinter(TargetRegistry::printRegisteredTargetsForVersion);
 
-  cl::HideUnrelatedOptions({&ToolOptions, &ViewOptions});
+  cl::HideUnrelatedOptions({&ToolOptions, &ViewOptions, &CacheOptions});
 
   // Parse flags and initialize target options.
   cl::ParseCommandLineOptions(argc, argv,
@@ -432,6 +571,28 @@ int main(int argc, char **argv) {
     return 1;
   }
 
+  mca::MemoryHierarchyDesc MemoryHierarchy;
+  std::vector<std::pair<unsigned, uint64_t>> MemoryTrace;
+  if (EnableCacheModel && !PrintInstructionTables) {
+    if (!isPowerOf2_32(CacheLineSize)) {
+      WithColor::error() << "the cache line size must be a power of two.\n";
+      return 1;
+    }
+
+    MemoryHierarchy.Levels.push_back({L1DSize, L1DAssoc, L1DLatency});
+    if (L2Size)
+      MemoryHierarchy.Levels.push_back({L2Size, L2Assoc, L2Latency});
+    if (L3Size)
+      MemoryHierarchy.Levels.push_back({L3Size, L3Assoc, L3Latency});
+    MemoryHierarchy.LineSize = CacheLineSize;
+    MemoryHierarchy.MemoryLatency = MemoryLatency;
+    MemoryHierarchy.PrefetchDegree = PrefetchDegree;
+
+    if (!MemoryTraceFilename.empty() &&
+        ParseMemoryTrace(MemoryTraceFilename, MemoryTrace))
+      return 1;
+  }
+
   // Now initialize the output file.
   auto OF = getOutputStream();
   if (std::error_code EC = OF.getError()) {
@@ -442,9 +603,11 @@ int main(int argc, char **argv) {
   unsigned AssemblerDialect = P->getAssemblerDialect();
   if (OutputAsmVariant >= 0)
     AssemblerDialect = static_cast<unsigned>(OutputAsmVariant);
-  std::unique_ptr<MCInstPrinter> IP(TheTarget->createMCInstPrinter(
-      Triple(TripleName), AssemblerDialect, *MAI, *MCII, *MRI));
-  if (!IP) {
+  auto CreateInstPrinter = [&]() {
+    return std::unique_ptr<MCInstPrinter>(TheTarget->createMCInstPrinter(
+        Triple(TripleName), AssemblerDialect, *MAI, *MCII, *MRI));
+  };
+  if (!CreateInstPrinter()) {
     WithColor::error()
         << "unable to create instruction printer for target triple '"
         << TheTriple.normalize() << "' with assembly variant "
@@ -460,33 +623,47 @@ int main(int argc, char **argv) {
   if (DispatchWidth)
     Width = DispatchWidth;
 
-  // Create an instruction builder.
-  mca::InstrBuilder IB(*STI, *MCII, *MRI, *MCIA, *IP);
-
-  // Create a context to control ownership of the pipeline hardware.
-  mca::Context MCA(*MRI, *STI);
-
   mca::PipelineOptions PO(Width, RegisterFileSize, LoadQueueSize,
                           StoreQueueSize, AssumeNoAlias);
 
-  // Number each region in the sequence.
+  // Collect the non-empty regions, and number the ones that print a header.
+  std::vector<std::pair<const mca::CodeRegion *, int>> RegionsToSimulate;
   unsigned RegionIdx = 0;
   for (const std::unique_ptr<mca::CodeRegion> &Region : Regions) {
-    // Skip empty code regions.
     if (Region->empty())
       continue;
 
     // Don't print the header of this region if it is the default region, and
     // it doesn't have an end location.
-    if (Region->startLoc().isValid() || Region->endLoc().isValid()) {
-      TOF->os() << "\n[" << RegionIdx++ << "] Code Region";
-      StringRef Desc = Region->getDescription();
+    int HeaderIdx = -1;
+    if (Region->startLoc().isValid() || Region->endLoc().isValid())
+      HeaderIdx = RegionIdx++;
+    RegionsToSimulate.push_back(std::make_pair(Region.get(), HeaderIdx));
+  }
+
+  // Regions are simulated independently, each with its own instruction
+  // builder, hardware, and printer, and each writes its report to its own
+  // buffer. The reports are emitted in region order once every region is
+  // done.
+  std::vector<std::string> Reports(RegionsToSimulate.size());
+  auto SimulateRegion = [&](unsigned I) {
+    const mca::CodeRegion &Region = *RegionsToSimulate[I].first;
+    raw_string_ostream OS(Reports[I]);
+
+    if (RegionsToSimulate[I].second >= 0) {
+      OS << "\n[" << RegionsToSimulate[I].second << "] Code Region";
+      StringRef Desc = Region.getDescription();
       if (!Desc.empty())
-        TOF->os() << " - " << Desc;
-      TOF->os() << "\n\n";
+        OS << " - " << Desc;
+      OS << "\n\n";
     }
 
-    mca::SourceMgr S(Region->getInstructions(),
+    std::unique_ptr<MCInstPrinter> IP = CreateInstPrinter();
+
+    // Create an instruction builder.
+    mca::InstrBuilder IB(*STI, *MCII, *MRI, *MCIA, *IP);
+
+    mca::SourceMgr S(Region.getInstructions(),
                      PrintInstructionTables ? 1 : Iterations);
 
     if (PrintInstructionTables) {
@@ -504,12 +681,26 @@ int main(int argc, char **argv) {
       Printer.addView(
           llvm::make_unique<mca::ResourcePressureView>(*STI, *IP, S));
       P->run();
-      Printer.printReport(TOF->os());
-      continue;
+      Printer.printReport(OS);
+      return;
+    }
+
+    // Combine the address annotations of this region with the memory trace.
+    mca::PipelineOptions RegionPO = PO;
+    mca::AddressStreams Addresses = Region.getAddressStreams();
+    if (EnableCacheModel) {
+      for (const std::pair<unsigned, uint64_t> &Entry : MemoryTrace)
+        if (Entry.first < S.size())
+          Addresses.appendTraceAddress(Entry.first, Entry.second);
+      RegionPO.MemoryHierarchy = &MemoryHierarchy;
+      RegionPO.MemoryAddresses = &Addresses;
     }
 
+    // Create a context to control ownership of the pipeline hardware.
+    mca::Context MCA(*MRI, *STI);
+
     // Create a basic pipeline simulating an out-of-order backend.
-    auto P = MCA.createDefaultPipeline(PO, IB, S);
+    auto P = MCA.createDefaultPipeline(RegionPO, IB, S);
     mca::PipelinePrinter Printer(*P);
 
     if (PrintSummaryView)
@@ -535,18 +726,35 @@ int main(int argc, char **argv) {
       Printer.addView(
           llvm::make_unique<mca::ResourcePressureView>(*STI, *IP, S));
 
+    if (EnableCacheModel && PrintMemoryAccessView)
+      Printer.addView(llvm::make_unique<mca::MemoryAccessView>(
+          *STI, *IP, S, MemoryHierarchy.Levels.size()));
+
     if (PrintTimelineView) {
       Printer.addView(llvm::make_unique<mca::TimelineView>(
           *STI, *IP, S, TimelineMaxIterations, TimelineMaxCycles));
     }
 
     P->run();
-    Printer.printReport(TOF->os());
-
-    // Clear the InstrBuilder internal state in preparation for another round.
-    IB.clear();
+    Printer.printReport(OS);
+  };
+
+  unsigned Threads =
+      NumThreads ? NumThreads : std::thread::hardware_concurrency();
+  Threads = std::min<size_t>(std::max(Threads, 1U), RegionsToSimulate.size());
+  if (Threads <= 1) {
+    for (unsigned I = 0, E = RegionsToSimulate.size(); I != E; ++I)
+      SimulateRegion(I);
+  } else {
+    ThreadPool Pool(Threads);
+    for (unsigned I = 0, E = RegionsToSimulate.size(); I != E; ++I)
+      Pool.async(SimulateRegion, I);
+    Pool.wait();
   }
 
+  for (const std::string &Report : Reports)
+    TOF->os() << Report;
+
   TOF->keep();
   return 0;
 }
@@ -25,6 +25,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/WithColor.h"
@@ -160,8 +161,10 @@ static bool isFatalError(instrprof_error IPE) {
   }
 }
 
-/// Load an input into a writer context.
-static void loadInput(const WeightedFile &Input, WriterContext *WC) {
+/// Load an input into a writer context. If \p NumShards is greater than one,
+/// only the records of the functions whose name hashes to \p Shard are kept.
+static void loadInput(const WeightedFile &Input, WriterContext *WC,
+                      unsigned Shard, unsigned NumShards) {
   std::unique_lock<std::mutex> CtxGuard{WC->Lock};
 
   // If there's a pending hard error, don't do more work.
@@ -193,6 +196,8 @@ static void loadInput(const WeightedFile &Input, WriterContext *WC) {
 
   for (auto &I : *Reader) {
     const StringRef FuncName = I.Name;
+    if (NumShards > 1 && MD5Hash(FuncName) % NumShards != Shard)
+      continue;
     bool Reported = false;
     WC->Writer.addRecord(std::move(I), Input.Weight, [&](Error E) {
       if (Reported) {
@@ -235,10 +240,41 @@ static void mergeWriterContexts(WriterContext *Dst, WriterContext *Src) {
   });
 }
 
+/// Load all the inputs into \p Contexts, one shard per context. Each context
+/// reads every input but only keeps the functions of its own shard, so the
+/// contexts hold disjoint sets of functions and the merged profile is only
+/// held in memory once.
+static void loadShardedInputs(
+    const WeightedFileVector &Inputs,
+    SmallVectorImpl<std::unique_ptr<WriterContext>> &Contexts) {
+  for (const auto &Input : Inputs)
+    if (Input.Filename == "-")
+      exitWithError("Cannot read from stdin in sharded merge mode.");
+
+  const unsigned NumShards = Contexts.size();
+  ThreadPool Pool(NumShards);
+  for (unsigned Shard = 0; Shard < NumShards; ++Shard) {
+    WriterContext *WC = Contexts[Shard].get();
+    Pool.async([&Inputs, WC, Shard, NumShards]() {
+      for (const auto &Input : Inputs)
+        loadInput(Input, WC, Shard, NumShards);
+    });
+  }
+  Pool.wait();
+
+  // The shards are disjoint, so this only moves records into the first
+  // context. Release each shard as soon as it is merged.
+  for (unsigned Shard = 1; Shard < NumShards; ++Shard) {
+    mergeWriterContexts(Contexts[0].get(), Contexts[Shard].get());
+    if (!Contexts[Shard]->Err)
+      Contexts[Shard].reset();
+  }
+}
+
 static void mergeInstrProfile(const WeightedFileVector &Inputs,
                               StringRef OutputFilename,
                               ProfileFormat OutputFormat, bool OutputSparse,
-                              unsigned NumThreads) {
+                              unsigned NumThreads, bool Sharded) {
   if (OutputFilename.compare("-") == 0)
     exitWithError("Cannot write indexed profdata format to stdout.");
 
@@ -254,10 +290,13 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
   std::mutex ErrorLock;
   SmallSet<instrprof_error, 4> WriterErrorCodes;
 
-  // If NumThreads is not specified, auto-detect a good default.
+  // If NumThreads is not specified, auto-detect a good default. In sharded
+  // mode every thread reads all the inputs, so the number of inputs doesn't
+  // bound the parallelism.
   if (NumThreads == 0)
-    NumThreads =
-        std::min(hardware_concurrency(), unsigned((Inputs.size() + 1) / 2));
+    NumThreads = Sharded ? hardware_concurrency()
+                         : std::min(hardware_concurrency(),
+                                    unsigned((Inputs.size() + 1) / 2));
 
   // Initialize the writer contexts.
   SmallVector<std::unique_ptr<WriterContext>, 4> Contexts;
@@ -267,14 +306,16 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
 
   if (NumThreads == 1) {
     for (const auto &Input : Inputs)
-      loadInput(Input, Contexts[0].get());
+      loadInput(Input, Contexts[0].get(), 0, 1);
+  } else if (Sharded) {
+    loadShardedInputs(Inputs, Contexts);
   } else {
     ThreadPool Pool(NumThreads);
 
     // Load the inputs in parallel (N/NumThreads serial steps).
     unsigned Ctx = 0;
     for (const auto &Input : Inputs) {
-      Pool.async(loadInput, Input, Contexts[Ctx].get());
+      Pool.async(loadInput, Input, Contexts[Ctx].get(), 0, 1);
       Ctx = (Ctx + 1) % NumThreads;
     }
     Pool.wait();
@@ -300,7 +341,7 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
 
   // Handle deferred hard errors encountered during merging.
   for (std::unique_ptr<WriterContext> &WC : Contexts) {
-    if (!WC->Err)
+    if (!WC || !WC->Err)
       continue;
     if (!WC->Err.isA<InstrProfError>())
       exitWithError(std::move(WC->Err), WC->ErrWhence);
@@ -485,6 +526,11 @@ static int merge_main(int argc, const char *argv[]) {
       cl::desc("Number of merge threads to use (default: autodetect)"));
   cl::alias NumThreadsA("j", cl::desc("Alias for --num-threads"),
                         cl::aliasopt(NumThreads));
+  cl::opt<bool> Sharded(
+      "sharded", cl::init(false),
+      cl::desc("Partition functions across the merge threads by name hash, "
+               "so that the merged profile is only held in memory once "
+               "(only meaningful for -instr)"));
 
   cl::ParseCommandLineOptions(argc, argv, "LLVM profile data merger\n");
 
@@ -511,7 +557,7 @@ static int merge_main(int argc, const char *argv[]) {
 
   if (ProfileKind == instr)
     mergeInstrProfile(WeightedInputs, OutputFilename, OutputFormat,
-                      OutputSparse, NumThreads);
+                      OutputSparse, NumThreads, Sharded);
   else
     mergeSampleProfile(WeightedInputs, OutputFilename, OutputFormat);
 
@@ -15,6 +15,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/DebugInfo/Symbolize/DIPrinter.h"
 #include "llvm/DebugInfo/Symbolize/Symbolize.h"
@@ -23,10 +24,15 @@
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cstdio>
 #include <cstring>
+#include <mutex>
 #include <string>
 
 using namespace llvm;
@@ -90,10 +96,37 @@ static cl::opt<int> ClPrintSourceContextLines(
 static cl::opt<bool> ClVerbose("verbose", cl::init(false),
                                cl::desc("Print verbose line info"));
 
+static cl::opt<std::string> ClBatchFile(
+    "batch", cl::init(""),
+    cl::desc("Symbolize the entries of a JSON lines file, in parallel, "
+             "instead of reading commands from stdin. Each line is an object "
+             "such as {\"module\": \"a.out\", \"offset\": \"0x1234\", "
+             "\"kind\": \"code\"}"));
+
+static cl::opt<unsigned> ClNumThreads(
+    "num-threads", cl::init(0),
+    cl::desc("Number of threads used to symbolize a batch file (default: "
+             "autodetect)"));
+static cl::alias ClNumThreadsA("j", cl::desc("Alias for --num-threads"),
+                               cl::aliasopt(ClNumThreads));
+
+static cl::opt<unsigned> ClMaxCacheSize(
+    "max-cache-size", cl::init(0),
+    cl::desc("Maximum size, in MiB, of the debug info kept loaded. Least "
+             "recently used modules are unloaded beyond it (0 = no limit)"));
+
+static cl::opt<unsigned> ClMaxCacheSizeBytes(
+    "max-cache-size-bytes", cl::Hidden,
+    cl::desc("Like -max-cache-size, in bytes. For testing"));
+
+// Serializes error reporting from the threads of a batch.
+static std::mutex ErrorLock;
+
 template<typename T>
 static bool error(Expected<T> &ResOrErr) {
   if (ResOrErr)
     return false;
+  std::lock_guard<std::mutex> ErrorGuard(ErrorLock);
   logAllUnhandledErrors(ResOrErr.takeError(), errs(),
                         "LLVMSymbolizer: error reading file: ");
   return true;
@@ -137,6 +170,128 @@ static bool parseCommand(StringRef InputString, bool &IsData,
   return !StringRef(pos, offset_length).getAsInteger(0, ModuleOffset);
 }
 
+// Symbolizes one address, and prints the result to \p OS.
+static void symbolizeInput(LLVMSymbolizer &Symbolizer, raw_ostream &OS,
+                           bool IsData, const std::string &ModuleName,
+                           uint64_t ModuleOffset) {
+  DIPrinter Printer(OS, ClPrintFunctions != FunctionNameKind::None,
+                    ClPrettyPrint, ClPrintSourceContextLines, ClVerbose);
+
+  if (ClPrintAddress) {
+    OS << "0x";
+    OS.write_hex(ModuleOffset);
+    StringRef Delimiter = ClPrettyPrint ? ": " : "\n";
+    OS << Delimiter;
+  }
+  if (IsData) {
+    auto ResOrErr = Symbolizer.symbolizeData(ModuleName, ModuleOffset);
+    Printer << (error(ResOrErr) ? DIGlobal() : ResOrErr.get());
+  } else if (ClPrintInlining) {
+    auto ResOrErr =
+        Symbolizer.symbolizeInlinedCode(ModuleName, ModuleOffset, ClDwpName);
+    Printer << (error(ResOrErr) ? DIInliningInfo()
+                                           : ResOrErr.get());
+  } else {
+    auto ResOrErr =
+        Symbolizer.symbolizeCode(ModuleName, ModuleOffset, ClDwpName);
+    Printer << (error(ResOrErr) ? DILineInfo() : ResOrErr.get());
+  }
+  OS << "\n";
+}
+
+// Parses an entry of a batch file, e.g.
+//   {"module": "a.out", "offset": "0x1234", "kind": "code"}
+// The offset may also be given as a number, and "kind" defaults to "code".
+static bool parseBatchEntry(StringRef Line, bool &IsData,
+                            std::string &ModuleName, uint64_t &ModuleOffset) {
+  Expected<json::Value> ValueOrErr = json::parse(Line);
+  if (!ValueOrErr) {
+    consumeError(ValueOrErr.takeError());
+    return false;
+  }
+  const json::Object *Entry = ValueOrErr->getAsObject();
+  if (!Entry)
+    return false;
+
+  if (Optional<StringRef> Module = Entry->getString("module"))
+    ModuleName = *Module;
+  else if (!ClBinaryName.empty())
+    ModuleName = ClBinaryName;
+  else
+    return false;
+
+  if (Optional<int64_t> Offset = Entry->getInteger("offset"))
+    ModuleOffset = *Offset;
+  else if (Optional<StringRef> Offset = Entry->getString("offset")) {
+    if (Offset->getAsInteger(0, ModuleOffset))
+      return false;
+  } else
+    return false;
+
+  IsData = false;
+  if (Optional<StringRef> Kind = Entry->getString("kind")) {
+    if (*Kind == "data")
+      IsData = true;
+    else if (*Kind != "code")
+      return false;
+  }
+  return true;
+}
+
+// Symbolizes all the entries of a batch file. The entries are grouped by
+// module, and each module is symbolized by a single thread, so that its debug
+// info is loaded once and queried without contention. Results are printed in
+// the order of the input.
+static void symbolizeBatch(LLVMSymbolizer &Symbolizer, StringRef Filename) {
+  auto BufOrErr = MemoryBuffer::getFileOrSTDIN(Filename);
+  if (!BufOrErr) {
+    errs() << "LLVMSymbolizer: error reading file: " << Filename << ": "
+           << BufOrErr.getError().message() << "\n";
+    exit(1);
+  }
+
+  SmallVector<StringRef, 0> Lines;
+  (*BufOrErr)->getBuffer().split(Lines, '\n');
+  if (!Lines.empty() && Lines.back().empty())
+    Lines.pop_back();
+
+  struct Entry {
+    bool IsData;
+    std::string ModuleName;
+    uint64_t ModuleOffset;
+  };
+  std::vector<Entry> Entries(Lines.size());
+  std::vector<std::string> Results(Lines.size());
+  StringMap<std::vector<size_t>> EntriesPerModule;
+  for (size_t I = 0, E = Lines.size(); I != E; ++I) {
+    Entry &Ent = Entries[I];
+    StringRef Line = Lines[I].rtrim("\r");
+    if (!parseBatchEntry(Line, Ent.IsData, Ent.ModuleName, Ent.ModuleOffset)) {
+      Results[I] = (Line + "\n").str();
+      continue;
+    }
+    EntriesPerModule[Ent.ModuleName].push_back(I);
+  }
+
+  {
+    ThreadPool Pool(ClNumThreads ? ClNumThreads : hardware_concurrency());
+    for (const auto &ModuleAndEntries : EntriesPerModule) {
+      const std::vector<size_t> &Indices = ModuleAndEntries.second;
+      Pool.async([&Symbolizer, &Entries, &Results, &Indices]() {
+        for (size_t I : Indices) {
+          raw_string_ostream OS(Results[I]);
+          symbolizeInput(Symbolizer, OS, Entries[I].IsData,
+                         Entries[I].ModuleName, Entries[I].ModuleOffset);
+        }
+      });
+    }
+    Pool.wait();
+  }
+
+  for (const std::string &Result : Results)
+    outs() << Result;
+}
+
 int main(int argc, char **argv) {
   InitLLVM X(argc, argv);
 
@@ -145,6 +300,9 @@ int main(int argc, char **argv) {
   cl::ParseCommandLineOptions(argc, argv, "llvm-symbolizer\n");
   LLVMSymbolizer::Options Opts(ClPrintFunctions, ClUseSymbolTable, ClDemangle,
                                ClUseRelativeAddress, ClDefaultArch);
+  Opts.MaxCacheSize = uint64_t(ClMaxCacheSize) << 20;
+  if (ClMaxCacheSizeBytes.getNumOccurrences())
+    Opts.MaxCacheSize = ClMaxCacheSizeBytes;
 
   for (const auto &hint : ClDsymHint) {
     if (sys::path::extension(hint) == ".dSYM") {
@@ -156,8 +314,10 @@ int main(int argc, char **argv) {
   }
   LLVMSymbolizer Symbolizer(Opts);
 
-  DIPrinter Printer(outs(), ClPrintFunctions != FunctionNameKind::None,
-                    ClPrettyPrint, ClPrintSourceContextLines, ClVerbose);
+  if (!ClBatchFile.empty()) {
+    symbolizeBatch(Symbolizer, ClBatchFile);
+    return 0;
+  }
 
   const int kMaxInputStringLength = 1024;
   char InputString[kMaxInputStringLength];
@@ -175,26 +335,7 @@ int main(int argc, char **argv) {
       continue;
     }
 
-    if (ClPrintAddress) {
-      outs() << "0x";
-      outs().write_hex(ModuleOffset);
-      StringRef Delimiter = ClPrettyPrint ? ": " : "\n";
-      outs() << Delimiter;
-    }
-    if (IsData) {
-      auto ResOrErr = Symbolizer.symbolizeData(ModuleName, ModuleOffset);
-      Printer << (error(ResOrErr) ? DIGlobal() : ResOrErr.get());
-    } else if (ClPrintInlining) {
-      auto ResOrErr =
-          Symbolizer.symbolizeInlinedCode(ModuleName, ModuleOffset, ClDwpName);
-      Printer << (error(ResOrErr) ? DIInliningInfo()
-                                             : ResOrErr.get());
-    } else {
-      auto ResOrErr =
-          Symbolizer.symbolizeCode(ModuleName, ModuleOffset, ClDwpName);
-      Printer << (error(ResOrErr) ? DILineInfo() : ResOrErr.get());
-    }
-    outs() << "\n";
+    symbolizeInput(Symbolizer, outs(), IsData, ModuleName, ModuleOffset);
     outs().flush();
   }
 
@@ -0,0 +1,81 @@
+//===--- ThreadSafeModuleTest.cpp - Test basic use of ThreadSafeModule ----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+TEST(ThreadSafeModuleTest, ContextWhollyOwnedByOneModule) {
+  // Test that ownership of a context can be transferred to a single
+  // ThreadSafeModule.
+  auto Ctx = llvm::make_unique<LLVMContext>();
+  auto M = llvm::make_unique<Module>("M", *Ctx);
+  ThreadSafeModule TSM(std::move(M), std::move(Ctx));
+  EXPECT_TRUE(!!TSM) << "Expected a non-null module";
+}
+
+TEST(ThreadSafeModuleTest, ContextOwnershipSharedByTwoModules) {
+  // Test that ownership of a context can be shared between more than one
+  // ThreadSafeModule, and that the context outlives the module that was
+  // destroyed first.
+  ThreadSafeContext TSCtx(llvm::make_unique<LLVMContext>());
+
+  auto M1 = llvm::make_unique<Module>("M1", *TSCtx.getContext());
+  ThreadSafeModule TSM1(std::move(M1), TSCtx);
+
+  {
+    auto M2 = llvm::make_unique<Module>("M2", *TSCtx.getContext());
+    ThreadSafeModule TSM2(std::move(M2), TSCtx);
+  }
+
+  EXPECT_EQ(TSM1.getModule()->getName(), "M1");
+}
+
+TEST(ThreadSafeModuleTest, ModuleOutlivesContextHandle) {
+  // Test that a ThreadSafeModule keeps its context alive after all other
+  // handles to the context have been destroyed.
+  ThreadSafeModule TSM;
+  {
+    ThreadSafeContext TSCtx(llvm::make_unique<LLVMContext>());
+    auto M = llvm::make_unique<Module>("M", *TSCtx.getContext());
+    TSM = ThreadSafeModule(std::move(M), TSCtx);
+  }
+  EXPECT_EQ(&TSM.getModule()->getContext(), TSM.getContext().getContext());
+}
+
+TEST(ThreadSafeModuleTest, ContextLockSerializesAccess) {
+  // Test that a second thread can not acquire the context lock while the
+  // first thread holds it.
+  ThreadSafeContext TSCtx(llvm::make_unique<LLVMContext>());
+  std::atomic<bool> SecondThreadHasLock(false);
+
+  std::future<void> SecondThread;
+  {
+    auto Lock = TSCtx.getLock();
+    SecondThread = std::async(std::launch::async, [&]() {
+      auto Lock = TSCtx.getLock();
+      SecondThreadHasLock = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_FALSE(SecondThreadHasLock)
+        << "Context lock acquired by two threads at once";
+  }
+  SecondThread.wait();
+  EXPECT_TRUE(SecondThreadHasLock);
+}
+
+} // end anonymous namespace
@@ -0,0 +1,130 @@
+//===- llvm/unittest/MCA/X86/SimulatorTest.cpp ----------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MCA/Simulator.h"
+#include "MCTargetDesc/X86MCTargetDesc.h"
+#include "llvm/MC/MCAsmInfo.h"
+#include "llvm/MC/MCInstBuilder.h"
+#include "llvm/MC/MCInstPrinter.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+#include "llvm/MC/MCInstrInfo.h"
+#include "llvm/MC/MCRegisterInfo.h"
+#include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/TargetSelect.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+constexpr const char Triple[] = "x86_64-unknown-unknown";
+
+class SimulatorTest : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+    LLVMInitializeX86TargetInfo();
+    LLVMInitializeX86TargetMC();
+  }
+
+  void SetUp() override {
+    std::string Error;
+    const Target *TheTarget = TargetRegistry::lookupTarget(Triple, Error);
+    ASSERT_NE(TheTarget, nullptr) << Error;
+    MRI.reset(TheTarget->createMCRegInfo(Triple));
+    MAI.reset(TheTarget->createMCAsmInfo(*MRI, Triple));
+    MCII.reset(TheTarget->createMCInstrInfo());
+    MCIA.reset(TheTarget->createMCInstrAnalysis(MCII.get()));
+    STI.reset(TheTarget->createMCSubtargetInfo(Triple, "btver2", ""));
+    MCIP.reset(TheTarget->createMCInstPrinter(llvm::Triple(Triple), 0, *MAI,
+                                              *MCII, *MRI));
+    ASSERT_TRUE(MRI && MAI && MCII && MCIA && STI && MCIP);
+  }
+
+  // Returns the index in SimulationResult::ResourcePressure of the first unit
+  // of the processor resource called Name.
+  unsigned getResourceIndex(StringRef Name) const {
+    const MCSchedModel &SM = STI->getSchedModel();
+    unsigned Index = 0;
+    for (unsigned I = 0, E = SM.getNumProcResourceKinds(); I < E; ++I) {
+      const MCProcResourceDesc &ProcResource = *SM.getProcResource(I);
+      if (ProcResource.SubUnitsIdxBegin || !ProcResource.NumUnits)
+        continue;
+      if (Name == ProcResource.Name)
+        return Index;
+      Index += ProcResource.NumUnits;
+    }
+    ADD_FAILURE() << "No processor resource " << Name.str();
+    return 0;
+  }
+
+  std::unique_ptr<MCRegisterInfo> MRI;
+  std::unique_ptr<MCAsmInfo> MAI;
+  std::unique_ptr<MCInstrInfo> MCII;
+  std::unique_ptr<MCInstrAnalysis> MCIA;
+  std::unique_ptr<MCSubtargetInfo> STI;
+  std::unique_ptr<MCInstPrinter> MCIP;
+};
+
+TEST_F(SimulatorTest, DependencyChains) {
+  // addl %eax, %eax
+  // imull %ecx, %ecx
+  MCInst Insts[] = {
+      MCInstBuilder(X86::ADD32rr).addReg(X86::EAX).addReg(X86::EAX).addReg(
+          X86::EAX),
+      MCInstBuilder(X86::IMUL32rr).addReg(X86::ECX).addReg(X86::ECX).addReg(
+          X86::ECX)};
+  mca::PipelineOptions Opts(/*DW=*/0, /*RFS=*/0, /*LQS=*/0, /*SQS=*/0,
+                            /*NoAlias=*/false);
+  mca::Simulator Sim(*STI, *MCII, *MRI, *MCIA, *MCIP, Opts);
+
+  mca::SimulationResult Result = Sim.run(Insts, 100);
+  EXPECT_EQ(100U, Result.Iterations);
+  EXPECT_EQ(200U, Result.TotalInstructions);
+  // The multiply is two micro opcodes on Jaguar.
+  EXPECT_EQ(300U, Result.TotalUOps);
+  // The chain of multiplies has a latency of 3 cycles per iteration.
+  EXPECT_EQ(304U, Result.TotalCycles);
+  EXPECT_NEAR(3.04, Result.getCyclesPerIteration(), 1e-9);
+
+  // JALU0, JALU1, JDiv, JFPA, JFPM, JFPU0, JFPU1, JLAGU, JMul, JSAGU, JSTC,
+  // JVALU0, JVALU1 and JVIMUL.
+  ASSERT_EQ(14U, Result.ResourcePressure.size());
+  double ALUPressure = Result.ResourcePressure[getResourceIndex("JALU0")] +
+                       Result.ResourcePressure[getResourceIndex("JALU1")];
+  EXPECT_NEAR(2.0, ALUPressure, 1e-9);
+  EXPECT_NEAR(1.0, Result.ResourcePressure[getResourceIndex("JMul")], 1e-9);
+  EXPECT_EQ(0.0, Result.ResourcePressure[getResourceIndex("JDiv")]);
+  EXPECT_EQ(0.0, Result.ResourcePressure[getResourceIndex("JLAGU")]);
+
+  // Instruction descriptors are cached, running again gives the same result.
+  mca::SimulationResult Again = Sim.run(Insts, 100);
+  EXPECT_EQ(Result.TotalCycles, Again.TotalCycles);
+  EXPECT_EQ(Result.ResourcePressure, Again.ResourcePressure);
+}
+
+TEST_F(SimulatorTest, IndependentInstructions) {
+  // Two independent adds per iteration only take one cycle on the two ALUs.
+  MCInst Insts[] = {
+      MCInstBuilder(X86::ADD32rr).addReg(X86::EAX).addReg(X86::EAX).addReg(
+          X86::EDX),
+      MCInstBuilder(X86::ADD32rr).addReg(X86::ECX).addReg(X86::ECX).addReg(
+          X86::EDX)};
+  mca::PipelineOptions Opts(0, 0, 0, 0, false);
+  mca::Simulator Sim(*STI, *MCII, *MRI, *MCIA, *MCIP, Opts);
+
+  mca::SimulationResult Result = Sim.run(Insts, 0);
+  EXPECT_EQ(100U, Result.Iterations);
+  EXPECT_EQ(200U, Result.TotalUOps);
+  EXPECT_EQ(103U, Result.TotalCycles);
+  EXPECT_NEAR(1.0, Result.ResourcePressure[getResourceIndex("JALU0")], 1e-9);
+  EXPECT_NEAR(1.0, Result.ResourcePressure[getResourceIndex("JALU1")], 1e-9);
+}
+
+} // end anonymous namespace
@@ -11,6 +11,7 @@
 namespace exegesis {
 namespace {
 
+using testing::ElementsAre;
 using testing::Pair;
 using testing::UnorderedElementsAre;
 
@@ -98,5 +99,40 @@ TEST_F(AnalysisTest, ComputeIdealizedProcResPressure_1P1_1P05_2P0156) {
                                    Pair(P5Idx, 1.0), Pair(P6Idx, 1.0)));
 }
 
+std::vector<std::pair<uint16_t, uint16_t>>
+toPairs(llvm::ArrayRef<llvm::MCWriteProcResEntry> WPRS) {
+  std::vector<std::pair<uint16_t, uint16_t>> Result;
+  for (const llvm::MCWriteProcResEntry &WPR : WPRS)
+    Result.emplace_back(WPR.ProcResourceIdx, WPR.Cycles);
+  return Result;
+}
+
+TEST_F(AnalysisTest, InferWriteProcRes_1P0) {
+  const auto WPRS = inferWriteProcRes(STI->getSchedModel(),
+                                      {{P0Idx, 1.02f}, {P1Idx, 0.01f}});
+  EXPECT_THAT(toPairs(WPRS), ElementsAre(Pair(P0Idx, 1)));
+}
+
+TEST_F(AnalysisTest, InferWriteProcRes_1P05) {
+  const auto WPRS =
+      inferWriteProcRes(STI->getSchedModel(), {{P5Idx, 0.49f}, {P0Idx, 0.51f}});
+  EXPECT_THAT(toPairs(WPRS), ElementsAre(Pair(P05Idx, 1)));
+}
+
+TEST_F(AnalysisTest, InferWriteProcRes_2P0156) {
+  const auto WPRS = inferWriteProcRes(
+      STI->getSchedModel(),
+      {{P0Idx, 0.5f}, {P1Idx, 0.5f}, {P5Idx, 0.5f}, {P6Idx, 0.5f}});
+  EXPECT_THAT(toPairs(WPRS), ElementsAre(Pair(P0156Idx, 2)));
+}
+
+TEST_F(AnalysisTest, InferWriteProcRes_NoMatchingGroup) {
+  // There is no P016 group on Haswell.
+  const auto WPRS = inferWriteProcRes(
+      STI->getSchedModel(), {{P0Idx, 0.4f}, {P1Idx, 0.3f}, {P6Idx, 1.6f}});
+  EXPECT_THAT(toPairs(WPRS), ElementsAre(Pair(P0Idx, 1), Pair(P1Idx, 1),
+                                         Pair(P6Idx, 2)));
+}
+
 } // namespace
 } // namespace exegesis